@@ -56,7 +56,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DYNARRAY_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
@@ -105,6 +108,71 @@ namespace vla
 		template<typename Skip, typename ... Args> CPP20_DYNARRAY_CONSTEXPR
 		std::size_t expand_parameters(std::size_t count, const Skip &skip, Args&& ... args) { return count * expand_parameters(std::forward<Args>(args)...); }
 
+		inline std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept
+		{
+			return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+		}
+
+		/*!
+		 * @brief 64-bit hash of a byte block.
+		 *
+		 * Four independent multiply-rotate lanes consume 32 bytes per iteration, so the main loop is not serialised on a single accumulator.
+		 *
+		 * @param data First byte of the block
+		 * @param length Length of the block in bytes
+		 * @param seed Initial value
+		 * @return Hash value
+		 */
+		inline std::uint64_t hash_bytes(const void *data, std::size_t length, std::uint64_t seed) noexcept
+		{
+			constexpr std::uint64_t prime_1 = 0x9e3779b185ebca87ull;
+			constexpr std::uint64_t prime_2 = 0xc2b2ae3d27d4eb4full;
+			constexpr std::uint64_t prime_3 = 0x165667b19e3779f9ull;
+			constexpr std::uint64_t prime_4 = 0x85ebca77c2b2ae63ull;
+			constexpr std::uint64_t prime_5 = 0x27d4eb2f165667c5ull;
+
+			auto rotate_left = [](std::uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+			auto mix = [&](std::uint64_t accumulator, std::uint64_t input) { return rotate_left(accumulator + input * prime_2, 31) * prime_1; };
+			auto read_64 = [](const unsigned char *ptr) { std::uint64_t value; std::memcpy(&value, ptr, sizeof value); return value; };
+
+			const unsigned char *current = static_cast<const unsigned char *>(data);
+			const unsigned char *end = current + length;
+			std::uint64_t hash_value;
+
+			if (length >= 32)
+			{
+				std::uint64_t lane_1 = seed + prime_1 + prime_2;
+				std::uint64_t lane_2 = seed + prime_2;
+				std::uint64_t lane_3 = seed;
+				std::uint64_t lane_4 = seed - prime_1;
+				for (; end - current >= 32; current += 32)
+				{
+					lane_1 = mix(lane_1, read_64(current));
+					lane_2 = mix(lane_2, read_64(current + 8));
+					lane_3 = mix(lane_3, read_64(current + 16));
+					lane_4 = mix(lane_4, read_64(current + 24));
+				}
+				hash_value = rotate_left(lane_1, 1) + rotate_left(lane_2, 7) + rotate_left(lane_3, 12) + rotate_left(lane_4, 18);
+				for (std::uint64_t lane : { lane_1, lane_2, lane_3, lane_4 })
+					hash_value = (hash_value ^ mix(0, lane)) * prime_1 + prime_4;
+			}
+			else
+				hash_value = seed + prime_5;
+
+			hash_value += length;
+			for (; end - current >= 8; current += 8)
+				hash_value = rotate_left(hash_value ^ mix(0, read_64(current)), 27) * prime_1 + prime_4;
+			for (; current != end; ++current)
+				hash_value = rotate_left(hash_value ^ (*current * prime_5), 11) * prime_1;
+
+			hash_value ^= hash_value >> 33;
+			hash_value *= prime_2;
+			hash_value ^= hash_value >> 29;
+			hash_value *= prime_3;
+			hash_value ^= hash_value >> 32;
+			return hash_value;
+		}
+
 	}	// internal namespace
 
 	template<typename T>
@@ -828,6 +896,12 @@ namespace vla
 
 		CPP20_DYNARRAY_CONSTEXPR void swap_outside(dynarray &other) noexcept;
 
+		CPP20_DYNARRAY_CONSTEXPR std::size_t hash_shape(std::size_t seed) const noexcept;
+
+		std::size_t hash_code() const;
+
+		friend struct std::hash<dynarray>;
+
 
 		/**** Non-member functions  ***/
 
@@ -1752,7 +1826,46 @@ namespace vla
 			*current_address = value;
 	}
 
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR std::size_t
+	dynarray<T, _Allocator>::hash_shape(std::size_t seed) const noexcept
+	{
+		seed = internal_impl::hash_combine(seed, current_dimension_array_size);
+		if constexpr (!std::is_same_v<T, internal_value_type>)
+		{
+			for (size_type i = 0; i < current_dimension_array_size; ++i)
+				seed = (current_dimension_array_data + i)->hash_shape(seed);
+		}
+		return seed;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::size_t
+	dynarray<T, _Allocator>::hash_code() const
+	{
+		std::size_t seed = hash_shape(0);
+		size_type count = this_level_array_head == nullptr ? 0 : static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		if constexpr (std::has_unique_object_representations_v<internal_value_type>)
+			return internal_impl::hash_combine(seed, static_cast<std::size_t>(internal_impl::hash_bytes(this_level_array_head, count * sizeof(internal_value_type), seed)));
+		else
+		{
+			std::hash<internal_value_type> element_hash;
+			for (size_type i = 0; i < count; ++i)
+				seed = internal_impl::hash_combine(seed, element_hash(this_level_array_head[i]));
+			return seed;
+		}
+	}
+
 }	// namespace vla
 
+namespace std
+{
+	template<typename T, template<typename U> typename _Allocator>
+	struct hash<vla::dynarray<T, _Allocator>>
+	{
+		std::size_t operator()(const vla::dynarray<T, _Allocator> &arr) const { return arr.hash_code(); }
+	};
+}	// namespace std
+
 
 #endif //_VLA_HEADER_DYNARRAY_HPP_
\ No newline at end of file
@@ -0,0 +1,657 @@
+/** @copyright
+BSD 3-Clause License
+
+Copyright (c) 2020, cnbatch
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*!***************************************************************//*!
+ * @file   dynarray_bits.hpp
+ * @brief  Rectangular arrays of flags packed into 64-bit words
+ *
+ * @author cnbatch
+ * @date   October 2026
+ *********************************************************************/
+
+#pragma once
+#ifndef DYNARRAY_NEAT_BITS_HPP
+#define DYNARRAY_NEAT_BITS_HPP
+
+#include "dynarray.hpp"
+
+#ifdef DYNARRAY_USING_CPP20
+#include <bit>
+#endif
+
+namespace vla
+{
+	namespace internal_impl
+	{
+		using bit_word = std::uint64_t;
+
+		inline constexpr std::size_t bit_word_size = 64;
+
+		inline int popcount_word(bit_word word) noexcept
+		{
+#ifdef DYNARRAY_USING_CPP20
+			return std::popcount(word);
+#elif defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcountll(word);
+#else
+			word = word - ((word >> 1) & 0x5555555555555555u);
+			word = (word & 0x3333333333333333u) + ((word >> 2) & 0x3333333333333333u);
+			word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fu;
+			return static_cast<int>((word * 0x0101010101010101u) >> 56);
+#endif
+		}
+
+		// word must not be 0
+		inline int countr_zero_word(bit_word word) noexcept
+		{
+#ifdef DYNARRAY_USING_CPP20
+			return std::countr_zero(word);
+#elif defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(word);
+#else
+			return popcount_word((word & (0 - word)) - 1);
+#endif
+		}
+
+		inline std::size_t bit_words_for(std::size_t bits) noexcept
+		{
+			return bits / bit_word_size + (bits % bit_word_size != 0 ? 1 : 0);
+		}
+
+		/*!
+		 * @brief Counts the set bits of [first, first + length), whole words in the middle are counted without masking.
+		 */
+		inline std::size_t count_bits(const bit_word *words, std::size_t first, std::size_t length) noexcept
+		{
+			if (length == 0)
+				return 0;
+
+			std::size_t last = first + length - 1;
+			std::size_t head = first / bit_word_size;
+			std::size_t tail = last / bit_word_size;
+			bit_word head_mask = ~bit_word(0) << (first % bit_word_size);
+			bit_word tail_mask = ~bit_word(0) >> (bit_word_size - 1 - last % bit_word_size);
+			if (head == tail)
+				return popcount_word(words[head] & head_mask & tail_mask);
+
+			std::size_t total = popcount_word(words[head] & head_mask) + popcount_word(words[tail] & tail_mask);
+			for (std::size_t i = head + 1; i < tail; ++i)
+				total += popcount_word(words[i]);
+			return total;
+		}
+
+		/*!
+		 * @brief Finds the first bit equal to Value in [first, first + length).
+		 *
+		 * @return Distance from first, length if there is none
+		 */
+		template<bool Value>
+		std::size_t find_bit(const bit_word *words, std::size_t first, std::size_t length) noexcept
+		{
+			if (length == 0)
+				return 0;
+
+			std::size_t last = first + length - 1;
+			std::size_t head = first / bit_word_size;
+			std::size_t tail = last / bit_word_size;
+			for (std::size_t i = head; i <= tail; ++i)
+			{
+				bit_word word = Value ? words[i] : ~words[i];
+				if (i == head)
+					word &= ~bit_word(0) << (first % bit_word_size);
+				if (i == tail)
+					word &= ~bit_word(0) >> (bit_word_size - 1 - last % bit_word_size);
+				if (word != 0)
+					return i * bit_word_size + countr_zero_word(word) - first;
+			}
+			return length;
+		}
+
+		/*!
+		 * @brief Calls function(position) for each bit equal to Value in the first length bits, skipping whole words that have none.
+		 */
+		template<bool Value, typename Function>
+		void for_each_bit(const bit_word *words, std::size_t length, Function &&function)
+		{
+			std::size_t word_count = bit_words_for(length);
+			for (std::size_t i = 0; i < word_count; ++i)
+			{
+				bit_word word = Value ? words[i] : ~words[i];
+				if (i + 1 == word_count && length % bit_word_size != 0)
+					word &= (bit_word(1) << (length % bit_word_size)) - 1;
+				for (; word != 0; word &= word - 1)
+					function(i * bit_word_size + countr_zero_word(word));
+			}
+		}
+
+		/*!
+		 * @brief Arrays that a bit_dynarray<N> can be the mask of: dynarrays of N dimensions with the same allocator.
+		 */
+		template<typename Array, std::size_t N, template<typename U> typename _Allocator>
+		struct bit_mask_target : std::false_type {};
+
+		template<typename T, std::size_t N, template<typename U> typename _Allocator>
+		struct bit_mask_target<dynarray<T, N, _Allocator>, N, _Allocator> : std::true_type
+		{
+			using flat_type = dynarray<T, 1, _Allocator>;
+		};
+	}
+
+	/*!
+	 * @brief Proxy of one bit of a bit_dynarray, converts to bool and can be assigned a bool.
+	 */
+	class bit_reference
+	{
+	public:
+		using word_type = internal_impl::bit_word;
+
+		bit_reference(word_type *word, word_type mask) noexcept : word(word), mask(mask) {}
+		bit_reference(const bit_reference &other) noexcept = default;
+
+		operator bool() const noexcept { return (*word & mask) != 0; }
+		bool operator~() const noexcept { return (*word & mask) == 0; }
+
+		bit_reference& operator=(bool value) noexcept
+		{
+			if (value)
+				*word |= mask;
+			else
+				*word &= ~mask;
+			return *this;
+		}
+
+		bit_reference& operator=(const bit_reference &other) noexcept { return *this = static_cast<bool>(other); }
+
+		bit_reference& flip() noexcept
+		{
+			*word ^= mask;
+			return *this;
+		}
+
+		friend void swap(bit_reference lhs, bit_reference rhs) noexcept
+		{
+			bool value = lhs;
+			lhs = static_cast<bool>(rhs);
+			rhs = value;
+		}
+
+	private:
+		word_type *word;
+		word_type mask;
+	};
+
+	/*!
+	 * @brief Rectangular array of flags packed 64 per word, a compact replacement for dynarray<bool, N>.
+	 *
+	 * The bits are in row-major order without padding between rows, bits past the last element of the last word are always 0.
+	 * operator[] returns a proxy of the sub-array for N > 1, and bit_reference (bool for const arrays) at the last dimension.
+	 * Counting, searching and the bitwise operators work a whole word at a time.
+	 * Convert with to_dynarray() or the constructor when bool * access is needed; select() and where() take it as mask directly.
+	 */
+	template<std::size_t N, template<typename U> typename _Allocator>
+	class bit_dynarray
+	{
+		static_assert(N > 0, "bit_dynarray needs at least one dimension");
+
+		template<std::size_t Rank, bool Const>
+		class subarray;
+	public:
+
+		// Member types
+
+		using value_type = bool;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using word_type = internal_impl::bit_word;
+		using reference = bit_reference;
+		using const_reference = bool;
+		using allocator_type = _Allocator<word_type>;
+		using dynarray_type = dynarray<bool, N, _Allocator>;
+
+		static constexpr size_type word_bits = internal_impl::bit_word_size;
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+		// Constructors
+
+		bit_dynarray() noexcept = default;
+
+		/*!
+		 * @brief Construct by the extent of each dimension.\n
+		 * Example: vla::bit_dynarray<2> occupancy({ rows, cols });
+		 *
+		 * @param extents Extent of each dimension
+		 * @param value Initial value of every flag
+		 */
+		explicit bit_dynarray(const size_type (&extents)[N], bool value = false)
+		{
+			allocate_bits(extents);
+			fill(value);
+		}
+
+		template<std::size_t M = N, typename = std::enable_if_t<M == 1>>
+		explicit bit_dynarray(size_type count, bool value = false)
+		{
+			const size_type extents[1] = { count };
+			allocate_bits(extents);
+			fill(value);
+		}
+
+		/*!
+		 * @brief Packs the flags of a rectangular dynarray<bool, N>.
+		 *
+		 * @exception std::invalid_argument if flags is not rectangular
+		 */
+		explicit bit_dynarray(const dynarray_type &flags);
+
+		bit_dynarray(const bit_dynarray &other);
+
+		bit_dynarray(bit_dynarray &&other) noexcept { swap(other); }
+
+		~bit_dynarray() { release_bits(); }
+
+		bit_dynarray& operator=(const bit_dynarray &other)
+		{
+			if (this != &other)
+			{
+				bit_dynarray duplicate(other);
+				swap(duplicate);
+			}
+			return *this;
+		}
+
+		bit_dynarray& operator=(bit_dynarray &&other) noexcept
+		{
+			bit_dynarray moved(std::move(other));
+			swap(moved);
+			return *this;
+		}
+
+		// Element access
+
+		auto operator[](size_type n) noexcept { return subarray<N, false>(word_block, 0, shape, strides)[n]; }
+		auto operator[](size_type n) const noexcept { return subarray<N, true>(word_block, 0, shape, strides)[n]; }
+
+		/*!
+		 * @brief Flag at a row-major position, regardless of the dimensions
+		 */
+		bool test(size_type position) const noexcept { return (word_block[position / word_bits] >> (position % word_bits)) & 1; }
+
+		void set(size_type position, bool value = true) noexcept { bit_reference(word_block + position / word_bits, word_type(1) << (position % word_bits)) = value; }
+		void reset(size_type position) noexcept { set(position, false); }
+		void flip(size_type position) noexcept { word_block[position / word_bits] ^= word_type(1) << (position % word_bits); }
+
+		/*!
+		 * @brief The packed words, bit i of the array is bit (i % word_bits) of word (i / word_bits)
+		 */
+		word_type* data() noexcept { return word_block; }
+		const word_type* data() const noexcept { return word_block; }
+
+		size_type word_count() const noexcept { return internal_impl::bit_words_for(bit_total); }
+
+		// Capacity
+
+		CPP20_DYNARRAY_NODISCARD bool empty() const noexcept { return bit_total == 0; }
+
+		/*!
+		 * @brief Extent of the outermost dimension
+		 */
+		size_type size() const noexcept { return shape[0]; }
+
+		/*!
+		 * @brief Number of flags of the whole array
+		 */
+		size_type element_count() const noexcept { return bit_total; }
+
+		const size_type* extents() const noexcept { return shape; }
+
+		// Operations
+
+		/*!
+		 * @brief Number of flags that are set, counted a word at a time
+		 */
+		size_type count() const noexcept { return internal_impl::count_bits(word_block, 0, bit_total); }
+
+		bool any() const noexcept { return internal_impl::find_bit<true>(word_block, 0, bit_total) != bit_total; }
+		bool all() const noexcept { return internal_impl::find_bit<false>(word_block, 0, bit_total) == bit_total; }
+		bool none() const noexcept { return !any(); }
+
+		/*!
+		 * @brief Row-major position of the first flag that is set, npos if there is none
+		 */
+		size_type find_first() const noexcept { return find_next(npos); }
+
+		/*!
+		 * @brief Row-major position of the first flag set after position, npos if there is none
+		 */
+		size_type find_next(size_type position) const noexcept
+		{
+			size_type first = position + 1;
+			if (first >= bit_total)
+				return npos;
+			size_type offset = internal_impl::find_bit<true>(word_block, first, bit_total - first);
+			return offset == bit_total - first ? npos : first + offset;
+		}
+
+		void fill(bool value) noexcept;
+
+		void set() noexcept { fill(true); }
+		void reset() noexcept { fill(false); }
+
+		void flip() noexcept
+		{
+			size_type words = word_count();
+			for (size_type i = 0; i < words; ++i)
+				word_block[i] = ~word_block[i];
+			clear_tail();
+		}
+
+		/*!
+		 * @brief Unpacks the flags into a dynarray<bool, N> of the same shape.
+		 */
+		dynarray_type to_dynarray() const;
+
+		/*!
+		 * @brief Bitwise operations with an array of the same shape, a whole word at a time.
+		 *
+		 * @exception std::invalid_argument if the shapes of the arrays are different
+		 */
+		bit_dynarray& operator&=(const bit_dynarray &other) { return combine(other, [](word_type lhs, word_type rhs) { return lhs & rhs; }); }
+		bit_dynarray& operator|=(const bit_dynarray &other) { return combine(other, [](word_type lhs, word_type rhs) { return lhs | rhs; }); }
+		bit_dynarray& operator^=(const bit_dynarray &other) { return combine(other, [](word_type lhs, word_type rhs) { return lhs ^ rhs; }); }
+
+		friend bit_dynarray operator&(bit_dynarray lhs, const bit_dynarray &rhs) { return lhs &= rhs; }
+		friend bit_dynarray operator|(bit_dynarray lhs, const bit_dynarray &rhs) { return lhs |= rhs; }
+		friend bit_dynarray operator^(bit_dynarray lhs, const bit_dynarray &rhs) { return lhs ^= rhs; }
+
+		friend bit_dynarray operator~(bit_dynarray value)
+		{
+			value.flip();
+			return value;
+		}
+
+		friend bool operator==(const bit_dynarray &lhs, const bit_dynarray &rhs) noexcept
+		{
+			return std::equal(lhs.shape, lhs.shape + N, rhs.shape) &&
+				std::equal(lhs.word_block, lhs.word_block + lhs.word_count(), rhs.word_block);
+		}
+
+		friend bool operator!=(const bit_dynarray &lhs, const bit_dynarray &rhs) noexcept { return !(lhs == rhs); }
+
+		void swap(bit_dynarray &other) noexcept
+		{
+			std::swap(word_block, other.word_block);
+			std::swap(shape, other.shape);
+			std::swap(strides, other.strides);
+			std::swap(bit_total, other.bit_total);
+			std::swap(word_allocator, other.word_allocator);
+		}
+
+		friend void swap(bit_dynarray &lhs, bit_dynarray &rhs) noexcept { lhs.swap(rhs); }
+
+		/*!
+		 * @brief Collects the elements of src whose flags in mask are set, in row-major order.
+		 *
+		 * @exception std::invalid_argument if the shapes of src and mask are different
+		*/
+		template<typename Array, typename Target = internal_impl::bit_mask_target<Array, N, _Allocator>, typename = std::enable_if_t<Target::value>>
+		friend typename Target::flat_type select(const Array &src, const bit_dynarray &mask)
+		{
+			return mask.template select_elements<typename Target::flat_type>(src);
+		}
+
+		/*!
+		 * @brief Chooses elements from lhs where the flag of mask is set, from rhs otherwise.
+		 *
+		 * @exception std::invalid_argument if the shapes of the arrays are different
+		*/
+		template<typename Array, typename = std::enable_if_t<internal_impl::bit_mask_target<Array, N, _Allocator>::value>>
+		friend Array where(const bit_dynarray &mask, const Array &lhs, const Array &rhs)
+		{
+			Array result(lhs);
+			mask.blend_elements(result, rhs);
+			return result;
+		}
+
+	private:
+		void allocate_bits(const size_type *extents);
+
+		void release_bits() noexcept;
+
+		void clear_tail() noexcept
+		{
+			if (bit_total % word_bits != 0)
+				word_block[bit_total / word_bits] &= (word_type(1) << (bit_total % word_bits)) - 1;
+		}
+
+		template<typename WordOperation>
+		bit_dynarray& combine(const bit_dynarray &other, WordOperation operation);
+
+		template<typename Array>
+		void verify_shape(const Array &other) const;
+
+		template<typename Result, typename Array>
+		Result select_elements(const Array &src) const;
+
+		template<typename Array>
+		void blend_elements(Array &result, const Array &other) const;
+
+		word_type *word_block = nullptr;
+		size_type shape[N] = {};
+		size_type strides[N] = {};	// number of bits of one sub-array of each dimension
+		size_type bit_total = 0;
+		allocator_type word_allocator;
+	};
+
+	/*!
+	 * @brief Proxy of the bits of a sub-array with Rank dimensions, they are contiguous in row-major order.
+	 */
+	template<std::size_t N, template<typename U> typename _Allocator>
+	template<std::size_t Rank, bool Const>
+	class bit_dynarray<N, _Allocator>::subarray
+	{
+		using word_pointer = std::conditional_t<Const, const word_type *, word_type *>;
+	public:
+		subarray(word_pointer words, size_type first, const size_type *extents, const size_type *strides) noexcept
+			: words(words), first(first), extents(extents), strides(strides) {}
+
+		auto operator[](size_type n) const noexcept
+		{
+			size_type position = first + n * strides[0];
+			if constexpr (Rank == 1 && Const)
+				return static_cast<bool>((words[position / word_bits] >> (position % word_bits)) & 1);
+			else if constexpr (Rank == 1)
+				return bit_reference(words + position / word_bits, word_type(1) << (position % word_bits));
+			else
+				return subarray<Rank - 1, Const>(words, position, extents + 1, strides + 1);
+		}
+
+		size_type size() const noexcept { return extents[0]; }
+
+		size_type count() const noexcept { return internal_impl::count_bits(words, first, length()); }
+		bool any() const noexcept { return internal_impl::find_bit<true>(words, first, length()) != length(); }
+		bool all() const noexcept { return internal_impl::find_bit<false>(words, first, length()) == length(); }
+		bool none() const noexcept { return !any(); }
+
+		/*!
+		 * @brief Row-major position of the first flag that is set inside the sub-array, npos if there is none
+		 */
+		size_type find_first() const noexcept
+		{
+			size_type offset = internal_impl::find_bit<true>(words, first, length());
+			return offset == length() ? npos : offset;
+		}
+
+	private:
+		size_type length() const noexcept { return extents[0] * strides[0]; }
+
+		word_pointer words;
+		size_type first;
+		const size_type *extents;
+		const size_type *strides;
+	};
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	inline bit_dynarray<N, _Allocator>::bit_dynarray(const dynarray_type &flags)
+	{
+		size_type extents[N] = {};
+		if (!flags.get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
+
+		allocate_bits(extents);
+		const bool *source = flags.data();
+		size_type words = word_count();
+		for (size_type i = 0; i < words; ++i)
+		{
+			size_type base = i * word_bits;
+			size_type bits = std::min(word_bits, bit_total - base);
+			word_type word = 0;
+			for (size_type b = 0; b < bits; ++b)
+				word |= static_cast<word_type>(source[base + b]) << b;
+			word_block[i] = word;
+		}
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	inline bit_dynarray<N, _Allocator>::bit_dynarray(const bit_dynarray &other)
+		: word_allocator(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.word_allocator))
+	{
+		allocate_bits(other.shape);
+		internal_impl::copy_construct_block(word_allocator, word_block, other.word_block, word_count());
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	inline void
+	bit_dynarray<N, _Allocator>::allocate_bits(const size_type *extents)
+	{
+		const size_type limit = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+		size_type total = 1;
+		for (size_type k = N; k > 0; --k)
+		{
+			strides[k - 1] = total;
+			if (extents[k - 1] != 0 && total > limit / extents[k - 1])
+				throw std::length_error("array too long");
+			total *= extents[k - 1];
+		}
+
+		size_type words = internal_impl::bit_words_for(total);
+		if (words > std::allocator_traits<allocator_type>::max_size(word_allocator))
+			throw std::length_error("array too long");
+		if (words > 0)
+			word_block = word_allocator.allocate(words);
+		std::copy(extents, extents + N, shape);
+		bit_total = total;
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	inline void
+	bit_dynarray<N, _Allocator>::release_bits() noexcept
+	{
+		if (word_block != nullptr)
+			word_allocator.deallocate(word_block, word_count());
+		word_block = nullptr;
+		bit_total = 0;
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	inline void
+	bit_dynarray<N, _Allocator>::fill(bool value) noexcept
+	{
+		std::fill(word_block, word_block + word_count(), value ? ~word_type(0) : word_type(0));
+		clear_tail();
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	inline typename bit_dynarray<N, _Allocator>::dynarray_type
+	bit_dynarray<N, _Allocator>::to_dynarray() const
+	{
+		auto unpack = [this](size_type position) { return test(position); };
+		if constexpr (N == 1)
+			return dynarray_type(from_generator, bit_total, unpack);
+		else
+			return dynarray_type(from_generator, shape, unpack);
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	template<typename WordOperation>
+	inline bit_dynarray<N, _Allocator>&
+	bit_dynarray<N, _Allocator>::combine(const bit_dynarray &other, WordOperation operation)
+	{
+		if (!std::equal(shape, shape + N, other.shape))
+			throw std::invalid_argument("shapes of the arrays do not match");
+
+		size_type words = word_count();
+		for (size_type i = 0; i < words; ++i)
+			word_block[i] = operation(word_block[i], other.word_block[i]);
+		return *this;
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	template<typename Array>
+	inline void
+	bit_dynarray<N, _Allocator>::verify_shape(const Array &other) const
+	{
+		size_type extents[N] = {};
+		bool rectangular = other.get_extents(extents);
+		// arrays without elements may record their extents only up to the first 0
+		bool no_elements = bit_total == 0 && std::find(extents, extents + N, 0) != extents + N;
+		if (!rectangular || !(std::equal(extents, extents + N, shape) || no_elements))
+			throw std::invalid_argument("shapes of dynarray and mask do not match");
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	template<typename Result, typename Array>
+	inline Result
+	bit_dynarray<N, _Allocator>::select_elements(const Array &src) const
+	{
+		verify_shape(src);
+		Result result(count());
+		auto source = src.data();
+		auto destination = result.data();
+		internal_impl::for_each_bit<true>(word_block, bit_total, [&](size_type position) { *destination++ = source[position]; });
+		return result;
+	}
+
+	template<std::size_t N, template<typename U> typename _Allocator>
+	template<typename Array>
+	inline void
+	bit_dynarray<N, _Allocator>::blend_elements(Array &result, const Array &other) const
+	{
+		verify_shape(result);
+		verify_shape(other);
+		auto destination = result.data();
+		auto source = other.data();
+		internal_impl::for_each_bit<false>(word_block, bit_total, [&](size_type position) { destination[position] = source[position]; });
+	}
+}	// namespace vla
+
+
+#endif //DYNARRAY_NEAT_BITS_HPP
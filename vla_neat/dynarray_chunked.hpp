@@ -0,0 +1,545 @@
+/** @copyright
+BSD 3-Clause License
+
+Copyright (c) 2020, cnbatch
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*!***************************************************************//*!
+ * @file   dynarray_chunked.hpp
+ * @brief  Out-of-core array stored as fixed-shape chunks of a file, POSIX only
+ *
+ * @author cnbatch
+ * @date   October 2026
+ *********************************************************************/
+
+#pragma once
+#ifndef DYNARRAY_NEAT_CHUNKED_HPP
+#define DYNARRAY_NEAT_CHUNKED_HPP
+
+#include "dynarray.hpp"
+
+#include <cerrno>
+#include <future>
+#include <list>
+#include <memory>
+#include <system_error>
+#include <unordered_map>
+
+#if !__has_include(<unistd.h>)
+#error "dynarray_chunked.hpp requires POSIX pread and pwrite"
+#endif
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vla
+{
+	/*!
+	 * @brief How chunked_dynarray opens its backing file.
+	 */
+	enum class chunk_file_mode
+	{
+		create,	// the file is created or truncated, all elements start as zero bytes
+		open,	// the file must exist with the expected size, changes are written back
+		read_only	// the file must exist with the expected size, changes are discarded when a chunk is evicted
+	};
+
+	namespace internal_impl
+	{
+		/*!
+		 * @brief Reads exactly length bytes at offset, the part beyond the end of file is filled with zero bytes.
+		 */
+		inline void read_file_range(int descriptor, void *destination, std::size_t length, std::uint64_t offset)
+		{
+			char *cursor = static_cast<char *>(destination);
+			while (length > 0)
+			{
+				ssize_t count = ::pread(descriptor, cursor, length, static_cast<off_t>(offset));
+				if (count == -1 && errno == EINTR)
+					continue;
+				if (count == -1)
+					throw std::system_error(errno, std::generic_category(), "cannot read chunk");
+				if (count == 0)
+				{
+					std::memset(cursor, 0, length);
+					return;
+				}
+				cursor += count;
+				length -= static_cast<std::size_t>(count);
+				offset += static_cast<std::uint64_t>(count);
+			}
+		}
+
+		inline void write_file_range(int descriptor, const void *source, std::size_t length, std::uint64_t offset)
+		{
+			const char *cursor = static_cast<const char *>(source);
+			while (length > 0)
+			{
+				ssize_t count = ::pwrite(descriptor, cursor, length, static_cast<off_t>(offset));
+				if (count == -1 && errno == EINTR)
+					continue;
+				if (count == -1)
+					throw std::system_error(errno, std::generic_category(), "cannot write chunk");
+				cursor += count;
+				length -= static_cast<std::size_t>(count);
+				offset += static_cast<std::uint64_t>(count);
+			}
+		}
+	}	// internal namespace
+
+	/*!
+	 * @brief N-dimensional array which does not have to fit in memory, with the same operator[], size() and iterators as dynarray<T, N>.
+	 *
+	 * The array is split into chunks of a fixed shape, each chunk is stored as a contiguous block of a backing file.
+	 * At most cache_chunks chunks are resident, the least recently used one is evicted (and written back if changed) to make room.
+	 * When chunks are requested in ascending order, the next one is read ahead asynchronously.
+	 *
+	 * Proxies are returned for the rows of all dimensions but the last one; use `auto` or `auto &&` instead of `auto &` to hold them.
+	 * A reference to an element stays valid until its chunk is evicted, i.e. until cache_chunks other chunks are accessed.
+	 * At least two chunks are kept resident, so the two most recently returned references are always valid together,
+	 * as std::swap, std::iter_swap and the algorithms built on them (std::sort, std::reverse, etc.) require.
+	 * Not thread-safe, elements must be trivially copyable.
+	 */
+	template<typename T, std::size_t N>
+	class chunked_dynarray
+	{
+		static_assert(N > 0, "chunked_dynarray needs at least one dimension");
+		static_assert(std::is_trivially_copyable_v<T>, "chunked_dynarray requires trivially copyable elements");
+
+		template<std::size_t M, bool Const>
+		class row_proxy;
+
+		template<std::size_t M, bool Const>
+		class proxy_iterator;
+	public:
+
+		// Member types
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<N == 1, value_type &, row_proxy<N - 1, false>>;
+		using const_reference = std::conditional_t<N == 1, const value_type &, row_proxy<N - 1, true>>;
+		using iterator = proxy_iterator<N, false>;
+		using const_iterator = proxy_iterator<N, true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		// Constructors
+
+		/*!
+		 * @brief Opens or creates the backing file.
+		 *
+		 * @param path Backing file
+		 * @param mode chunk_file_mode::create, chunk_file_mode::open or chunk_file_mode::read_only
+		 * @param extents Extent of each dimension
+		 * @param chunk_extents Shape of a chunk, chunks on the edges are padded to this shape in the file
+		 * @param cache_chunks Maximum number of resident chunks, values below 2 are raised to 2
+		 * @exception std::system_error if the file cannot be opened, created or resized
+		 * @exception std::invalid_argument if an extent is 0, or the size of an existing file does not match
+		 */
+		chunked_dynarray(const char *path, chunk_file_mode mode, const size_type (&extents)[N], const size_type (&chunk_extents)[N], size_type cache_chunks);
+
+		chunked_dynarray(const chunked_dynarray &other) = delete;
+
+		chunked_dynarray& operator=(const chunked_dynarray &other) = delete;
+
+		/*!
+		 * @brief Writes back changed chunks and closes the backing file, errors are ignored; call flush() first to see them.
+		 */
+		~chunked_dynarray();
+
+		// Element access
+
+		/*!
+		 * @brief Access specified element, or the row of an element
+		 *
+		 * @param n Position of the row, or of the element if N is 1
+		 * @return Reference to the element, or a proxy of the row
+		 */
+		reference operator[](size_type n) { return row_proxy<N, false>{ this, {} }[n]; }
+		const_reference operator[](size_type n) const { return row_proxy<N, true>{ this, {} }[n]; }
+
+		// Iterators
+
+		iterator begin() noexcept { return row_proxy<N, false>{ this, {} }.begin(); }
+		const_iterator begin() const noexcept { return cbegin(); }
+		const_iterator cbegin() const noexcept { return row_proxy<N, true>{ this, {} }.begin(); }
+
+		iterator end() noexcept { return row_proxy<N, false>{ this, {} }.end(); }
+		const_iterator end() const noexcept { return cend(); }
+		const_iterator cend() const noexcept { return row_proxy<N, true>{ this, {} }.end(); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return crend(); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+		// Capacity
+
+		CPP20_DYNARRAY_NODISCARD bool empty() const noexcept { return false; }
+
+		/*!
+		 * @brief Returns the number of rows, the same as dynarray<T, N>::size()
+		 */
+		size_type size() const noexcept { return array_extents[0]; }
+
+		/*!
+		 * @brief Returns the number of elements of all dimensions
+		 */
+		size_type element_count() const noexcept { return total_elements; }
+
+		/*!
+		 * @brief Returns the maximum number of resident chunks
+		 */
+		size_type cache_capacity() const noexcept { return capacity; }
+
+		// Operations
+
+		/*!
+		 * @brief Writes back all changed chunks, they stay resident.
+		 *
+		 * @exception std::system_error if a chunk cannot be written
+		 */
+		void flush();
+
+	private:
+		// the least recently used chunk is evicted, so the chunks of the last pinned_chunks references returned stay resident
+		static constexpr size_type pinned_chunks = 2;
+
+		struct chunk
+		{
+			size_type id;
+			bool dirty;
+			std::unique_ptr<T[]> data;
+		};
+
+		T* locate(const size_type *index, bool writing) const;
+
+		chunk& fetch(size_type id) const;
+
+		std::unique_ptr<T[]> load_chunk(size_type id, std::unique_ptr<T[]> buffer) const;
+
+		void store_chunk(const chunk &resident) const;
+
+		void read_ahead(size_type id) const;
+
+		int descriptor = -1;
+		bool writable = false;
+		size_type array_extents[N] = {};
+		size_type chunk_shape[N] = {};
+		size_type chunk_grid[N] = {};
+		size_type chunk_elements = 1;
+		size_type chunk_total = 1;
+		size_type total_elements = 1;
+		size_type capacity = pinned_chunks;
+
+		mutable std::list<chunk> resident_chunks;	// most recently used first
+		mutable std::unordered_map<size_type, typename std::list<chunk>::iterator> chunk_lookup;
+		mutable chunk *last_used = nullptr;
+		mutable size_type last_loaded = static_cast<size_type>(-1);
+		mutable size_type prefetch_id = static_cast<size_type>(-1);
+		mutable std::future<std::unique_ptr<T[]>> prefetched;
+	};
+
+	/*!
+	 * @brief Row of a chunked_dynarray with M dimensions left, it holds the positions chosen on the outer dimensions.
+	 */
+	template<typename T, std::size_t N>
+	template<std::size_t M, bool Const>
+	class chunked_dynarray<T, N>::row_proxy
+	{
+		friend class chunked_dynarray;
+		template<std::size_t K, bool C>
+		friend class row_proxy;
+		template<std::size_t K, bool C>
+		friend class proxy_iterator;
+
+		using owner_pointer = std::conditional_t<Const, const chunked_dynarray *, chunked_dynarray *>;
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = std::conditional_t<M == 1, std::conditional_t<Const, const T &, T &>, row_proxy<M - 1, Const>>;
+		using iterator = proxy_iterator<M, Const>;
+
+		row_proxy(owner_pointer owner, const size_type (&outer_index)[N]) : owner(owner)
+		{
+			std::copy(outer_index, outer_index + N, index);
+		}
+
+		reference operator[](size_type n) const
+		{
+			if constexpr (M == 1)
+			{
+				size_type element_index[N];
+				std::copy(index, index + N, element_index);
+				element_index[N - 1] = n;
+				return *owner->locate(element_index, !Const);
+			}
+			else
+			{
+				row_proxy<M - 1, Const> row(owner, index);
+				row.index[N - M] = n;
+				return row;
+			}
+		}
+
+		size_type size() const noexcept { return owner->array_extents[N - M]; }
+
+		CPP20_DYNARRAY_NODISCARD bool empty() const noexcept { return false; }
+
+		iterator begin() const noexcept { return iterator(*this, 0); }
+
+		iterator end() const noexcept { return iterator(*this, size()); }
+
+	private:
+		owner_pointer owner;
+		size_type index[N] = {};
+	};
+
+	/*!
+	 * @brief Iterator over a row_proxy, it is random access when it points to elements.
+	 */
+	template<typename T, std::size_t N>
+	template<std::size_t M, bool Const>
+	class chunked_dynarray<T, N>::proxy_iterator
+	{
+		using row_type = row_proxy<M, Const>;
+	public:
+		using iterator_category = std::conditional_t<M == 1, std::random_access_iterator_tag, std::input_iterator_tag>;
+		using value_type = std::conditional_t<M == 1, T, row_proxy<M - 1, Const>>;
+		using difference_type = std::ptrdiff_t;
+		using reference = typename row_type::reference;
+		using pointer = std::conditional_t<M == 1, std::remove_reference_t<reference> *, void>;
+
+		proxy_iterator(const row_type &row, size_type position) noexcept : row(row), position(position) {}
+
+		reference operator*() const { return row[position]; }
+		reference operator[](difference_type n) const { return row[position + n]; }
+
+		proxy_iterator& operator++() noexcept { ++position; return *this; }
+		proxy_iterator operator++(int) noexcept { proxy_iterator old = *this; ++position; return old; }
+		proxy_iterator& operator--() noexcept { --position; return *this; }
+		proxy_iterator operator--(int) noexcept { proxy_iterator old = *this; --position; return old; }
+		proxy_iterator& operator+=(difference_type n) noexcept { position += n; return *this; }
+		proxy_iterator& operator-=(difference_type n) noexcept { position -= n; return *this; }
+
+		friend proxy_iterator operator+(proxy_iterator it, difference_type n) noexcept { return it += n; }
+		friend proxy_iterator operator+(difference_type n, proxy_iterator it) noexcept { return it += n; }
+		friend proxy_iterator operator-(proxy_iterator it, difference_type n) noexcept { return it -= n; }
+		friend difference_type operator-(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.position) - static_cast<difference_type>(rhs.position);
+		}
+
+		friend bool operator==(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept { return lhs.position == rhs.position; }
+		friend bool operator!=(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept { return lhs.position != rhs.position; }
+		friend bool operator<(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept { return lhs.position < rhs.position; }
+		friend bool operator>(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept { return lhs.position > rhs.position; }
+		friend bool operator<=(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept { return lhs.position <= rhs.position; }
+		friend bool operator>=(const proxy_iterator &lhs, const proxy_iterator &rhs) noexcept { return lhs.position >= rhs.position; }
+
+	private:
+		row_type row;
+		size_type position;
+	};
+
+	template<typename T, std::size_t N>
+	inline chunked_dynarray<T, N>::chunked_dynarray(const char *path, chunk_file_mode mode, const size_type (&extents)[N],
+	                                                const size_type (&chunk_extents)[N], size_type cache_chunks)
+	{
+		for (size_type k = 0; k < N; ++k)
+		{
+			if (extents[k] == 0 || chunk_extents[k] == 0)
+				throw std::invalid_argument("extents of chunked_dynarray must not be 0");
+
+			array_extents[k] = extents[k];
+			chunk_shape[k] = std::min(chunk_extents[k], extents[k]);
+			chunk_grid[k] = (extents[k] + chunk_shape[k] - 1) / chunk_shape[k];
+			if (chunk_elements > std::numeric_limits<size_type>::max() / chunk_shape[k] / sizeof(T) ||
+			    chunk_total > std::numeric_limits<size_type>::max() / chunk_grid[k] ||
+			    total_elements > std::numeric_limits<size_type>::max() / extents[k])
+				throw std::length_error("array too long");
+			chunk_elements *= chunk_shape[k];
+			chunk_total *= chunk_grid[k];
+			total_elements *= extents[k];
+		}
+
+		std::uint64_t chunk_bytes = static_cast<std::uint64_t>(chunk_elements) * sizeof(T);
+		if (chunk_total > static_cast<std::uint64_t>(std::numeric_limits<off_t>::max()) / chunk_bytes)
+			throw std::length_error("array too long");
+		std::uint64_t file_size = chunk_total * chunk_bytes;
+
+		capacity = std::max(cache_chunks, pinned_chunks);
+		writable = mode != chunk_file_mode::read_only;
+		int flags = mode == chunk_file_mode::create ? O_RDWR | O_CREAT | O_TRUNC : mode == chunk_file_mode::open ? O_RDWR : O_RDONLY;
+		descriptor = ::open(path, flags, 0644);
+		if (descriptor == -1)
+			throw std::system_error(errno, std::generic_category(), "cannot open file");
+
+		struct stat file_status = {};
+		int error_code = 0;
+		if (mode == chunk_file_mode::create && ::ftruncate(descriptor, static_cast<off_t>(file_size)) == -1)
+			error_code = errno;
+		else if (mode != chunk_file_mode::create && ::fstat(descriptor, &file_status) == -1)
+			error_code = errno;
+
+		if (error_code != 0 || (mode != chunk_file_mode::create && static_cast<std::uint64_t>(file_status.st_size) != file_size))
+		{
+			::close(descriptor);
+			if (error_code != 0)
+				throw std::system_error(error_code, std::generic_category(), "cannot open file");
+			throw std::invalid_argument("file size does not match chunked_dynarray");
+		}
+	}
+
+	template<typename T, std::size_t N>
+	inline chunked_dynarray<T, N>::~chunked_dynarray()
+	{
+		if (prefetched.valid())
+			prefetched.wait();
+
+		try
+		{
+			flush();
+		}
+		catch (...) {}
+
+		::close(descriptor);
+	}
+
+	template<typename T, std::size_t N>
+	inline void
+	chunked_dynarray<T, N>::flush()
+	{
+		for (chunk &resident : resident_chunks)
+		{
+			if (!resident.dirty)
+				continue;
+			store_chunk(resident);
+			resident.dirty = false;
+		}
+	}
+
+	template<typename T, std::size_t N>
+	inline T*
+	chunked_dynarray<T, N>::locate(const size_type *index, bool writing) const
+	{
+		size_type id = 0;
+		size_type offset = 0;
+		for (size_type k = 0; k < N; ++k)
+		{
+			id = id * chunk_grid[k] + index[k] / chunk_shape[k];
+			offset = offset * chunk_shape[k] + index[k] % chunk_shape[k];
+		}
+
+		chunk &resident = last_used != nullptr && last_used->id == id ? *last_used : fetch(id);
+		resident.dirty = resident.dirty || (writing && writable);
+		return resident.data.get() + offset;
+	}
+
+	template<typename T, std::size_t N>
+	inline typename chunked_dynarray<T, N>::chunk&
+	chunked_dynarray<T, N>::fetch(size_type id) const
+	{
+		auto found = chunk_lookup.find(id);
+		if (found != chunk_lookup.end())
+		{
+			resident_chunks.splice(resident_chunks.begin(), resident_chunks, found->second);
+			last_used = &resident_chunks.front();
+			return *last_used;
+		}
+
+		std::unique_ptr<T[]> buffer;
+		if (resident_chunks.size() == capacity)
+		{
+			chunk &evicted = resident_chunks.back();
+			if (evicted.dirty)
+				store_chunk(evicted);
+			buffer = std::move(evicted.data);
+			chunk_lookup.erase(evicted.id);
+			resident_chunks.pop_back();
+		}
+
+		if (prefetched.valid() && prefetch_id == id)
+			buffer = prefetched.get();
+		else
+			buffer = load_chunk(id, std::move(buffer));
+
+		resident_chunks.push_front(chunk{ id, false, std::move(buffer) });
+		chunk_lookup[id] = resident_chunks.begin();
+		last_used = &resident_chunks.front();
+
+		if (id == last_loaded + 1)
+			read_ahead(id + 1);
+		last_loaded = id;
+		return *last_used;
+	}
+
+	template<typename T, std::size_t N>
+	inline std::unique_ptr<T[]>
+	chunked_dynarray<T, N>::load_chunk(size_type id, std::unique_ptr<T[]> buffer) const
+	{
+		if (buffer == nullptr)
+			buffer.reset(new T[chunk_elements]);
+		std::uint64_t chunk_bytes = static_cast<std::uint64_t>(chunk_elements) * sizeof(T);
+		internal_impl::read_file_range(descriptor, buffer.get(), static_cast<std::size_t>(chunk_bytes), id * chunk_bytes);
+		return buffer;
+	}
+
+	template<typename T, std::size_t N>
+	inline void
+	chunked_dynarray<T, N>::store_chunk(const chunk &resident) const
+	{
+		std::uint64_t chunk_bytes = static_cast<std::uint64_t>(chunk_elements) * sizeof(T);
+		internal_impl::write_file_range(descriptor, resident.data.get(), static_cast<std::size_t>(chunk_bytes), resident.id * chunk_bytes);
+	}
+
+	template<typename T, std::size_t N>
+	inline void
+	chunked_dynarray<T, N>::read_ahead(size_type id) const
+	{
+		// a resident chunk may be newer than its copy in the file
+		if (id >= chunk_total || chunk_lookup.count(id) > 0 || (prefetched.valid() && prefetch_id == id))
+			return;
+
+		if (prefetched.valid())
+			prefetched.wait();
+		prefetch_id = id;
+		prefetched = std::async(std::launch::async, [this, id] { return load_chunk(id, nullptr); });
+	}
+
+}	// namespace vla
+
+
+#endif //DYNARRAY_NEAT_CHUNKED_HPP
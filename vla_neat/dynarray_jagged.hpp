@@ -0,0 +1,567 @@
+/** @copyright
+BSD 3-Clause License
+
+Copyright (c) 2020, cnbatch
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*!***************************************************************//*!
+ * @file   dynarray_jagged.hpp
+ * @brief  Jagged 2D array stored as one value block and one offset table
+ *
+ * @author cnbatch
+ * @date   October 2026
+ *********************************************************************/
+
+#pragma once
+#ifndef DYNARRAY_NEAT_JAGGED_HPP
+#define DYNARRAY_NEAT_JAGGED_HPP
+
+#include "dynarray.hpp"
+
+namespace vla
+{
+	/*!
+	 * @brief View of one row of a jagged_dynarray, the elements are contiguous.
+	 *
+	 * It is a pointer and a length, cheap to copy, and valid as long as the jagged_dynarray is neither destroyed nor assigned.
+	 */
+	template<typename T>
+	class jagged_row
+	{
+	public:
+
+		// Member types
+
+		using value_type = std::remove_cv_t<T>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T &;
+		using pointer = T *;
+		using iterator = vla_iterator<T>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+
+		constexpr jagged_row() noexcept = default;
+		constexpr jagged_row(pointer first, size_type count) noexcept : row_head(first), row_size(count) {}
+
+		// a row of a non-const array converts to a row of a const one
+		template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+		constexpr jagged_row(const jagged_row<U> &other) noexcept : row_head(other.data()), row_size(other.size()) {}
+
+		// Element access
+
+		constexpr reference operator[](size_type n) const noexcept { return row_head[n]; }
+
+		/*!
+		 * @brief Access specified element with bounds checking.
+		 *
+		 * @exception std::out_of_range if n is not within the range of the row
+		*/
+		constexpr reference at(size_type n) const
+		{
+			if (n >= row_size)
+				throw std::out_of_range("out of range");
+			return row_head[n];
+		}
+
+		constexpr reference front() const noexcept { return row_head[0]; }
+		constexpr reference back() const noexcept { return row_head[row_size - 1]; }
+		constexpr pointer data() const noexcept { return row_head; }
+
+		// Iterators
+
+		constexpr iterator begin() const noexcept { return iterator(row_head); }
+		constexpr iterator end() const noexcept { return iterator(row_head + row_size); }
+		constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+		constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+		// Capacity
+
+		CPP20_DYNARRAY_NODISCARD constexpr bool empty() const noexcept { return row_size == 0; }
+		constexpr size_type size() const noexcept { return row_size; }
+
+	private:
+		pointer row_head = nullptr;
+		size_type row_size = 0;
+	};
+
+	/*!
+	 * @brief Two-dimensional array whose rows have different lengths, stored like CSR: one contiguous block of values and one offset table.
+	 *
+	 * Row i is [offsets()[i], offsets()[i + 1]) of the block. Finding a row reads two offsets, there are no nodes per row;
+	 * the overhead is one size_type per row, instead of one dynarray node per row of the nested versions.
+	 * The shape is fixed after construction, the values can be changed through the rows.
+	 */
+	template<typename T, template<typename U> typename _Allocator = std::allocator>
+	class jagged_dynarray
+	{
+		template<bool Const>
+		class row_iterator;
+	public:
+
+		// Member types
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T *;
+		using const_pointer = const T *;
+		using row_type = jagged_row<T>;
+		using const_row_type = jagged_row<const T>;
+		using reference = row_type;
+		using const_reference = const_row_type;
+		using iterator = row_iterator<false>;
+		using const_iterator = row_iterator<true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using allocator_type = _Allocator<T>;
+		using offset_allocator_type = _Allocator<size_type>;
+
+		// Constructors
+
+		jagged_dynarray() noexcept = default;
+
+		/*!
+		 * @brief Create a jagged array with nested initializer_list.\n
+		 * Example: vla::jagged_dynarray<int> my_array = { {10, 100, 1000}, {1, 3, 5}, {0, 3} };
+		 */
+		jagged_dynarray(std::initializer_list<std::initializer_list<T>> input_list);
+
+		/*!
+		 * @brief Create a jagged array from a range of rows, each row is a range itself (std::vector, dynarray, etc.)\n
+		 * Example: vla::jagged_dynarray<int> my_array(rows.begin(), rows.end());
+		 *
+		 * Contiguous rows of trivially copyable elements are copied with a single memcpy.
+		 *
+		 * The rows are walked twice, first for their lengths and then for their elements, so RowIterator has to be a forward iterator.
+		 *
+		 * @param first Forward iterator to the first row
+		 * @param last End of the rows
+		 */
+		template<typename RowIterator, typename = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<RowIterator>::iterator_category>,
+		                                                           decltype(std::begin(*std::declval<RowIterator&>()), void())>>
+		jagged_dynarray(RowIterator first, RowIterator last);
+
+		/*!
+		 * @brief Create a jagged array from the values of all rows one after another, and the length of each row.\n
+		 * Example: vla::jagged_dynarray<int> my_array(values.begin(), lengths.begin(), lengths.end());
+		 *
+		 * @param values Input iterator to the first value, there have to be as many values as the lengths add up to
+		 * @param lengths_first Iterator to the length of the first row
+		 * @param lengths_last End of the lengths
+		 */
+		template<typename InputIterator, typename LengthIterator>
+		jagged_dynarray(InputIterator values, LengthIterator lengths_first, LengthIterator lengths_last);
+
+		jagged_dynarray(const jagged_dynarray &other);
+
+		jagged_dynarray(jagged_dynarray &&other) noexcept { swap(other); }
+
+		~jagged_dynarray() { release_storage(); }
+
+		jagged_dynarray& operator=(const jagged_dynarray &other)
+		{
+			if (this != &other)
+			{
+				jagged_dynarray duplicate(other);
+				swap(duplicate);
+			}
+			return *this;
+		}
+
+		jagged_dynarray& operator=(jagged_dynarray &&other) noexcept
+		{
+			jagged_dynarray moved(std::move(other));
+			swap(moved);
+			return *this;
+		}
+
+		// Element access
+
+		/*!
+		 * @brief Access a row, in constant time
+		 *
+		 * @param n Position of the row
+		 * @return View of the row
+		 */
+		row_type operator[](size_type n) noexcept { return row_type(value_block + offset_table[n], offset_table[n + 1] - offset_table[n]); }
+		const_row_type operator[](size_type n) const noexcept { return const_row_type(value_block + offset_table[n], offset_table[n + 1] - offset_table[n]); }
+
+		/*!
+		 * @brief Access a row with bounds checking.
+		 *
+		 * @exception std::out_of_range if n is not within the range of the container
+		 */
+		row_type at(size_type n)
+		{
+			if (n >= row_count)
+				throw std::out_of_range("out of range");
+			return (*this)[n];
+		}
+
+		const_row_type at(size_type n) const
+		{
+			if (n >= row_count)
+				throw std::out_of_range("out of range");
+			return (*this)[n];
+		}
+
+		row_type front() noexcept { return (*this)[0]; }
+		const_row_type front() const noexcept { return (*this)[0]; }
+
+		row_type back() noexcept { return (*this)[row_count - 1]; }
+		const_row_type back() const noexcept { return (*this)[row_count - 1]; }
+
+		/*!
+		 * @brief The values of all rows, one after another
+		 */
+		pointer data() noexcept { return value_block; }
+		const_pointer data() const noexcept { return value_block; }
+
+		/*!
+		 * @brief The offset table, size() + 1 entries; the first one is 0, the last one is element_count()
+		 */
+		const size_type* offsets() const noexcept { return offset_table; }
+
+		// Iterators
+
+		iterator begin() noexcept { return iterator(this, 0); }
+		const_iterator begin() const noexcept { return cbegin(); }
+		const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+		iterator end() noexcept { return iterator(this, row_count); }
+		const_iterator end() const noexcept { return cend(); }
+		const_iterator cend() const noexcept { return const_iterator(this, row_count); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return crend(); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+		// Capacity
+
+		CPP20_DYNARRAY_NODISCARD bool empty() const noexcept { return row_count == 0; }
+
+		/*!
+		 * @brief Returns the number of rows
+		 */
+		size_type size() const noexcept { return row_count; }
+
+		/*!
+		 * @brief Returns the number of values of all rows
+		 */
+		size_type element_count() const noexcept { return row_count == 0 ? 0 : offset_table[row_count]; }
+
+		// Operations
+
+		/*!
+		 * @brief Calls function for each row, in order.
+		 *
+		 * @param function Called as function(row) or function(position, row)
+		 */
+		template<typename Function>
+		void for_each_row(Function function) { visit_rows(*this, internal_impl::sequenced_tasks(), function); }
+
+		template<typename Function>
+		void for_each_row(Function function) const { visit_rows(*this, internal_impl::sequenced_tasks(), function); }
+
+		/*!
+		 * @brief Calls function for each row with an execution policy (std::execution::par, etc.), rows are independent so they can be processed concurrently.\n
+		 * Example: my_array.for_each_row(std::execution::par, [](auto row) { std::sort(row.begin(), row.end()); });
+		 *
+		 * <execution> is not included by this file, include it yourself.
+		 *
+		 * @param policy Execution policy
+		 * @param function Called as function(row) or function(position, row)
+		 */
+		template<typename ExecutionPolicy, typename Function>
+		void for_each_row(ExecutionPolicy &&policy, Function function)
+		{
+			visit_rows(*this, internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, function);
+		}
+
+		template<typename ExecutionPolicy, typename Function>
+		void for_each_row(ExecutionPolicy &&policy, Function function) const
+		{
+			visit_rows(*this, internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, function);
+		}
+
+		/*!
+		 * @brief Assigns value to every element.
+		 */
+		void fill(const T &value) { std::fill(value_block, value_block + element_count(), value); }
+
+		void swap(jagged_dynarray &other) noexcept
+		{
+			std::swap(value_block, other.value_block);
+			std::swap(offset_table, other.offset_table);
+			std::swap(row_count, other.row_count);
+			std::swap(value_allocator, other.value_allocator);
+			std::swap(offset_allocator, other.offset_allocator);
+		}
+
+		friend void swap(jagged_dynarray &lhs, jagged_dynarray &rhs) noexcept { lhs.swap(rhs); }
+
+		friend bool operator==(const jagged_dynarray &lhs, const jagged_dynarray &rhs)
+		{
+			return lhs.row_count == rhs.row_count &&
+				std::equal(lhs.offset_table, lhs.offset_table + (lhs.row_count == 0 ? 0 : lhs.row_count + 1), rhs.offset_table) &&
+				std::equal(lhs.value_block, lhs.value_block + lhs.element_count(), rhs.value_block);
+		}
+
+		friend bool operator!=(const jagged_dynarray &lhs, const jagged_dynarray &rhs) { return !(lhs == rhs); }
+
+	private:
+		template<typename LengthOf, typename ConstructValues>
+		void construct_rows(size_type rows, LengthOf length_of, ConstructValues construct_values);
+
+		void release_storage() noexcept;
+
+		template<typename Self, typename TaskRunner, typename Function>
+		static void visit_rows(Self &self, const TaskRunner &run_tasks, Function &function);
+
+		pointer value_block = nullptr;
+		size_type *offset_table = nullptr;	// row_count + 1 entries, nullptr if there is no row
+		size_type row_count = 0;
+		allocator_type value_allocator;
+		offset_allocator_type offset_allocator;
+	};
+
+	/*!
+	 * @brief Random access iterator over the rows of a jagged_dynarray, dereferencing returns a jagged_row by value.
+	 */
+	template<typename T, template<typename U> typename _Allocator>
+	template<bool Const>
+	class jagged_dynarray<T, _Allocator>::row_iterator
+	{
+		using owner_pointer = std::conditional_t<Const, const jagged_dynarray *, jagged_dynarray *>;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::conditional_t<Const, const_row_type, row_type>;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+		using pointer = void;
+
+		row_iterator() noexcept = default;
+		row_iterator(owner_pointer owner, size_type position) noexcept : owner(owner), position(position) {}
+
+		reference operator*() const noexcept { return (*owner)[position]; }
+		reference operator[](difference_type n) const noexcept { return (*owner)[position + n]; }
+
+		row_iterator& operator++() noexcept { ++position; return *this; }
+		row_iterator operator++(int) noexcept { row_iterator old = *this; ++position; return old; }
+		row_iterator& operator--() noexcept { --position; return *this; }
+		row_iterator operator--(int) noexcept { row_iterator old = *this; --position; return old; }
+		row_iterator& operator+=(difference_type n) noexcept { position += n; return *this; }
+		row_iterator& operator-=(difference_type n) noexcept { position -= n; return *this; }
+
+		friend row_iterator operator+(row_iterator it, difference_type n) noexcept { return it += n; }
+		friend row_iterator operator+(difference_type n, row_iterator it) noexcept { return it += n; }
+		friend row_iterator operator-(row_iterator it, difference_type n) noexcept { return it -= n; }
+		friend difference_type operator-(const row_iterator &lhs, const row_iterator &rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.position) - static_cast<difference_type>(rhs.position);
+		}
+
+		friend bool operator==(const row_iterator &lhs, const row_iterator &rhs) noexcept { return lhs.position == rhs.position; }
+		friend bool operator!=(const row_iterator &lhs, const row_iterator &rhs) noexcept { return lhs.position != rhs.position; }
+		friend bool operator<(const row_iterator &lhs, const row_iterator &rhs) noexcept { return lhs.position < rhs.position; }
+		friend bool operator>(const row_iterator &lhs, const row_iterator &rhs) noexcept { return lhs.position > rhs.position; }
+		friend bool operator<=(const row_iterator &lhs, const row_iterator &rhs) noexcept { return lhs.position <= rhs.position; }
+		friend bool operator>=(const row_iterator &lhs, const row_iterator &rhs) noexcept { return lhs.position >= rhs.position; }
+
+	private:
+		owner_pointer owner = nullptr;
+		size_type position = 0;
+	};
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline jagged_dynarray<T, _Allocator>::jagged_dynarray(std::initializer_list<std::initializer_list<T>> input_list)
+	{
+		const std::initializer_list<T> *rows = input_list.begin();
+		construct_rows(input_list.size(), [rows](size_type row) { return rows[row].size(); },
+			[this, rows](size_type row)
+			{
+				internal_impl::copy_construct_block(value_allocator, value_block + offset_table[row], rows[row].begin(), rows[row].size());
+			});
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename RowIterator, typename>
+	inline jagged_dynarray<T, _Allocator>::jagged_dynarray(RowIterator first, RowIterator last)
+	{
+		RowIterator length_cursor = first;
+		construct_rows(static_cast<size_type>(std::distance(first, last)),
+			[&length_cursor](size_type)
+			{
+				auto length = std::distance(std::begin(*length_cursor), std::end(*length_cursor));
+				++length_cursor;
+				return static_cast<size_type>(length);
+			},
+			[this, &first](size_type row)
+			{
+				internal_impl::copy_construct_range(value_allocator, value_block + offset_table[row], std::begin(*first), offset_table[row + 1] - offset_table[row]);
+				++first;
+			});
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename InputIterator, typename LengthIterator>
+	inline jagged_dynarray<T, _Allocator>::jagged_dynarray(InputIterator values, LengthIterator lengths_first, LengthIterator lengths_last)
+	{
+		size_type rows = static_cast<size_type>(std::distance(lengths_first, lengths_last));
+		construct_rows(rows,
+			[&lengths_first](size_type)
+			{
+				size_type length = static_cast<size_type>(*lengths_first);
+				++lengths_first;
+				return length;
+			},
+			[this, &values](size_type row)
+			{
+				values = internal_impl::copy_construct_range(value_allocator, value_block + offset_table[row], values, offset_table[row + 1] - offset_table[row]);
+			});
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline jagged_dynarray<T, _Allocator>::jagged_dynarray(const jagged_dynarray &other)
+		: value_allocator(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.value_allocator)),
+		  offset_allocator(std::allocator_traits<offset_allocator_type>::select_on_container_copy_construction(other.offset_allocator))
+	{
+		const size_type *other_offsets = other.offset_table;
+		construct_rows(other.row_count, [other_offsets](size_type row) { return other_offsets[row + 1] - other_offsets[row]; },
+			[this, &other](size_type row)
+			{
+				internal_impl::copy_construct_block(value_allocator, value_block + offset_table[row], other.value_block + offset_table[row],
+				                                    offset_table[row + 1] - offset_table[row]);
+			});
+	}
+
+	/*!
+	 * @brief Fills the offset table with the lengths of rows, allocates the value block, and constructs the rows in order.
+	 *
+	 * If anything throws, the rows constructed before are destroyed, and both allocations are released.
+	 *
+	 * @param rows Number of rows
+	 * @param length_of length_of(row) returns the number of elements of row, called for row 0, 1, 2, ...
+	 * @param construct_values construct_values(row) constructs elements [offset_table[row], offset_table[row + 1]), called for row 0, 1, 2, ...
+	 *                         if it throws, it has to destroy the elements of row it has constructed
+	 */
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename LengthOf, typename ConstructValues>
+	inline void
+	jagged_dynarray<T, _Allocator>::construct_rows(size_type rows, LengthOf length_of, ConstructValues construct_values)
+	{
+		if (rows == 0)
+			return;
+
+		const size_type limit = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+		if (rows >= std::min(limit, std::allocator_traits<offset_allocator_type>::max_size(offset_allocator)))
+			throw std::length_error("array too long");
+
+		offset_table = offset_allocator.allocate(rows + 1);
+		size_type constructed = 0;
+		try
+		{
+			offset_table[0] = 0;
+			for (size_type row = 0; row < rows; ++row)
+			{
+				size_type length = length_of(row);
+				if (length > limit - offset_table[row])
+					throw std::length_error("array too long");
+				offset_table[row + 1] = offset_table[row] + length;
+			}
+
+			size_type count = offset_table[rows];
+			if (count > std::allocator_traits<allocator_type>::max_size(value_allocator))
+				throw std::length_error("array too long");
+			if (count > 0)
+				value_block = value_allocator.allocate(count);
+
+			for (; constructed < rows; ++constructed)
+				construct_values(constructed);
+		}
+		catch (...)
+		{
+			if (value_block != nullptr)
+			{
+				for (size_type i = offset_table[constructed]; i > 0; --i)
+					std::allocator_traits<allocator_type>::destroy(value_allocator, value_block + i - 1);
+				value_allocator.deallocate(value_block, offset_table[rows]);
+				value_block = nullptr;
+			}
+			offset_allocator.deallocate(offset_table, rows + 1);
+			offset_table = nullptr;
+			throw;
+		}
+		row_count = rows;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+	jagged_dynarray<T, _Allocator>::release_storage() noexcept
+	{
+		if (offset_table == nullptr)
+			return;
+
+		size_type count = offset_table[row_count];
+		if (value_block != nullptr)
+		{
+			for (size_type i = count; i > 0; --i)
+				std::allocator_traits<allocator_type>::destroy(value_allocator, value_block + i - 1);
+			value_allocator.deallocate(value_block, count);
+		}
+		offset_allocator.deallocate(offset_table, row_count + 1);
+		value_block = nullptr;
+		offset_table = nullptr;
+		row_count = 0;
+	}
+
+	/*!
+	 * @brief One task per row, the task finds its row from the offset table so no state is shared between tasks.
+	 */
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Self, typename TaskRunner, typename Function>
+	inline void
+	jagged_dynarray<T, _Allocator>::visit_rows(Self &self, const TaskRunner &run_tasks, Function &function)
+	{
+		run_tasks(self.row_count, [&self, &function](size_type row)
+			{
+				if constexpr (std::is_invocable_v<Function &, size_type, decltype(self[row])>)
+					function(row, self[row]);
+				else
+					function(self[row]);
+			});
+	}
+}	// namespace vla
+
+
+#endif //DYNARRAY_NEAT_JAGGED_HPP
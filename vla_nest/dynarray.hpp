@@ -56,15 +56,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DYNARRAY_HPP
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <initializer_list>
+#include <istream>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <new>
 #include <numeric>
+#include <ostream>
 #include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #if __cplusplus >= 202002L || (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L))
 #define DYNARRAY_USING_CPP20
@@ -83,6 +96,14 @@ namespace vla
 	template<typename T, template<typename U> typename _Allocator>
 	class dynarray;
 
+	template<typename T>
+	class vla_iterator;
+
+	template<std::size_t N = 1, template<typename U> typename _Allocator = std::allocator>
+	class bit_dynarray;
+
+	class npz_writer;
+
 	namespace internal_impl
 	{
 		template <typename T, template<typename U> typename _Allocator>
@@ -99,1214 +120,2341 @@ namespace vla
 			enum { nested_level = inner_type<T, _Allocator>::nested_level + 1 };
 		};
 
+		/*!
+		 * @brief Nested dynarray of Rank dimensions holding T, e.g. dynarray<dynarray<T>> for Rank 2.
+		 */
+		template<typename T, std::size_t Rank, template<typename U> typename _Allocator>
+		struct nested_dynarray
+		{
+			using type = dynarray<typename nested_dynarray<T, Rank - 1, _Allocator>::type, _Allocator>;
+		};
+
+		template<typename T, template<typename U> typename _Allocator>
+		struct nested_dynarray<T, 1, _Allocator>
+		{
+			using type = dynarray<T, _Allocator>;
+		};
+
+		template<typename T, std::size_t Rank, template<typename U> typename _Allocator>
+		using nested_dynarray_t = typename nested_dynarray<T, Rank, _Allocator>::type;
+
 		template<typename Skip> CPP20_DYNARRAY_CONSTEXPR
 			std::size_t expand_parameters(std::size_t count, const Skip &skip) { return count; }
 
 		template<typename Skip, typename ... Args> CPP20_DYNARRAY_CONSTEXPR
 			std::size_t expand_parameters(std::size_t count, const Skip &skip, Args&& ... args) { return count * expand_parameters(std::forward<Args>(args)...); }
 
-	}	// internal namespace
+		// number of lanes (elements of a row) handled by one task when scanning along an outer axis
+		inline constexpr std::size_t scan_lane_width = 1024;
 
-	template<typename T>
-	class vla_iterator
-	{
-		using self_value_type = vla_iterator<T>;
-		using self_reference = vla_iterator<T> &;
-	public:
-		using iterator_category = std::random_access_iterator_tag;
-		using value_type = T;
-		using difference_type = std::ptrdiff_t;
-		using pointer = T*;
-		using reference = T&;
+		// length of the blocks of a row scanned independently when scanning along the innermost axis in parallel
+		inline constexpr std::size_t scan_block_size = 16384;
 
-		CPP20_DYNARRAY_CONSTEXPR explicit vla_iterator(pointer ptr = nullptr) : dynarray_ptr(ptr) {}
-		CPP20_DYNARRAY_CONSTEXPR vla_iterator(const vla_iterator<T> &other_iterator) : dynarray_ptr(other_iterator.dynarray_ptr) {}
+		/*!
+		 * @brief Random access iterator over task indices, lets parallel algorithms of std iterate over a plain range of numbers.
+		 */
+		class counting_iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const std::size_t*;
+			using reference = std::size_t;
 
-		// operators
+			constexpr explicit counting_iterator(std::size_t value = 0) noexcept : current_value(value) {}
 
-		CPP20_DYNARRAY_CONSTEXPR reference operator*() const noexcept { return *dynarray_ptr; }
+			constexpr reference operator*() const noexcept { return current_value; }
 
-		CPP20_DYNARRAY_CONSTEXPR pointer operator->() const noexcept { return dynarray_ptr; }
+			constexpr reference operator[](difference_type offset) const noexcept { return current_value + offset; }
 
-		CPP20_DYNARRAY_CONSTEXPR reference operator[](difference_type offset) const noexcept { return dynarray_ptr[offset]; }
+			constexpr counting_iterator& operator++() noexcept { ++current_value; return *this; }
 
-		CPP20_DYNARRAY_CONSTEXPR self_reference operator=(const self_value_type & right_iterator) noexcept { dynarray_ptr = right_iterator.dynarray_ptr; return *this; }
+			constexpr counting_iterator operator++(int) noexcept { return counting_iterator(current_value++); }
 
-		CPP20_DYNARRAY_CONSTEXPR self_reference operator=(pointer ptr) noexcept { dynarray_ptr = ptr; return *this; }
+			constexpr counting_iterator& operator--() noexcept { --current_value; return *this; }
 
-		CPP20_DYNARRAY_CONSTEXPR self_reference operator++() noexcept { ++dynarray_ptr; return *this; }
+			constexpr counting_iterator operator--(int) noexcept { return counting_iterator(current_value--); }
 
-		CPP20_DYNARRAY_CONSTEXPR self_value_type operator++(int) noexcept { return self_value_type(dynarray_ptr++); }
+			constexpr counting_iterator& operator+=(difference_type offset) noexcept { current_value += offset; return *this; }
 
-		CPP20_DYNARRAY_CONSTEXPR self_reference operator--() noexcept { --dynarray_ptr; return *this; }
+			constexpr counting_iterator& operator-=(difference_type offset) noexcept { current_value -= offset; return *this; }
 
-		CPP20_DYNARRAY_CONSTEXPR self_value_type operator--(int) noexcept { return self_value_type(dynarray_ptr--); }
+			constexpr counting_iterator operator+(difference_type offset) const noexcept { return counting_iterator(current_value + offset); }
 
-		CPP20_DYNARRAY_CONSTEXPR self_reference operator+=(difference_type offset) noexcept { dynarray_ptr += offset; return *this; }
+			constexpr counting_iterator operator-(difference_type offset) const noexcept { return counting_iterator(current_value - offset); }
 
-		CPP20_DYNARRAY_CONSTEXPR self_reference operator-=(difference_type offset) noexcept { dynarray_ptr -= offset; return *this; }
+			constexpr difference_type operator-(const counting_iterator &other) const noexcept
+			{
+				return static_cast<difference_type>(current_value) - static_cast<difference_type>(other.current_value);
+			}
 
-		CPP20_DYNARRAY_CONSTEXPR self_value_type operator+(difference_type offset) const noexcept { return self_value_type(dynarray_ptr) += offset; }
+			constexpr bool operator==(const counting_iterator &other) const noexcept { return current_value == other.current_value; }
 
-		CPP20_DYNARRAY_CONSTEXPR self_value_type operator-(difference_type offset) const noexcept { return self_value_type(dynarray_ptr - offset); }
+			constexpr bool operator!=(const counting_iterator &other) const noexcept { return current_value != other.current_value; }
 
-		CPP20_DYNARRAY_CONSTEXPR difference_type operator-(const self_value_type & right_iterator) const noexcept { return dynarray_ptr - right_iterator.dynarray_ptr; }
+			constexpr bool operator<(const counting_iterator &other) const noexcept { return current_value < other.current_value; }
 
-		CPP20_DYNARRAY_CONSTEXPR bool operator==(const self_value_type &right_iterator) const noexcept { return dynarray_ptr == right_iterator.dynarray_ptr; }
+			constexpr bool operator>(const counting_iterator &other) const noexcept { return current_value > other.current_value; }
 
-#ifdef DYNARRAY_USING_CPP20
-		CPP20_DYNARRAY_CONSTEXPR auto operator<=>(const self_value_type &right_iterator) const noexcept = default;
-#else
-		bool operator!=(const self_value_type &right_iterator) const noexcept { return dynarray_ptr != right_iterator.dynarray_ptr; }
+			constexpr bool operator<=(const counting_iterator &other) const noexcept { return current_value <= other.current_value; }
 
-		bool operator<(const self_value_type &right_iterator) const noexcept { return dynarray_ptr < right_iterator.dynarray_ptr; }
+			constexpr bool operator>=(const counting_iterator &other) const noexcept { return current_value >= other.current_value; }
 
-		bool operator>(const self_value_type &right_iterator) const noexcept { return dynarray_ptr > right_iterator.dynarray_ptr; }
+			friend constexpr counting_iterator operator+(difference_type offset, const counting_iterator &other) noexcept { return other + offset; }
 
-		bool operator<=(const self_value_type &right_iterator) const noexcept { return dynarray_ptr <= right_iterator.dynarray_ptr; }
+		private:
+			std::size_t current_value;
+		};
 
-		bool operator>=(const self_value_type &right_iterator) const noexcept { return dynarray_ptr >= right_iterator.dynarray_ptr; }
-#endif
+		/*!
+		 * @brief Runs tasks one by one in current thread.
+		 */
+		struct sequenced_tasks
+		{
+			static constexpr bool concurrent = false;
 
-		friend CPP20_DYNARRAY_CONSTEXPR self_value_type operator+(typename vla_iterator::difference_type offset, const self_value_type &other) noexcept { return self_value_type(other) += offset; }
+			template<typename Function>
+			CPP20_DYNARRAY_CONSTEXPR void operator()(std::size_t task_count, Function &&task) const
+			{
+				for (std::size_t i = 0; i < task_count; ++i)
+					task(i);
+			}
+		};
 
-	private:
-		pointer dynarray_ptr;
-	};
+		/*!
+		 * @brief Runs tasks with an execution policy (std::execution::par, std::execution::par_unseq, etc.)
+		 *
+		 * Parallel algorithms are declared by <algorithm>, the policy objects come from <execution>, which is included by the caller.
+		 */
+		template<typename ExecutionPolicy>
+		struct policy_tasks
+		{
+			static constexpr bool concurrent = true;
 
+			ExecutionPolicy &policy;
 
-	template<typename T, template<typename U> typename _Allocator = std::allocator>
-	class dynarray
-	{
-		friend class dynarray<dynarray<T, _Allocator>, _Allocator>;
-	public:
+			template<typename Function>
+			void operator()(std::size_t task_count, Function &&task) const
+			{
+				std::for_each(policy, counting_iterator(0), counting_iterator(task_count), std::forward<Function>(task));
+			}
+		};
 
-		// Member types
+		/*!
+		 * @brief Scan a contiguous rectangular block along one axis, in place.
+		 *
+		 * The block is viewed as [outer][extent][inner]. Scanning along an outer axis adds whole rows to the following rows,
+		 * these lane-wise loops are contiguous and can be vectorised by compiler. Scanning along the innermost axis with a
+		 * concurrent task runner splits each row into blocks: scan each block, carry the block tails, then add the carries.
+		 *
+		 * @param data First element of the block
+		 * @param extents Extents of all dimensions
+		 * @param rank Number of dimensions
+		 * @param axis The dimension to scan along
+		 * @param op Binary operation
+		 * @param init nullptr for inclusive scan, pointer to the initial value for exclusive scan
+		 * @param run_tasks Task runner
+		 */
+		template<typename T, typename BinaryOperation, typename TaskRunner>
+		CPP20_DYNARRAY_CONSTEXPR void scan_along_axis(T *data, const std::size_t *extents, std::size_t rank, std::size_t axis,
+		                                              BinaryOperation &op, const T *init, const TaskRunner &run_tasks)
+		{
+			std::size_t outer = 1;
+			std::size_t inner = 1;
+			for (std::size_t i = 0; i < axis; ++i)
+				outer *= extents[i];
+			for (std::size_t i = axis + 1; i < rank; ++i)
+				inner *= extents[i];
 
-		using value_type = T;
-		using size_type = std::size_t;
-		using difference_type = std::ptrdiff_t;
-		using reference = value_type &;
-		using const_reference = const value_type &;
-		using pointer = value_type *;
-		using const_pointer = const value_type *;
+			const std::size_t extent = extents[axis];
+			const std::size_t stride = extent * inner;
+			if (outer == 0 || extent == 0 || inner == 0) return;
 
-		using iterator = vla_iterator<T>;
-		using const_iterator = vla_iterator<const T>;
-		using reverse_iterator = std::reverse_iterator<iterator>;
-		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+			const std::size_t lane_groups = (inner + scan_lane_width - 1) / scan_lane_width;
 
-		using allocator_type = _Allocator<T>;
-	private:
-		using internal_value_type = typename internal_impl::inner_type<T, _Allocator>::value_type;
-		using internal_pointer_type = internal_value_type *;
-	public:
-		using contiguous_allocator_type = _Allocator<internal_value_type>;
+			if (TaskRunner::concurrent && inner == 1 && extent > scan_block_size)
+			{
+				const std::size_t blocks = (extent + scan_block_size - 1) / scan_block_size;
+				run_tasks(outer * blocks, [=, &op](std::size_t task)
+				{
+					T *row = data + (task / blocks) * stride;
+					std::size_t first = (task % blocks) * scan_block_size;
+					std::size_t last = std::min(extent, first + scan_block_size);
+					if (first == 0 && init != nullptr)
+						row[0] = op(*init, row[0]);
+					for (std::size_t j = first + 1; j < last; ++j)
+						row[j] = op(row[j - 1], row[j]);
+				});
+
+				for (std::size_t o = 0; o < outer; ++o)
+				{
+					T *row = data + o * stride;
+					for (std::size_t b = 1; b < blocks; ++b)
+					{
+						std::size_t tail = std::min(extent, (b + 1) * scan_block_size) - 1;
+						row[tail] = op(row[b * scan_block_size - 1], row[tail]);
+					}
+				}
 
-		// Member functions
+				run_tasks(outer * blocks, [=, &op](std::size_t task)
+				{
+					std::size_t first = (task % blocks) * scan_block_size;
+					if (first == 0) return;
+					T *row = data + (task / blocks) * stride;
+					std::size_t tail = std::min(extent, first + scan_block_size) - 1;
+					const T carry = row[first - 1];
+					for (std::size_t j = first; j < tail; ++j)
+						row[j] = op(carry, row[j]);
+				});
+			}
+			else
+			{
+				run_tasks(outer * lane_groups, [=, &op](std::size_t task)
+				{
+					T *block = data + (task / lane_groups) * stride;
+					std::size_t lane_begin = (task % lane_groups) * scan_lane_width;
+					std::size_t lane_end = std::min(inner, lane_begin + scan_lane_width);
+					if (init != nullptr)
+						for (std::size_t k = lane_begin; k < lane_end; ++k)
+							block[k] = op(*init, block[k]);
+
+					for (std::size_t j = 1; j < extent; ++j)
+					{
+						T *previous = block + (j - 1) * inner;
+						T *current = previous + inner;
+						for (std::size_t k = lane_begin; k < lane_end; ++k)
+							current[k] = op(previous[k], current[k]);
+					}
+				});
+			}
 
-		/*!
-		 * @brief Default Constructor.
-		 * Create a zero-size array.
-		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray() noexcept
-		{
-			initialise();
+			if (init == nullptr) return;
+
+			// exclusive scan: shift the inclusive result by one step and put init in front
+			run_tasks(outer * lane_groups, [=](std::size_t task)
+			{
+				T *block = data + (task / lane_groups) * stride;
+				std::size_t lane_begin = (task % lane_groups) * scan_lane_width;
+				std::size_t lane_end = std::min(inner, lane_begin + scan_lane_width);
+				for (std::size_t j = extent - 1; j > 0; --j)
+				{
+					T *current = block + j * inner;
+					T *previous = current - inner;
+					for (std::size_t k = lane_begin; k < lane_end; ++k)
+						current[k] = previous[k];
+				}
+				for (std::size_t k = lane_begin; k < lane_end; ++k)
+					block[k] = *init;
+			});
 		}
 
 		/*!
-		 * @brief Construct by count.
-		 * Create a one-dimensional array.
+		 * @brief Turn a contiguous 2D block into its summed-area table, in place.
 		 *
-		 * @param count The size (length) of array
+		 * @param data First element of the block
+		 * @param rows Number of rows
+		 * @param columns Number of columns
+		 * @param run_tasks Task runner
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count)
+		template<typename T, typename TaskRunner>
+		CPP20_DYNARRAY_CONSTEXPR void summed_area(T *data, std::size_t rows, std::size_t columns, const TaskRunner &run_tasks)
 		{
-			initialise();
-			allocate_array(count);
+			std::plus<> op;
+			if constexpr (TaskRunner::concurrent)
+			{
+				const std::size_t extents[2] = { rows, columns };
+				scan_along_axis(data, extents, 2, 1, op, static_cast<const T *>(nullptr), run_tasks);
+				scan_along_axis(data, extents, 2, 0, op, static_cast<const T *>(nullptr), run_tasks);
+			}
+			else
+			{
+				// one pass over memory: scan a row, then add the finished row above while it is still in cache
+				for (std::size_t i = 0; i < rows; ++i)
+				{
+					T *current = data + i * columns;
+					for (std::size_t j = 1; j < columns; ++j)
+						current[j] = op(current[j - 1], current[j]);
+
+					if (i == 0) continue;
+					T *previous = current - columns;
+					for (std::size_t j = 0; j < columns; ++j)
+						current[j] = op(previous[j], current[j]);
+				}
+			}
 		}
 
-		/*!
-		 * @brief Construct by count and use your custom allocator.
-		 * Create a one-dimensional array.
-		 *
-		 * @param count The size (length) of array
-		 * @param other_allocator Your custom allocator
-		 */
-		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count, _Alloc_t &&other_allocator)
+		// elements of these types are equal if and only if their bytes are equal
+		template<typename T>
+		inline constexpr bool is_bitwise_comparable_v = (std::is_integral_v<T> || std::is_pointer_v<T>) && std::has_unique_object_representations_v<T>;
+
+		template<typename T>
+		CPP20_DYNARRAY_CONSTEXPR bool equal_bitwise(const T *lhs, const T *rhs, std::size_t count) noexcept
 		{
-			initialise(other_allocator);
-			allocate_array(count);
+			if (count == 0 || lhs == rhs)
+				return true;
+#ifdef DYNARRAY_USING_CPP20
+			if (std::is_constant_evaluated())
+				return std::equal(lhs, lhs + count, rhs);
+#endif
+			return std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
 		}
 
 		/*!
-		 * @brief Usage 1: Construct by multiple 'count'.\n
-		 * Create a multi-dimensional array.\n
-		 * Example A: dynarray<dynarray<int>> my_array(10, 10);         // creates a 2D array (10 × 10), initialise with default value (zero)\n
-		 * Example B: dynarray<dynarray<int>> my_array(10, 10, 20);     // creates a 2D array (10 × 10), initialise with value (20)
-		 *
-		 * Usage 2: Construct by a 'count' and initialise the elements with 'args'\n
-		 * Create a one-dimensional array, use 'args' to initialise the array's elements.\n
-		 * Example A: dynarray<int> my_array(100);                      // creates an array (100 elements), initialise with default value (zero)\n
-		 * Example B: dynarray<int> my_array(100, 20);                  // creates an array (100 elements), initialise with value (20)
+		 * @brief Find the first position where two blocks differ, compare them chunk by chunk with memcmp.
 		 *
-		 * @param count The first dimention
-		 * @param ...args If 'sizeof...(args)' is greater than the level of nested array, the rest of arg(s) will be used for initial array's elements.
+		 * @return Position of the first mismatch, or count if the blocks are equal
 		 */
-		template<typename ... Args>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count, Args&& ... args)
+		template<typename T>
+		CPP20_DYNARRAY_CONSTEXPR std::size_t mismatch_bitwise(const T *lhs, const T *rhs, std::size_t count) noexcept
 		{
-			initialise();
-			allocate_array(count, std::forward<Args>(args)...);
+			if (lhs == rhs)
+				return count;
+#ifdef DYNARRAY_USING_CPP20
+			if (std::is_constant_evaluated())
+				return static_cast<std::size_t>(std::mismatch(lhs, lhs + count, rhs).first - lhs);
+#endif
+			constexpr std::size_t chunk_size = 256 / sizeof(T) > 0 ? 256 / sizeof(T) : 1;
+			std::size_t position = 0;
+			while (position + chunk_size <= count && std::memcmp(lhs + position, rhs + position, chunk_size * sizeof(T)) == 0)
+				position += chunk_size;
+			while (position < count && lhs[position] == rhs[position])
+				++position;
+			return position;
 		}
 
 		/*!
-		 * @brief Construct by multiple 'count' and use your custom allocator.
-		 *
-		 * @param count The first dimension
-		 * @param other_allocator Your custom allocator
-		 * @param ...args If 'sizeof...(args)' is greater than the level of nested array, the rest of arg(s) will be used for initial array's elements.
+		 * @brief Swap two blocks of trivially copyable elements through a small buffer, chunk by chunk with memcpy.
 		 */
-		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ... Args>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count, _Alloc_t &&other_allocator, Args&& ... args)
+		template<typename T>
+		CPP20_DYNARRAY_CONSTEXPR void swap_bitwise(T *lhs, T *rhs, std::size_t count) noexcept
 		{
-			initialise(other_allocator);
-			allocate_array(count, other_allocator, std::forward<Args>(args)...);
+			if (lhs == rhs)
+				return;
+#ifdef DYNARRAY_USING_CPP20
+			if (std::is_constant_evaluated())
+			{
+				std::swap_ranges(lhs, lhs + count, rhs);
+				return;
+			}
+#endif
+			constexpr std::size_t chunk_size = 256 / sizeof(T) > 0 ? 256 / sizeof(T) : 1;
+			alignas(T) unsigned char buffer[chunk_size * sizeof(T)];
+			for (std::size_t position = 0; position < count; position += chunk_size)
+			{
+				std::size_t bytes = std::min(chunk_size, count - position) * sizeof(T);
+				std::memcpy(buffer, lhs + position, bytes);
+				std::memcpy(lhs + position, rhs + position, bytes);
+				std::memcpy(rhs + position, buffer, bytes);
+			}
 		}
 
 		/*!
-		 * @brief Duplicate an existing dynarray.
-		 *
-		 * @param other Another array to be copied
+		 * @brief Swap two blocks of the same length, the elements are swapped bytewise if they are trivially copyable.
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray(const dynarray &other)
+		template<typename T>
+		CPP20_DYNARRAY_CONSTEXPR void swap_block(T *lhs, T *rhs, std::size_t count) noexcept
 		{
-			initialise();
-			copy_array(other);
+			if constexpr (std::is_trivially_copyable_v<T>)
+				swap_bitwise(lhs, rhs, count);
+			else
+				std::swap_ranges(lhs, lhs + count, rhs);
+		}
+
+		// elements constructed by each task of dynarray(from_generator_t, ...)
+		inline constexpr std::size_t generate_chunk_length = 16384;
+
+		template<typename Generator, typename Indices>
+		struct takes_indices;
+
+		template<typename Generator, std::size_t ... I>
+		struct takes_indices<Generator, std::index_sequence<I...>> : std::is_invocable<Generator &, decltype(I)...> {};
+
+		template<typename Generator, std::size_t ... I>
+		decltype(auto) call_with_indices(Generator &generator, const std::size_t *index, std::index_sequence<I...>)
+		{
+			return generator(index[I]...);
 		}
 
 		/*!
-		 * @brief Initialise with rvalue.
+		 * @brief Constructs the elements [first, last) of a rectangular block in place, with the values returned by generator.
 		 *
-		 * @param other Another array
+		 * The generator is called with one index per dimension if it accepts Rank indices, otherwise with the position in the block.
+		 * The indices of first are decomposed once and then advanced like an odometer.
+		 * If a constructor throws, the elements constructed by this call are destroyed.
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray(dynarray &&other) noexcept
+		template<std::size_t Rank, typename Allocator, typename Generator>
+		void generate_elements(Allocator &allocator, typename std::allocator_traits<Allocator>::value_type *block, const std::size_t *extents,
+		                       std::size_t first, std::size_t last, Generator &generator)
 		{
-			move_array(other);
+			using traits = std::allocator_traits<Allocator>;
+			std::size_t position = first;
+			try
+			{
+				if constexpr (Rank > 1 && takes_indices<Generator, std::make_index_sequence<Rank>>::value)
+				{
+					std::size_t index[Rank] = {};
+					for (std::size_t k = Rank, rest = first; k > 0; --k)
+					{
+						index[k - 1] = rest % extents[k - 1];
+						rest /= extents[k - 1];
+					}
+
+					for (; position < last; ++position)
+					{
+						traits::construct(allocator, block + position, call_with_indices(generator, index, std::make_index_sequence<Rank>{}));
+						for (std::size_t k = Rank; k > 0 && ++index[k - 1] == extents[k - 1]; --k)
+							index[k - 1] = 0;
+					}
+				}
+				else
+				{
+					static_assert(std::is_invocable_v<Generator &, std::size_t>, "generator has to accept one index per dimension, or the position");
+					for (; position < last; ++position)
+						traits::construct(allocator, block + position, generator(position));
+				}
+			}
+			catch (...)
+			{
+				for (; position > first; --position)
+					traits::destroy(allocator, block + position - 1);
+				throw;
+			}
 		}
 
 		/*!
-		 * @brief Duplicate an existing dynarray and use your custom allocator.
+		 * @brief Constructs all count elements of a rectangular block with generate_elements.
 		 *
-		 * @param other Another array to be copied
-		 * @param other_allocator Allocator for the first level
-		 * @param ...args Other dimention's allocator(s)
+		 * A concurrent task runner constructs one chunk of generate_chunk_length elements per task, so generator may be called from several threads.
 		 */
-		template<typename ... Args>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(const dynarray &other, const allocator_type &other_allocator, Args&& ... args)
+		template<std::size_t Rank, typename Allocator, typename Generator, typename TaskRunner>
+		void generate_block(Allocator &allocator, typename std::allocator_traits<Allocator>::value_type *block, const std::size_t *extents, std::size_t count,
+		                    Generator &generator, const TaskRunner &run_tasks)
 		{
-			initialise(other_allocator);
-			copy_array(other, other_allocator, std::forward<Args>(args)...);
+			if constexpr (TaskRunner::concurrent)
+			{
+				std::size_t task_count = (count + generate_chunk_length - 1) / generate_chunk_length;
+				run_tasks(task_count, [&](std::size_t task)
+				{
+					std::size_t first = task * generate_chunk_length;
+					generate_elements<Rank>(allocator, block, extents, first, std::min(count, first + generate_chunk_length), generator);
+				});
+			}
+			else
+			{
+				generate_elements<Rank>(allocator, block, extents, 0, count, generator);
+			}
 		}
 
+		template<typename T>
+		struct is_vla_iterator : std::false_type {};
+
+		template<typename T>
+		struct is_vla_iterator<vla_iterator<T>> : std::true_type {};
+
 		/*!
-		 * @brief Duplicate an existing dynarray by using iterator.
+		 * @brief Whether Iterator refers to contiguous storage of Value, so that a range of it can be read from the address of its first element.
 		 *
-		 * @param other_begin begin(), cbegin() of iterator; or rbegin(), crbegin() of reverse iterator
-		 * @param other_end end(), cend() of iterator; or rend(), crend() of reverse iterator
+		 * Pointers, vla_iterator and iterators of std::vector are recognised before C++20, C++20 also accepts every std::contiguous_iterator (std::span, std::array, etc.)
 		 */
+		template<typename Iterator, typename Value>
+		inline constexpr bool is_contiguous_source_v =
+			std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterator &>())>>, Value> &&
+			(std::is_pointer_v<Iterator> || is_vla_iterator<Iterator>::value ||
+			 std::is_same_v<Iterator, typename std::vector<Value>::iterator> || std::is_same_v<Iterator, typename std::vector<Value>::const_iterator>
+#ifdef DYNARRAY_USING_CPP20
+			 || std::contiguous_iterator<Iterator>
+#endif
+			);
 
-		template<typename InputIterator, typename = decltype(*std::declval<InputIterator&>(), ++std::declval<InputIterator&>(), void())>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(InputIterator other_begin, InputIterator other_end)
-		{
-			initialise();
-			copy_array(other_begin, other_end);
-		}
+		template<typename Allocator, typename = void>
+		struct has_construct : std::false_type {};
+
+		template<typename Allocator>
+		struct has_construct<Allocator, std::void_t<decltype(std::declval<Allocator &>().construct(std::declval<typename std::allocator_traits<Allocator>::value_type *>(),
+		                                                                                           std::declval<const typename std::allocator_traits<Allocator>::value_type &>()))>>
+			: std::true_type {};
+
+		template<typename Allocator>
+		struct is_std_allocator : std::false_type {};
+
+		template<typename U>
+		struct is_std_allocator<std::allocator<U>> : std::true_type {};
 
 		/*!
-		 * @brief Create a one-dimensional array with initializer_list and use your allocator (if any)
-		 *
-		 * @param input_list Your initializer_list
-		 * @param other_allocator Your allocator (if any)
+		 * @brief Whether copies of trivially copyable elements may be made with memcpy, the allocator must not customise construct().
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray(std::initializer_list<T> input_list, const allocator_type &other_allocator = allocator_type())
-		{
-			initialise(other_allocator);
-			allocate_array(input_list);
-		}
+		template<typename Allocator>
+		inline constexpr bool bytewise_constructible_v = std::is_trivially_copyable_v<typename std::allocator_traits<Allocator>::value_type> &&
+			(is_std_allocator<Allocator>::value || !has_construct<Allocator>::value);
 
 		/*!
-		 * @brief Copy an existing dynarray.
-		 *
-		 * If using operator= in nested dynarray, the original structure will not change. Replace original values only.
-		 *
-		 * @param other The right side of '='
-		 * @return A copied dynarray
+		 * @brief Copy-constructs count elements of uninitialised storage from a contiguous source, with a single memcpy when allowed.
+		 * If a copy throws, the elements already constructed are destroyed.
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(const dynarray &other) noexcept
+		template<typename Allocator>
+		CPP20_DYNARRAY_CONSTEXPR void copy_construct_block(Allocator &allocator, typename std::allocator_traits<Allocator>::value_type *destination,
+		                                                   const typename std::allocator_traits<Allocator>::value_type *source, std::size_t count)
 		{
-			loop_copy(other);
-			return *this;
+			if constexpr (bytewise_constructible_v<Allocator>)
+			{
+#ifdef DYNARRAY_USING_CPP20
+				if (!std::is_constant_evaluated())
+#endif
+				{
+					if (count > 0)
+						std::memcpy(destination, source, count * sizeof(*source));
+					return;
+				}
+			}
+			std::size_t constructed = 0;
+			try
+			{
+				for (; constructed < count; ++constructed)
+					std::allocator_traits<Allocator>::construct(allocator, destination + constructed, source[constructed]);
+			}
+			catch (...)
+			{
+				for (; constructed > 0; --constructed)
+					std::allocator_traits<Allocator>::destroy(allocator, destination + constructed - 1);
+				throw;
+			}
 		}
 
 		/*!
-		 * @brief Save an temporary created dynarray.
+		 * @brief Copy-constructs count elements of uninitialised storage from an input range, contiguous sources are handed to copy_construct_block.
+		 * If a copy throws, the elements already constructed are destroyed.
 		 *
-		 * If using operator= in nested dynarray, the original structure will not change. Replace original values only.
-		 *
-		 * @param other The right side of '='
-		 * @return A new dynarray
+		 * @return source advanced past the copied elements
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(dynarray &&other) noexcept
+		template<typename Allocator, typename InputIterator>
+		CPP20_DYNARRAY_CONSTEXPR InputIterator copy_construct_range(Allocator &allocator, typename std::allocator_traits<Allocator>::value_type *destination,
+		                                                            InputIterator source, std::size_t count)
 		{
-			if (entire_array_data == nullptr && this_level_array_head != nullptr)
-				move_values(other);
+			if constexpr (is_contiguous_source_v<InputIterator, typename std::allocator_traits<Allocator>::value_type>)
+			{
+				if (count > 0)
+					copy_construct_block(allocator, destination, std::addressof(*source), count);
+				return std::next(source, static_cast<typename std::iterator_traits<InputIterator>::difference_type>(count));
+			}
 			else
 			{
-				deallocate_array();
-				move_array(other);
+				std::size_t constructed = 0;
+				try
+				{
+					for (; constructed < count; ++constructed, ++source)
+						std::allocator_traits<Allocator>::construct(allocator, destination + constructed, *source);
+				}
+				catch (...)
+				{
+					for (; constructed > 0; --constructed)
+						std::allocator_traits<Allocator>::destroy(allocator, destination + constructed - 1);
+					throw;
+				}
+				return source;
 			}
-			return *this;
 		}
 
 		/*!
-		 * @brief Erase existing data and construct a new dynarray with initializer_list.
-		 *
-		 * @param input_list Your initializer_list
-		 * @return A new dynarray
+		 * @brief Shape of the result of concat or stack.
+		 *
+		 * Every source is viewed as [outer][slab], where outer is the product of the extents in front of axis,
+		 * so the result is made of the slabs of all sources one after another, for each outer index.
+		 *
+		 * @param extents Extents of all sources, rank values for each of them
+		 * @param count Number of sources
+		 * @param rank Number of dimensions of the sources
+		 * @param axis The dimension to join along
+		 * @param stacking true: a new dimension is inserted in front of axis, false: joined along the existing axis
+		 * @param result_extents Receives the extents of the result, rank + 1 values when stacking
+		 * @param slabs Receives the number of elements of each source for every outer index
+		 * @return Number of outer indices
+		 * @exception std::invalid_argument if the shapes of the sources do not match
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(std::initializer_list<T> input_list) noexcept
+		inline std::size_t join_shape(const std::size_t *extents, std::size_t count, std::size_t rank, std::size_t axis, bool stacking,
+		                              std::size_t *result_extents, std::size_t *slabs)
 		{
-			loop_copy(input_list);
-			return *this;
+			std::size_t outer = 1;
+			for (std::size_t k = 0; k < axis; ++k)
+				outer *= extents[k];
+
+			std::size_t joined = 0;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const std::size_t *current = extents + i * rank;
+				std::size_t slab = 1;
+				for (std::size_t k = 0; k < rank; ++k)
+				{
+					if (current[k] != extents[k] && (stacking || k != axis))
+						throw std::invalid_argument("the shapes of the arrays do not match");
+					if (k >= axis)
+						slab *= current[k];
+				}
+				slabs[i] = slab;
+				if (!stacking)
+					joined += current[axis];
+			}
+
+			if (stacking)
+			{
+				std::copy(extents, extents + axis, result_extents);
+				result_extents[axis] = count;
+				std::copy(extents + axis, extents + rank, result_extents + axis + 1);
+			}
+			else
+			{
+				std::copy(extents, extents + rank, result_extents);
+				result_extents[axis] = joined;
+			}
+			return outer;
 		}
 
 		/*!
-		 * @brief Deconstruct.
+		 * @brief Constructs a block from slabs of several sources: for each outer index, slab i of source i is copied in turn.
+		 *
+		 * Each slab is contiguous, it is copied with copy_construct_block (a single memcpy for trivially copyable elements).
 		 *
+		 * @param sources First element of each source
+		 * @param slabs Number of elements copied from each source for every outer index
+		 * @param strides Distance between the slabs of each source
+		 * @param count Number of sources
+		 * @param outer Number of outer indices
 		 */
-		CPP20_DYNARRAY_CONSTEXPR ~dynarray()
+		template<typename Allocator>
+		void interleave_blocks(Allocator &allocator, typename std::allocator_traits<Allocator>::value_type *destination,
+		                       const typename std::allocator_traits<Allocator>::value_type *const *sources,
+		                       const std::size_t *slabs, const std::size_t *strides, std::size_t count, std::size_t outer)
 		{
-			deallocate_array();
+			std::size_t constructed = 0;
+			try
+			{
+				for (std::size_t o = 0; o < outer; ++o)
+				{
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						copy_construct_block(allocator, destination + constructed, sources[i] + o * strides[i], slabs[i]);
+						constructed += slabs[i];
+					}
+				}
+			}
+			catch (...)
+			{
+				for (; constructed > 0; --constructed)
+					std::allocator_traits<Allocator>::destroy(allocator, destination + constructed - 1);
+				throw;
+			}
 		}
 
-		// Element access
+		inline constexpr std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept
+		{
+			return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+		}
 
 		/*!
-		 * @brief Returns a reference to the element at specified location pos, with bounds checking.
+		 * @brief 64-bit hash of a byte block.
 		 *
-		 * If pos is not within the range of the container, an exception of type std::out_of_range is thrown.
+		 * Four independent multiply-rotate lanes consume 32 bytes per iteration, so the main loop is not serialised on a single accumulator.
 		 *
-		 * @param pos Position of the element to return
-		 * @return Reference to the requested element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR reference at(size_type pos);
+		 * @param data First byte of the block
+		 * @param length Length of the block in bytes
+		 * @param seed Initial value
+		 * @return Hash value
+		 */
+		inline std::uint64_t hash_bytes(const void *data, std::size_t length, std::uint64_t seed) noexcept
+		{
+			constexpr std::uint64_t prime_1 = 0x9e3779b185ebca87ull;
+			constexpr std::uint64_t prime_2 = 0xc2b2ae3d27d4eb4full;
+			constexpr std::uint64_t prime_3 = 0x165667b19e3779f9ull;
+			constexpr std::uint64_t prime_4 = 0x85ebca77c2b2ae63ull;
+			constexpr std::uint64_t prime_5 = 0x27d4eb2f165667c5ull;
 
-		/*!
-		 * @brief Returns a const reference to the element at specified location pos, with bounds checking.
-		 *
-		 * If pos is not within the range of the container, an exception of type std::out_of_range is thrown.
-		 *
-		 * @param pos Position of the element to return
-		 * @return Reference to the requested element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reference at(size_type pos) const;
+			auto rotate_left = [](std::uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+			auto mix = [&](std::uint64_t accumulator, std::uint64_t input) { return rotate_left(accumulator + input * prime_2, 31) * prime_1; };
+			auto read_64 = [](const unsigned char *ptr) { std::uint64_t value; std::memcpy(&value, ptr, sizeof value); return value; };
 
-		/*!
-		 * Returns a reference to the element at specified location pos. No bounds checking is performed.
-		 *
-		 * @param pos Position of the element to return
-		 * @return Reference to the requested element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR reference operator[](size_type pos);
+			const unsigned char *current = static_cast<const unsigned char *>(data);
+			const unsigned char *end = current + length;
+			std::uint64_t hash_value;
 
-		/*!
-		 * Returns a const reference to the element at specified location pos. No bounds checking is performed.
-		 *
-		 * @param pos Position of the element to return
-		 * @return Reference to the requested element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reference operator[](size_type pos) const;
+			if (length >= 32)
+			{
+				std::uint64_t lane_1 = seed + prime_1 + prime_2;
+				std::uint64_t lane_2 = seed + prime_2;
+				std::uint64_t lane_3 = seed;
+				std::uint64_t lane_4 = seed - prime_1;
+				for (; end - current >= 32; current += 32)
+				{
+					lane_1 = mix(lane_1, read_64(current));
+					lane_2 = mix(lane_2, read_64(current + 8));
+					lane_3 = mix(lane_3, read_64(current + 16));
+					lane_4 = mix(lane_4, read_64(current + 24));
+				}
+				hash_value = rotate_left(lane_1, 1) + rotate_left(lane_2, 7) + rotate_left(lane_3, 12) + rotate_left(lane_4, 18);
+				for (std::uint64_t lane : { lane_1, lane_2, lane_3, lane_4 })
+					hash_value = (hash_value ^ mix(0, lane)) * prime_1 + prime_4;
+			}
+			else
+				hash_value = seed + prime_5;
+
+			hash_value += length;
+			for (; end - current >= 8; current += 8)
+				hash_value = rotate_left(hash_value ^ mix(0, read_64(current)), 27) * prime_1 + prime_4;
+			for (; current != end; ++current)
+				hash_value = rotate_left(hash_value ^ (*current * prime_5), 11) * prime_1;
+
+			hash_value ^= hash_value >> 33;
+			hash_value *= prime_2;
+			hash_value ^= hash_value >> 29;
+			hash_value *= prime_3;
+			hash_value ^= hash_value >> 32;
+			return hash_value;
+		}
 
 		/*!
-		 * @brief Returns a reference to the first element in the container.
-		 *
-		 * Calling front() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 * @brief Check all indices against limit in one pass, instead of checking on every access.
 		 *
-		 * @return Reference to the first element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR reference front() { return (*this)[0]; }
+		 * Negative indices become huge values after converting to unsigned, so they are rejected as well.
+		 */
+		template<typename Index>
+		CPP20_DYNARRAY_CONSTEXPR void verify_indices(const Index *indices, std::size_t count, std::size_t limit)
+		{
+			static_assert(std::is_integral_v<Index> && !std::is_same_v<Index, bool>, "indices must be integers");
+			using unsigned_index = std::make_unsigned_t<Index>;
+			unsigned_index largest = 0;
+			for (std::size_t i = 0; i < count; ++i)
+				largest = std::max(largest, static_cast<unsigned_index>(indices[i]));
+			if (count > 0 && static_cast<std::size_t>(largest) >= limit)
+				throw std::out_of_range("out of range, incorrect position");
+		}
 
 		/*!
-		 * @brief Returns a const reference to the first element in the container.
-		 *
-		 * Calling front() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 * @brief Check that a region lies inside an array.
 		 *
-		 * @return Const reference to the first element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reference front() const { return (*this)[0]; }
+		 * @param extents Extents of the array
+		 * @param origin First position of the region
+		 * @param region Extents of the region
+		 * @param rank Number of dimensions
+		 */
+		inline CPP20_DYNARRAY_CONSTEXPR void verify_region(const std::size_t *extents, const std::size_t *origin, const std::size_t *region, std::size_t rank)
+		{
+			for (std::size_t i = 0; i < rank; ++i)
+				if (origin[i] > extents[i] || region[i] > extents[i] - origin[i])
+					throw std::out_of_range("out of range, incorrect region");
+		}
 
 		/*!
-		 * @brief Returns a reference to the last element in the container.
+		 * @brief Length of the longest contiguous run inside a region.
 		 *
-		 * Calling back() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 * Trailing dimensions covered completely by the region (in both arrays) are merged into one run.
 		 *
-		 * @return Reference to the last element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR reference back();
+		 * @param run_dimension Receives the first dimension of the run, dimensions before it have to be iterated
+		 * @return Number of elements of one run
+		 */
+		inline CPP20_DYNARRAY_CONSTEXPR std::size_t contiguous_run(const std::size_t *region, const std::size_t *lhs_extents, const std::size_t *rhs_extents,
+		                                                             std::size_t rank, std::size_t &run_dimension)
+		{
+			run_dimension = rank - 1;
+			std::size_t run_length = region[run_dimension];
+			while (run_dimension > 0 && region[run_dimension] == lhs_extents[run_dimension] && region[run_dimension] == rhs_extents[run_dimension])
+			{
+				--run_dimension;
+				run_length *= region[run_dimension];
+			}
+			return run_length;
+		}
 
 		/*!
-		 * @brief Returns a const reference to the first element in the container.
-		 *
-		 * Calling back() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
-		 *
-		 * @return Const reference to the first element
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reference back() const;
+		 * @brief Flat position of the first element of a run.
+		 */
+		template<std::size_t Rank>
+		CPP20_DYNARRAY_CONSTEXPR std::size_t run_offset(std::size_t run, std::size_t run_dimension, const std::size_t *region,
+		                                                const std::size_t *extents, const std::size_t *origin)
+		{
+			std::size_t index[Rank] = {};
+			for (std::size_t i = run_dimension; i-- > 0; )
+			{
+				index[i] = run % region[i];
+				run /= region[i];
+			}
 
-		/*!
-		 * @brief Returns pointer to the innermost underlying array serving as element storage.
-		 *
-		 * For everyone's convenience, calling data() on an empty container will return nullptr.
-		 *
-		 * @return Pointer to the innermost underlying element storage.
-		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
-		 *
-		*/
-		CPP20_DYNARRAY_CONSTEXPR internal_pointer_type data() noexcept { return this_level_array_head; }
+			std::size_t offset = 0;
+			for (std::size_t i = 0; i < Rank; ++i)
+				offset = offset * extents[i] + origin[i] + index[i];
+			return offset;
+		}
 
 		/*!
-		 * @brief Returns const pointer to the innermost underlying array serving as element storage.
-		 *
-		 * For everyone's convenience, calling data() on an empty container will return nullptr.
+		 * @brief Copy a rectangular region between two contiguous row-major blocks, one std::copy per contiguous run.
 		 *
-		 * @return Const pointer to the innermost underlying element storage.
-		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const internal_pointer_type data() const noexcept { return this_level_array_head; }
+		 * The blocks may be the same one; overlapping regions are copied backwards when the destination is behind the source.
+		 */
+		template<std::size_t Rank, typename T>
+		CPP20_DYNARRAY_CONSTEXPR void copy_box(T *destination, const std::size_t *destination_extents, const std::size_t *destination_origin,
+		                                       const T *source, const std::size_t *source_extents, const std::size_t *source_origin,
+		                                       const std::size_t *region)
+		{
+			for (std::size_t i = 0; i < Rank; ++i)
+				if (region[i] == 0) return;
+
+			std::size_t run_dimension = 0;
+			std::size_t run_length = contiguous_run(region, destination_extents, source_extents, Rank, run_dimension);
+			std::size_t run_count = 1;
+			for (std::size_t i = 0; i < run_dimension; ++i)
+				run_count *= region[i];
+
+			auto destination_run = [&](std::size_t run) { return destination + run_offset<Rank>(run, run_dimension, region, destination_extents, destination_origin); };
+			auto source_run = [&](std::size_t run) { return source + run_offset<Rank>(run, run_dimension, region, source_extents, source_origin); };
+
+			if (std::less<const T *>()(source_run(0), destination_run(0)))
+			{
+				for (std::size_t run = run_count; run-- > 0; )
+				{
+					const T *first = source_run(run);
+					std::copy_backward(first, first + run_length, destination_run(run) + run_length);
+				}
+			}
+			else
+			{
+				for (std::size_t run = 0; run < run_count; ++run)
+				{
+					const T *first = source_run(run);
+					std::copy(first, first + run_length, destination_run(run));
+				}
+			}
+		}
 
 		/*!
-		 * @brief Returns pointer to the underlying array serving as element storage.
-		 *
-		 * For everyone's convenience, calling data() on an empty container will return nullptr.
-		 *
-		 * @return Pointer to the underlying element storage.
-		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR pointer get() noexcept { return this_level_array_head; }
+		 * @brief Fill a rectangular region of a contiguous row-major block, one std::fill per contiguous run.
+		 */
+		template<std::size_t Rank, typename T>
+		CPP20_DYNARRAY_CONSTEXPR void fill_box(T *destination, const std::size_t *extents, const std::size_t *origin, const std::size_t *region, const T &value)
+		{
+			for (std::size_t i = 0; i < Rank; ++i)
+				if (region[i] == 0) return;
+
+			std::size_t run_dimension = 0;
+			std::size_t run_length = contiguous_run(region, extents, extents, Rank, run_dimension);
+			std::size_t run_count = 1;
+			for (std::size_t i = 0; i < run_dimension; ++i)
+				run_count *= region[i];
+
+			for (std::size_t run = 0; run < run_count; ++run)
+			{
+				T *first = destination + run_offset<Rank>(run, run_dimension, region, extents, origin);
+				std::fill(first, first + run_length, value);
+			}
+		}
+
+		// signature at the beginning of data written by save_binary
+		inline constexpr char binary_magic[8] = { 'V', 'L', 'A', 'D', 'Y', 'N', 'A', 'R' };
+
+		// bump it whenever the layout changes, readers accept every version up to their own
+		inline constexpr std::uint16_t binary_version = 3;
+
+		// flag of binary_header: offset tables follow the extents
+		inline constexpr std::uint32_t binary_jagged = 1;
+
+		// flag of binary_header: the contiguous block is stored as compressed chunks, see compressed_header
+		inline constexpr std::uint32_t binary_compressed = 2;
+
+		// flag of binary_header: only chunks of the contiguous block follow, see delta_header
+		inline constexpr std::uint32_t binary_delta = 4;
+
+		// every flag this reader understands, data with any other flag is rejected instead of being misread
+		inline constexpr std::uint32_t binary_known_flags = binary_jagged | binary_compressed | binary_delta;
+
+		// the contiguous block starts at a multiple of it (or of alignof(T) if larger), so a page-aligned buffer can be used in place
+		inline constexpr std::uint64_t binary_block_alignment = 64;
 
 		/*!
-		 * @brief Returns const pointer to the underlying array serving as element storage.
-		 *
-		 * For everyone's convenience, calling data() on an empty container will return nullptr.
+		 * @brief Fixed part of the binary format, all fields are stored in the byte order of the writer.
 		 *
-		 * @return Const pointer to the underlying element storage.
-		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const pointer get() const noexcept { return this_level_array_head; }
+		 * It is followed by one 64-bit count for each dimension, the offset tables of a jagged array, padding,
+		 * and then the contiguous block at block_offset.
+		 * Rectangular arrays store their extents as counts. Jagged arrays store the number of nodes (elements on the last dimension)
+		 * of each dimension in total, and an offset table per dimension: table k has one entry more than there are nodes on dimension k,
+		 * the children of node j are [table_k[j], table_k[j + 1]) on the next dimension.
+		 */
+		struct binary_header
+		{
+			char magic[8];
+			std::uint16_t version;
+			std::uint8_t byte_order;	// 1: little-endian, 2: big-endian
+			std::uint8_t type_tag;	// 0: other, 1: signed integer, 2: unsigned integer, 3: floating point, 4: bool
+			std::uint32_t element_size;
+			std::uint32_t element_alignment;
+			std::uint32_t rank;
+			std::uint32_t flags;
+			std::uint32_t reserved;
+			std::uint64_t element_count;
+			std::uint64_t block_offset;
+		};
+
+		static_assert(sizeof(binary_header) == 48, "binary_header must not contain padding");
 
 		/*!
-		 * @brief Checks if the container has no elements.
-		 * @return true if the container is empty, false otherwise
-		*/
-		CPP20_DYNARRAY_CONSTEXPR CPP20_DYNARRAY_NODISCARD bool empty() const noexcept
+		 * @brief Shape read back from the binary format, offset tables are rebuilt from the extents for rectangular arrays.
+		 */
+		struct binary_shape
 		{
-			if (this_level_array_tail == this_level_array_head)
-				return true;
-			return static_cast<bool>(this_level_array_tail - this_level_array_head + 1);
+			binary_header header;
+			std::uint64_t prefix_length;	// bytes in front of the padding
+			std::unique_ptr<std::uint64_t[]> tables;
+			std::unique_ptr<const std::uint64_t*[]> levels;	// table of each dimension, pointing into tables
+		};
+
+		inline std::uint8_t native_byte_order() noexcept
+		{
+			const std::uint16_t probe = 1;
+			unsigned char first_byte = 0;
+			std::memcpy(&first_byte, &probe, 1);
+			return first_byte == 1 ? 1 : 2;
 		}
 
-		/*!
-		 * @brief Returns the number of elements in the container.
-		 * @return The number of elements in the container.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR size_type size() const noexcept
+		template<typename T>
+		constexpr std::uint8_t binary_type_tag() noexcept
 		{
-			if (this_level_array_tail == nullptr && this_level_array_head == nullptr)
+			if constexpr (std::is_same_v<T, bool>)
+				return 4;
+			else if constexpr (std::is_floating_point_v<T>)
+				return 3;
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+				return 1;
+			else if constexpr (std::is_integral_v<T>)
+				return 2;
+			else
 				return 0;
-			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
 		}
 
 		/*!
-		 * @brief Returns the maximum number of elements the container is able to hold due to system or library implementation limitations.
+		 * @brief Number of entries of all offset tables.
 		 *
-		 * This value typically reflects the theoretical limit on the size of the container, at most std::numeric_limits<difference_type>::max().
-		 * At runtime, the size of the container may be limited to a value smaller than max_size() by the amount of RAM available.
-		 *
-		 * @return Maximum number of elements.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR size_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+		 * @param totals Number of nodes of each dimension below the outermost one, and number of elements in the end
+		 * @param rank Number of dimensions
+		 */
+		inline std::uint64_t binary_table_entries(const std::uint64_t *totals, std::size_t rank)
+		{
+			const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(std::uint64_t);
+			std::uint64_t entries = 0;
+			std::uint64_t nodes = 1;
+			for (std::size_t k = 0; k < rank; ++k)
+			{
+				if (nodes >= limit - entries)
+					throw std::length_error("array too long");
+				entries += nodes + 1;
+				nodes = totals[k];
+			}
+			return entries;
+		}
 
-		/*!
-		 * @brief Exchanges the contents of the container with those of other.
-		 *
-		 * Does not invoke any move, copy, or swap operations on individual elements.
-		 *
-		 * All iterators and references remain valid. The past-the-end iterator is invalidated.
-		 *
-		 * @param other dynarray to exchange the contents with
-		*/
-		CPP20_DYNARRAY_CONSTEXPR void swap(dynarray &other) noexcept;
+		inline std::uint64_t binary_block_offset(std::size_t rank, std::uint64_t stored_entries, std::size_t element_alignment) noexcept
+		{
+			std::uint64_t alignment = std::max<std::uint64_t>(binary_block_alignment, element_alignment);
+			std::uint64_t length = sizeof(binary_header) + (rank + stored_entries) * sizeof(std::uint64_t);
+			return (length + alignment - 1) / alignment * alignment;
+		}
 
 		/*!
-		 * @brief Assigns the given value value to all elements in the container.
-		 * @param value The value to assign to the elements
-		*/
-		CPP20_DYNARRAY_CONSTEXPR void fill(const internal_value_type& value);
-
-
-		// Iterators
+		 * @brief Points cursors to the second entry of each offset table, the first entry of every table is 0.
+		 */
+		inline void binary_table_cursors(std::uint64_t *tables, const std::uint64_t *totals, std::size_t rank, std::uint64_t **cursors) noexcept
+		{
+			std::uint64_t nodes = 1;
+			for (std::size_t k = 0; k < rank; ++k)
+			{
+				*tables = 0;
+				cursors[k] = tables + 1;
+				tables += nodes + 1;
+				nodes = totals[k];
+			}
+		}
 
 		/*!
-		 * @brief Returns an iterator to the first element of the vector.
-		 *
-		 * If the vector is empty, the returned iterator will be equal to end().
-		 *
-		 * @return Iterator to the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR iterator begin() noexcept { return iterator(this_level_array_head); }
+		 * @brief Position in the contiguous block where node of dimension (rank - level_count) begins.
+		 */
+		inline std::uint64_t binary_leaf_offset(const std::uint64_t *const *levels, std::size_t level_count, std::uint64_t node) noexcept
+		{
+			for (std::size_t k = 0; k < level_count; ++k)
+				node = levels[k][node];
+			return node;
+		}
 
 		/*!
-		 * @brief Returns an iterator to the first element of the vector.
-		 *
-		 * If the vector is empty, the returned iterator will be equal to end().
-		 *
-		 * @return Iterator to the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator begin() const noexcept { return const_iterator(this_level_array_head); }
+		 * @brief Everything in front of the contiguous block in the binary format, padding included.
+		 */
+		struct binary_prefix
+		{
+			std::unique_ptr<char[]> bytes;
+			std::size_t length;
+		};
 
 		/*!
-		 * @brief Returns an iterator to the first element of the vector.
+		 * @brief Builds header, counts and offset tables of the binary format.
 		 *
-		 * If the vector is empty, the returned iterator will be equal to end().
-		 *
-		 * @return Iterator to the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator cbegin() const noexcept { return begin(); }
+		 * @param tables Offset tables of a jagged array, nullptr if the array is rectangular
+		 */
+		template<typename T>
+		binary_prefix make_binary_prefix(std::size_t rank, const std::uint64_t *counts, const std::uint64_t *tables,
+		                                 std::uint64_t table_entries, std::uint64_t element_count)
+		{
+			binary_header header = {};
+			std::memcpy(header.magic, binary_magic, sizeof header.magic);
+			header.version = binary_version;
+			header.byte_order = native_byte_order();
+			header.type_tag = binary_type_tag<T>();
+			header.element_size = static_cast<std::uint32_t>(sizeof(T));
+			header.element_alignment = static_cast<std::uint32_t>(alignof(T));
+			header.rank = static_cast<std::uint32_t>(rank);
+			header.flags = tables == nullptr ? 0 : binary_jagged;
+			header.element_count = element_count;
+
+			std::uint64_t stored_entries = tables == nullptr ? 0 : table_entries;
+			header.block_offset = binary_block_offset(rank, stored_entries, alignof(T));
+
+			binary_prefix prefix = { std::make_unique<char[]>(static_cast<std::size_t>(header.block_offset)), static_cast<std::size_t>(header.block_offset) };
+			char *cursor = prefix.bytes.get();
+			std::memcpy(cursor, &header, sizeof header);
+			cursor += sizeof header;
+			std::memcpy(cursor, counts, rank * sizeof(std::uint64_t));
+			cursor += rank * sizeof(std::uint64_t);
+			if (stored_entries > 0)
+				std::memcpy(cursor, tables, static_cast<std::size_t>(stored_entries * sizeof(std::uint64_t)));
+			return prefix;
+		}
 
 		/*!
-		 * @brief Returns an iterator to the element following the last element of the vector.
-		 *
-		 * This element acts as a placeholder; attempting to access it results in undefined behavior.
-		 *
-		 * @return Iterator to the element following the last element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR iterator end() noexcept { return iterator(this_level_array_tail + 1); }
+		 * @brief Writes the prefix with one write, and then the contiguous block with another one.
+		 */
+		template<typename T>
+		void write_binary_data(std::ostream &output, const binary_prefix &prefix, const T *block, std::uint64_t element_count)
+		{
+			if (!output.write(prefix.bytes.get(), static_cast<std::streamsize>(prefix.length)) || element_count == 0)
+				return;
+			output.write(reinterpret_cast<const char *>(block), static_cast<std::streamsize>(element_count * sizeof(T)));
+		}
 
 		/*!
-		 * @brief Returns an iterator to the element following the last element of the vector.
-		 *
-		 * This element acts as a placeholder; attempting to access it results in undefined behavior.
+		 * @brief Builds the offset tables of a rectangular array.
 		 *
-		 * @return Iterator to the element following the last element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator end() const noexcept { return const_iterator(this_level_array_tail + 1); }
+		 * @param extents Extents of all dimensions
+		 * @param rank Number of dimensions
+		 * @param shape Receives element count and offset tables
+		 */
+		inline void rectangular_levels(const std::uint64_t *extents, std::size_t rank, binary_shape &shape)
+		{
+			std::unique_ptr<std::uint64_t[]> totals = std::make_unique<std::uint64_t[]>(rank);
+			std::uint64_t nodes = 1;
+			for (std::size_t k = 0; k < rank; ++k)
+			{
+				if (extents[k] != 0 && nodes > std::numeric_limits<std::uint64_t>::max() / extents[k])
+					throw std::length_error("array too long");
+				nodes *= extents[k];
+				totals[k] = nodes;
+			}
 
-		/*!
-		 * @brief Returns an iterator to the element following the last element of the vector.
-		 *
-		 * This element acts as a placeholder; attempting to access it results in undefined behavior.
-		 *
-		 * @return Iterator to the element following the last element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator cend() const noexcept { return end(); }
+			std::uint64_t entries = binary_table_entries(totals.get(), rank);
+			shape.header.element_count = totals[rank - 1];
+			shape.tables = std::make_unique<std::uint64_t[]>(static_cast<std::size_t>(entries));
+			shape.levels = std::make_unique<const std::uint64_t*[]>(rank);
 
-		/*!
-		 * @brief Returns a reverse iterator to the first element of the reversed vector.
-		 *
-		 * It corresponds to the last element of the non-reversed vector. If the vector is empty, the returned iterator is equal to rend().
-		 *
-		 * @return Reverse iterator to the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+			std::uint64_t *table = shape.tables.get();
+			nodes = 1;
+			for (std::size_t k = 0; k < rank; ++k)
+			{
+				for (std::uint64_t j = 0; j <= nodes; ++j)
+					table[j] = j * extents[k];
+				shape.levels[k] = table;
+				table += nodes + 1;
+				nodes = totals[k];
+			}
+		}
 
 		/*!
-		 * @brief Returns a reverse iterator to the first element of the reversed vector.
+		 * @brief Reads and validates everything in front of the padding and the contiguous block.
 		 *
-		 * It corresponds to the last element of the non-reversed vector. If the vector is empty, the returned iterator is equal to rend().
-		 *
-		 * @return Reverse iterator to the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		 * @param read_bytes read_bytes(destination, length) copies the next length bytes, returns false if the source runs out
+		 * @param rank Number of dimensions expected
+		 * @param shape Receives header and offset tables
+		 * @return false if the source runs out
+		 * @exception std::invalid_argument if the data is not valid, or does not match rank and T
+		 */
+		template<typename T, typename ReadBytes>
+		bool read_binary_shape(ReadBytes &&read_bytes, std::size_t rank, binary_shape &shape)
+		{
+			binary_header &header = shape.header;
+			if (!read_bytes(&header, sizeof header))
+				return false;
+
+			if (std::memcmp(header.magic, binary_magic, sizeof header.magic) != 0 || header.version == 0 || header.version > binary_version)
+				throw std::invalid_argument("invalid dynarray binary data");
+			if (header.byte_order != native_byte_order() || header.type_tag != binary_type_tag<T>() ||
+			    header.element_size != sizeof(T) || header.rank != rank)
+				throw std::invalid_argument("binary data does not match dynarray");
+			if ((header.flags & ~binary_known_flags) != 0)
+				throw std::invalid_argument("binary data uses an unsupported extension");
+
+			std::unique_ptr<std::uint64_t[]> counts = std::make_unique<std::uint64_t[]>(rank);
+			if (!read_bytes(counts.get(), rank * sizeof(std::uint64_t)))
+				return false;
+
+			std::uint64_t element_count = header.element_count;
+			if ((header.flags & binary_jagged) == 0)
+			{
+				rectangular_levels(counts.get(), rank, shape);
+				shape.prefix_length = sizeof header + rank * sizeof(std::uint64_t);
+				if (element_count != header.element_count || header.block_offset < shape.prefix_length || header.block_offset % alignof(T) != 0)
+					throw std::invalid_argument("invalid dynarray binary data");
+				return true;
+			}
 
-		/*!
-		 * @brief Returns a reverse iterator to the first element of the reversed vector.
-		 *
-		 * It corresponds to the last element of the non-reversed vector. If the vector is empty, the returned iterator is equal to rend().
-		 *
-		 * @return Reverse iterator to the first element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+			std::uint64_t entries = binary_table_entries(counts.get(), rank);
+			shape.prefix_length = sizeof header + (rank + entries) * sizeof(std::uint64_t);
+			if (element_count != counts[rank - 1] || header.block_offset < shape.prefix_length || header.block_offset % alignof(T) != 0)
+				throw std::invalid_argument("invalid dynarray binary data");
 
-		/*!
-		 * @brief Returns a reverse iterator to the element following the last element of the reversed vector.
-		 *
-		 * It corresponds to the element preceding the first element of the non-reversed vector.
-		 * This element acts as a placeholder, attempting to access it results in undefined behavior.
-		 *
-		 * @return Reverse iterator to the element following the last element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+			shape.tables = std::make_unique<std::uint64_t[]>(static_cast<std::size_t>(entries));
+			shape.levels = std::make_unique<const std::uint64_t*[]>(rank);
+			if (!read_bytes(shape.tables.get(), static_cast<std::size_t>(entries * sizeof(std::uint64_t))))
+				return false;
 
-		/*!
-		 * @brief Returns a reverse iterator to the element following the last element of the reversed vector.
-		 *
-		 * It corresponds to the element preceding the first element of the non-reversed vector.
-		 * This element acts as a placeholder, attempting to access it results in undefined behavior.
-		 *
-		 * @return Reverse iterator to the element following the last element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const std::uint64_t *table = shape.tables.get();
+			std::uint64_t nodes = 1;
+			for (std::size_t k = 0; k < rank; ++k)
+			{
+				if (table[0] != 0 || table[nodes] != counts[k] || !std::is_sorted(table, table + nodes + 1))
+					throw std::invalid_argument("invalid dynarray binary data");
+
+				shape.levels[k] = table;
+				table += nodes + 1;
+				nodes = counts[k];
+			}
+			return true;
+		}
 
 		/*!
-		 * @brief Returns a reverse iterator to the element following the last element of the reversed vector.
-		 *
-		 * It corresponds to the element preceding the first element of the non-reversed vector.
-		 * This element acts as a placeholder, attempting to access it results in undefined behavior.
-		 *
-		 * @return Reverse iterator to the element following the last element.
-		*/
-		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+		 * @brief Source of read_binary_shape and read_npy_shape reading from a stream.
+		 */
+		struct stream_reader
+		{
+			std::istream &input;
 
-	private:
+			bool operator()(void *destination, std::size_t length) const
+			{
+				return static_cast<bool>(input.read(static_cast<char *>(destination), static_cast<std::streamsize>(length)));
+			}
+		};
 
-		internal_pointer_type entire_array_data;	// always nullptr in nested-dynarray
+		/*!
+		 * @brief Source of read_binary_shape and read_npy_shape reading from memory.
+		 */
+		struct buffer_reader
+		{
+			const char *source;
+			std::size_t length;
+			std::size_t position;
 
-		internal_pointer_type this_level_array_head;
-		internal_pointer_type this_level_array_tail;
+			bool operator()(void *destination, std::size_t count)
+			{
+				if (count > length - position)
+					return false;
+				std::memcpy(destination, source + position, count);
+				position += count;
+				return true;
+			}
+		};
 
-		contiguous_allocator_type contiguous_allocator;
+		/*!
+		 * @brief Locates the contiguous block inside a buffer.
+		 *
+		 * @exception std::invalid_argument if the buffer is too short, or the block is not aligned for T
+		 */
+		template<typename T>
+		T* block_in_buffer(void *buffer, std::size_t length, std::uint64_t offset, std::uint64_t count)
+		{
+			if (offset > length || count > (length - offset) / sizeof(T))
+				throw std::invalid_argument("binary data is too short");
 
+			char *block = static_cast<char *>(buffer) + offset;
+			if (reinterpret_cast<std::uintptr_t>(block) % alignof(T) != 0)
+				throw std::invalid_argument("binary data is not suitably aligned");
+			return reinterpret_cast<T *>(block);
+		}
 
-		CPP20_DYNARRAY_CONSTEXPR void initialise(const allocator_type &other_allocator = allocator_type());
+		// magic string at the beginning of NumPy .npy files
+		inline constexpr char npy_magic[6] = { '\x93', 'N', 'U', 'M', 'P', 'Y' };
 
-		CPP20_DYNARRAY_CONSTEXPR void reset();
+		// NumPy pads its header so that the data starts at a multiple of it
+		inline constexpr std::size_t npy_alignment = 64;
 
-		CPP20_DYNARRAY_CONSTEXPR size_type get_block_size() const
+		/*!
+		 * @brief NumPy dtype of T, such as "<f8".
+		 */
+		template<typename T>
+		std::string npy_descr()
 		{
-			if (this_level_array_tail == this_level_array_head)
-				return true;
-			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+			static_assert(std::is_arithmetic_v<T>, "NumPy format supports arithmetic element types only");
+
+			char kind = std::is_same_v<T, bool> ? 'b' : std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i' : 'u';
+			char byte_order = sizeof(T) == 1 ? '|' : native_byte_order() == 1 ? '<' : '>';
+			return std::string{ byte_order, kind } + std::to_string(sizeof(T));
 		}
 
-		template<typename Ty>
-		static CPP20_DYNARRAY_CONSTEXPR size_type expand_list(std::initializer_list<Ty> init);
+		/*!
+		 * @brief Preamble and header of a .npy file, padded to npy_alignment.
+		 */
+		inline std::string npy_header(const std::string &descr, const std::uint64_t *extents, std::size_t rank)
+		{
+			std::string dictionary = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (";
+			for (std::size_t k = 0; k < rank; ++k)
+				dictionary += (k == 0 ? "" : ", ") + std::to_string(extents[k]);
+			dictionary += rank == 1 ? ",), }" : "), }";
+
+			std::size_t preamble_length = dictionary.size() + 1 + npy_alignment > 65535 ? 12 : 10;
+			std::size_t total_length = (preamble_length + dictionary.size() + 1 + npy_alignment - 1) / npy_alignment * npy_alignment;
+			std::size_t header_length = total_length - preamble_length;
+			dictionary.append(header_length - dictionary.size() - 1, ' ');
+			dictionary += '\n';
+
+			std::string preamble(npy_magic, sizeof npy_magic);
+			preamble += static_cast<char>(preamble_length == 10 ? 1 : 2);
+			preamble += '\0';
+			for (std::size_t i = 0; i < preamble_length - 8; ++i)
+				preamble += static_cast<char>((header_length >> (i * 8)) & 0xff);
+			return preamble + dictionary;
+		}
 
-		template<typename ... Args>
-		static CPP20_DYNARRAY_CONSTEXPR size_type expand_counts(size_type count, Args&& ... args);
+		/*!
+		 * @brief Position of the value of key in a NumPy header, std::string::npos if not found.
+		 */
+		inline std::size_t npy_find_value(const std::string &header, const char *key)
+		{
+			std::size_t position = header.find(std::string("'") + key + "'");
+			if (position == std::string::npos)
+				position = header.find(std::string("\"") + key + "\"");
+			if (position == std::string::npos || (position = header.find(':', position)) == std::string::npos)
+				return std::string::npos;
+			return header.find_first_not_of(' ', position + 1);
+		}
 
-		template<typename ... Args>
-		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocator(const allocator_type &_allocator, Args&& ... args);
+		/*!
+		 * @brief Reads the preamble and header of a .npy file.
+		 *
+		 * @param read_bytes read_bytes(destination, length) copies the next length bytes, returns false if the source runs out
+		 * @param rank Number of dimensions expected
+		 * @param shape Receives element count, offset tables and the position of the data
+		 * @return false if the source runs out
+		 * @exception std::invalid_argument if the data is not valid, is in Fortran order, or does not match rank and T
+		 */
+		template<typename T, typename ReadBytes>
+		bool read_npy_shape(ReadBytes &&read_bytes, std::size_t rank, binary_shape &shape)
+		{
+			unsigned char preamble[12] = {};
+			if (!read_bytes(preamble, 8))
+				return false;
+			if (std::memcmp(preamble, npy_magic, sizeof npy_magic) != 0 || preamble[6] == 0 || preamble[6] > 3)
+				throw std::invalid_argument("invalid NumPy data");
+
+			std::size_t preamble_length = preamble[6] == 1 ? 10 : 12;
+			if (!read_bytes(preamble + 8, preamble_length - 8))
+				return false;
+
+			std::size_t header_length = 0;
+			for (std::size_t i = preamble_length; i != 8; --i)
+				header_length = header_length << 8 | preamble[i - 1];
+
+			std::string header(header_length, ' ');
+			if (header_length > 0 && !read_bytes(&header[0], header_length))
+				return false;
+
+			std::size_t descr_position = npy_find_value(header, "descr");
+			std::size_t order_position = npy_find_value(header, "fortran_order");
+			std::size_t shape_position = npy_find_value(header, "shape");
+			if (descr_position == std::string::npos || order_position == std::string::npos || shape_position == std::string::npos ||
+			    (header[descr_position] != '\'' && header[descr_position] != '"') || header[shape_position] != '(')
+				throw std::invalid_argument("invalid NumPy data");
+
+			std::size_t descr_end = header.find(header[descr_position], descr_position + 1);
+			if (descr_end == std::string::npos)
+				throw std::invalid_argument("invalid NumPy data");
+			std::string descr = header.substr(descr_position + 1, descr_end - descr_position - 1);
+			std::string expected = npy_descr<T>();
+			if (descr != expected && !(descr.size() == expected.size() && descr.compare(1, std::string::npos, expected, 1) == 0 &&
+			                           (descr[0] == '=' || sizeof(T) == 1)))
+				throw std::invalid_argument("binary data does not match dynarray");
+
+			if (header.compare(order_position, 4, "True") == 0)
+				throw std::invalid_argument("NumPy data in Fortran order is not supported");
+			if (header.compare(order_position, 5, "False") != 0)
+				throw std::invalid_argument("invalid NumPy data");
+
+			std::unique_ptr<std::uint64_t[]> extents = std::make_unique<std::uint64_t[]>(rank);
+			std::size_t found_rank = 0;
+			std::size_t position = shape_position + 1;
+			while (true)
+			{
+				position = header.find_first_not_of(" ,", position);
+				if (position == std::string::npos)
+					throw std::invalid_argument("invalid NumPy data");
+				if (header[position] == ')')
+					break;
+				if (header[position] < '0' || header[position] > '9')
+					throw std::invalid_argument("invalid NumPy data");
+
+				std::uint64_t extent = 0;
+				for (; position < header.size() && header[position] >= '0' && header[position] <= '9'; ++position)
+				{
+					std::uint64_t digit = static_cast<std::uint64_t>(header[position] - '0');
+					if (extent > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+						throw std::length_error("array too long");
+					extent = extent * 10 + digit;
+				}
+				if (found_rank < rank)
+					extents[found_rank] = extent;
+				++found_rank;
+			}
+			if (found_rank != rank)
+				throw std::invalid_argument("binary data does not match dynarray");
+
+			rectangular_levels(extents.get(), rank, shape);
+			shape.prefix_length = shape.header.block_offset = preamble_length + header_length;
+			if (shape.header.block_offset % alignof(T) != 0)
+				throw std::invalid_argument("binary data is not suitably aligned");
+			return true;
+		}
 
-		template<typename Skip, typename ... Args>
-		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocators(const Skip &ignore, const allocator_type &_allocator, Args&& ... args);
+		/*!
+		 * @brief Writes the .npy header with one write, and then the contiguous block with another one.
+		 */
+		template<typename T>
+		void write_npy_data(std::ostream &output, const std::string &header, const T *block, std::uint64_t element_count)
+		{
+			if (!output.write(header.data(), static_cast<std::streamsize>(header.size())) || element_count == 0)
+				return;
+			output.write(reinterpret_cast<const char *>(block), static_cast<std::streamsize>(element_count * sizeof(T)));
+		}
 
-		CPP20_DYNARRAY_CONSTEXPR void verify_size(size_type count);
+		/*!
+		 * @brief Format used by save_binary, load_binary, view_binary and adopt_binary.
+		 */
+		struct binary_format
+		{
+			template<typename T, typename ReadBytes>
+			static bool read_shape(ReadBytes &&read_bytes, std::size_t rank, binary_shape &shape)
+			{
+				if (!read_binary_shape<T>(read_bytes, rank, shape))
+					return false;
+				if ((shape.header.flags & binary_compressed) != 0)
+					throw std::invalid_argument("binary data is compressed");
+				if ((shape.header.flags & binary_delta) != 0)
+					throw std::invalid_argument("binary data is a delta");
+				return true;
+			}
+		};
 
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count);
+		/*!
+		 * @brief Format used by save_npy, load_npy, view_npy and adopt_npy.
+		 */
+		struct npy_format
+		{
+			template<typename T, typename ReadBytes>
+			static bool read_shape(ReadBytes &&read_bytes, std::size_t rank, binary_shape &shape) { return read_npy_shape<T>(read_bytes, rank, shape); }
+		};
 
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count);
+		/*!
+		 * @brief Format used by save_compressed and load_compressed, the same header as binary_format.
+		 */
+		struct compressed_format
+		{
+			template<typename T, typename ReadBytes>
+			static bool read_shape(ReadBytes &&read_bytes, std::size_t rank, binary_shape &shape)
+			{
+				if (!read_binary_shape<T>(read_bytes, rank, shape))
+					return false;
+				if ((shape.header.flags & binary_compressed) == 0 || (shape.header.flags & binary_delta) != 0)
+					throw std::invalid_argument("binary data is not compressed");
+				return true;
+			}
+		};
 
-		template<typename ...Args>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count, Args&& ... args);
+		/*!
+		 * @brief Reads the contiguous block of binary_format and npy_format with a single read.
+		 */
+		struct read_raw_block
+		{
+			template<typename T>
+			bool operator()(std::istream &input, T *block, std::size_t count) const
+			{
+				return static_cast<bool>(input.read(reinterpret_cast<char *>(block), static_cast<std::streamsize>(count * sizeof(T))));
+			}
+		};
 
-		template<typename ...Args>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count, Args&& ... args);
+		// uncompressed bytes of a chunk of save_compressed, rounded down to whole elements
+		inline constexpr std::size_t compressed_chunk_length = 1 << 20;
 
-		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ...Args>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count, _Alloc_t &&other_allocator, Args&& ... args);
+		// chunks held in memory at once, compressed or decompressed as one group of tasks
+		inline constexpr std::size_t compressed_group_size = 32;
 
-		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ...Args>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count, _Alloc_t &&other_allocator, Args&& ... args);
+		// filter of compressed_header: bytes of the elements are grouped by their position in the element before compression
+		inline constexpr std::uint32_t compressed_byte_shuffle = 1;
 
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<T> input_list);
+		/*!
+		 * @brief Follows the padding of the binary format when binary_compressed is set, stored in the byte order of the writer.
+		 *
+		 * It is followed by chunk_count chunks, each of them is a 64-bit stored length and the stored bytes.
+		 * A chunk holds chunk_length bytes of the contiguous block (the last one may hold less) after the filter is applied,
+		 * compressed by lz_compress, or as they are if the stored length equals the uncompressed length.
+		 * Every chunk can be decompressed independently.
+		 */
+		struct compressed_header
+		{
+			std::uint64_t chunk_length;
+			std::uint64_t chunk_count;
+			std::uint32_t filter;
+			std::uint32_t reserved;
+		};
 
-		template<typename Ty, typename ... Args>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list,
-			const allocator_type &other_allocator = allocator_type(), Args&& ...args);
+		static_assert(sizeof(compressed_header) == 24, "compressed_header must not contain padding");
 
-		CPP20_DYNARRAY_CONSTEXPR void deallocate_array();
+		/*!
+		 * @brief Gathers byte k of every element into plane k, floating point exponents and high bytes of integers end up in long runs.
+		 *
+		 * Size is a constant, so the inner loop is unrolled and the planes are written with vector stores where the compiler can.
+		 */
+		template<std::size_t Size>
+		void shuffle_bytes(const unsigned char *source, std::size_t count, unsigned char *destination) noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				for (std::size_t k = 0; k < Size; ++k)
+					destination[k * count + i] = source[i * Size + k];
+		}
 
-		CPP20_DYNARRAY_CONSTEXPR void copy_array(const dynarray &other);
+		template<std::size_t Size>
+		void unshuffle_bytes(const unsigned char *source, std::size_t count, unsigned char *destination) noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				for (std::size_t k = 0; k < Size; ++k)
+					destination[i * Size + k] = source[k * count + i];
+		}
 
-		template<typename ...Args>
-		CPP20_DYNARRAY_CONSTEXPR void copy_array(const dynarray &other, const allocator_type &other_allocator, Args&& ... args);
+		inline std::uint32_t load_32(const unsigned char *bytes) noexcept
+		{
+			std::uint32_t value = 0;
+			std::memcpy(&value, bytes, sizeof value);
+			return value;
+		}
 
-		CPP20_DYNARRAY_CONSTEXPR void copy_array(internal_pointer_type starting_address, const dynarray &other);
+		/*!
+		 * @brief Stores a length of a sequence: the nibble of the token holds up to 15, the rest follows as bytes of 255 and a last byte below 255.
+		 */
+		inline bool put_lz_length(std::size_t length, unsigned char *destination, std::size_t capacity, std::size_t &position) noexcept
+		{
+			for (; length >= 255; length -= 255)
+			{
+				if (position == capacity)
+					return false;
+				destination[position++] = 255;
+			}
+			if (position == capacity)
+				return false;
+			destination[position++] = static_cast<unsigned char>(length);
+			return true;
+		}
 
-		template<typename ...Args>
-		CPP20_DYNARRAY_CONSTEXPR void copy_array(internal_pointer_type starting_address, const dynarray &other,
-			const allocator_type &other_allocator, Args&& ... args);
+		inline bool get_lz_length(const unsigned char *source, std::size_t length, std::size_t &position, std::size_t &value) noexcept
+		{
+			for (unsigned char byte = 255; byte == 255; value += byte)
+			{
+				if (position == length)
+					return false;
+				byte = source[position++];
+			}
+			return true;
+		}
 
-		template<typename InputIterator>
-		CPP20_DYNARRAY_CONSTEXPR void copy_array(InputIterator other_begin, InputIterator other_end);
+		/*!
+		 * @brief Writes literals and then a match (omitted if match_length is 0) as one sequence.
+		 *
+		 * A sequence is a token (literal count in the high nibble, match length minus 4 in the low nibble), extra literal count,
+		 * literals, 16-bit little-endian offset of the match and extra match length.
+		 */
+		inline bool put_lz_sequence(const unsigned char *literals, std::size_t literal_count, std::size_t offset, std::size_t match_length,
+		                            unsigned char *destination, std::size_t capacity, std::size_t &position) noexcept
+		{
+			std::size_t match_code = match_length == 0 ? 0 : match_length - 4;
+			if (position == capacity)
+				return false;
+			destination[position++] = static_cast<unsigned char>(std::min<std::size_t>(literal_count, 15) << 4 | std::min<std::size_t>(match_code, 15));
+			if (literal_count >= 15 && !put_lz_length(literal_count - 15, destination, capacity, position))
+				return false;
+			if (literal_count > capacity - position)
+				return false;
+			std::memcpy(destination + position, literals, literal_count);
+			position += literal_count;
+			if (match_length == 0)
+				return true;
 
-		CPP20_DYNARRAY_CONSTEXPR void loop_copy(const dynarray &other) noexcept;
+			if (capacity - position < 2)
+				return false;
+			destination[position++] = static_cast<unsigned char>(offset & 0xff);
+			destination[position++] = static_cast<unsigned char>(offset >> 8);
+			return match_code < 15 || put_lz_length(match_code - 15, destination, capacity, position);
+		}
 
-		CPP20_DYNARRAY_CONSTEXPR void loop_copy(std::initializer_list<T> input_list) noexcept;
-
-		CPP20_DYNARRAY_CONSTEXPR void move_array(dynarray &other) noexcept;
-
-		CPP20_DYNARRAY_CONSTEXPR void move_values(dynarray &other) noexcept;
+		/*!
+		 * @brief Greedy LZ77 with a hash table of 4-byte sequences and 64 KiB window, a single pass over source.
+		 *
+		 * Positions are skipped faster while no match is found, so data which does not compress costs little time.
+		 *
+		 * @return Length of compressed data, 0 if it does not fit in capacity
+		 */
+		inline std::size_t lz_compress(const unsigned char *source, std::size_t length, unsigned char *destination, std::size_t capacity) noexcept
+		{
+			constexpr std::size_t hash_bits = 12;
+			constexpr std::size_t window = 65535;
+			std::uint32_t table[std::size_t(1) << hash_bits] = {};
+			std::size_t position = 0;
+			std::size_t anchor = 0;
+			std::size_t i = 0;
+			while (length >= 4 && i <= length - 4)
+			{
+				std::uint32_t sequence = load_32(source + i);
+				std::size_t hash = static_cast<std::uint32_t>(sequence * 2654435761u) >> (32 - hash_bits);
+				std::size_t candidate = table[hash];
+				table[hash] = static_cast<std::uint32_t>(i);
+				if (candidate >= i || i - candidate > window || load_32(source + candidate) != sequence)
+				{
+					i += 1 + ((i - anchor) >> 6);
+					continue;
+				}
 
-		CPP20_DYNARRAY_CONSTEXPR void swap_all(dynarray &other) noexcept;
+				std::size_t match_length = 4;
+				while (i + match_length < length && source[candidate + match_length] == source[i + match_length])
+					++match_length;
+				if (!put_lz_sequence(source + anchor, i - anchor, i - candidate, match_length, destination, capacity, position))
+					return 0;
+				i += match_length;
+				anchor = i;
+			}
 
-		CPP20_DYNARRAY_CONSTEXPR void swap_outside(dynarray &other) noexcept;
+			if (!put_lz_sequence(source + anchor, length - anchor, 0, 0, destination, capacity, position))
+				return 0;
+			return position;
+		}
 
+		/*!
+		 * @brief Decompresses data written by lz_compress, every length and offset is checked against both buffers.
+		 *
+		 * @return false if source is broken, or does not decompress to exactly capacity bytes
+		 */
+		inline bool lz_decompress(const unsigned char *source, std::size_t length, unsigned char *destination, std::size_t capacity) noexcept
+		{
+			std::size_t in = 0;
+			std::size_t out = 0;
+			while (in < length)
+			{
+				unsigned char token = source[in++];
+				std::size_t literal_count = token >> 4;
+				if (literal_count == 15 && !get_lz_length(source, length, in, literal_count))
+					return false;
+				if (literal_count > length - in || literal_count > capacity - out)
+					return false;
+				std::memcpy(destination + out, source + in, literal_count);
+				in += literal_count;
+				out += literal_count;
+				if (in == length)
+					break;
+
+				if (length - in < 2)
+					return false;
+				std::size_t offset = source[in] | std::size_t(source[in + 1]) << 8;
+				in += 2;
+				std::size_t match_length = token & 15;
+				if (match_length == 15 && !get_lz_length(source, length, in, match_length))
+					return false;
+				match_length += 4;
+				if (offset == 0 || offset > out || match_length > capacity - out)
+					return false;
+
+				unsigned char *match = destination + out - offset;
+				if (offset >= match_length)
+					std::memcpy(destination + out, match, match_length);
+				else
+				{
+					for (std::size_t j = 0; j < match_length; ++j)
+						destination[out + j] = match[j];
+				}
+				out += match_length;
+			}
+			return out == capacity;
+		}
 
-		/**** Non-member functions  ***/
+		/*!
+		 * @brief A chunk of the contiguous block on its way to or from the stream.
+		 */
+		struct compressed_chunk
+		{
+			std::unique_ptr<unsigned char[]> stored;	// bytes as in the stream
+			std::unique_ptr<unsigned char[]> filtered;	// bytes before compression, used only if the filter is applied
+			std::size_t stored_length;
+			std::size_t length;	// uncompressed
+			bool valid;
+		};
 
 		/*!
-		 * @brief Exchanges the contents of the container with those of other.
-		 *
-		 * If both of the containers are outter-most layer, they will be swapped completely, including sizes.
+		 * @brief Writes the prefix of the binary format with binary_compressed set, and then the contiguous block in compressed chunks.
 		 *
-		 * Otherwise swap the contents only.
-		 *
-		 * @param lhs A dynarray
-		 * @param rhs Another dynarray
-		 * @return
-		*/
-		friend CPP20_DYNARRAY_CONSTEXPR void swap(dynarray &lhs, dynarray &rhs) noexcept { lhs.swap_outside(rhs); }
+		 * Each group of chunks is shuffled and compressed with run_tasks, one chunk per task, and then written in order.
+		 */
+		template<typename T, typename TaskRunner>
+		void write_compressed_data(const TaskRunner &run_tasks, std::ostream &output, binary_prefix prefix, const T *block, std::uint64_t element_count)
+		{
+			binary_header header = {};
+			std::memcpy(&header, prefix.bytes.get(), sizeof header);
+			header.flags |= binary_compressed;
+			std::memcpy(prefix.bytes.get(), &header, sizeof header);
+
+			compressed_header chunks = {};
+			chunks.chunk_length = std::max<std::size_t>(1, compressed_chunk_length / sizeof(T)) * sizeof(T);
+			chunks.filter = sizeof(T) > 1 ? compressed_byte_shuffle : 0;
+			std::uint64_t total_length = element_count * sizeof(T);
+			chunks.chunk_count = (total_length + chunks.chunk_length - 1) / chunks.chunk_length;
+			if (!output.write(prefix.bytes.get(), static_cast<std::streamsize>(prefix.length)) ||
+				!output.write(reinterpret_cast<const char *>(&chunks), sizeof chunks))
+				return;
+
+			const unsigned char *bytes = reinterpret_cast<const unsigned char *>(block);
+			std::unique_ptr<compressed_chunk[]> group = std::make_unique<compressed_chunk[]>(compressed_group_size);
+			for (std::uint64_t first = 0; first < chunks.chunk_count; first += compressed_group_size)
+			{
+				std::size_t group_count = static_cast<std::size_t>(std::min<std::uint64_t>(compressed_group_size, chunks.chunk_count - first));
+				for (std::size_t i = 0; i < group_count; ++i)
+				{
+					compressed_chunk &chunk = group[i];
+					chunk.length = static_cast<std::size_t>(std::min<std::uint64_t>(chunks.chunk_length, total_length - (first + i) * chunks.chunk_length));
+					if (chunk.stored == nullptr)
+						chunk.stored.reset(new unsigned char[static_cast<std::size_t>(chunks.chunk_length)]);
+					if (chunks.filter != 0 && chunk.filtered == nullptr)
+						chunk.filtered.reset(new unsigned char[static_cast<std::size_t>(chunks.chunk_length)]);
+				}
+
+				run_tasks(group_count, [&](std::size_t i)
+				{
+					compressed_chunk &chunk = group[i];
+					const unsigned char *source = bytes + (first + i) * chunks.chunk_length;
+					if (chunks.filter != 0)
+					{
+						shuffle_bytes<sizeof(T)>(source, chunk.length / sizeof(T), chunk.filtered.get());
+						source = chunk.filtered.get();
+					}
+					chunk.stored_length = lz_compress(source, chunk.length, chunk.stored.get(), chunk.length - 1);
+					if (chunk.stored_length == 0)
+					{
+						std::memcpy(chunk.stored.get(), source, chunk.length);
+						chunk.stored_length = chunk.length;
+					}
+				});
+
+				for (std::size_t i = 0; i < group_count; ++i)
+				{
+					std::uint64_t stored_length = group[i].stored_length;
+					if (!output.write(reinterpret_cast<const char *>(&stored_length), sizeof stored_length) ||
+						!output.write(reinterpret_cast<const char *>(group[i].stored.get()), static_cast<std::streamsize>(stored_length)))
+						return;
+				}
+			}
+		}
 
 		/*!
-		 * @brief Replaces old_array with new_array and returns the old value of old_array.
+		 * @brief Reads the compressed chunks of a contiguous block of element_count elements.
 		 *
-		 * If old_array is an inner layer, exchange() will replaces the contents of the container only, the size of old_array will keeps unchanged.
+		 * Each group of chunks is read in order, and then decompressed and unshuffled with run_tasks straight into block.
 		 *
-		 * @param old_array Old array to be replaced
-		 * @param new_array New array replace with
-		 * @return The value of old_array
-		*/
-		friend CPP20_DYNARRAY_CONSTEXPR dynarray exchange(dynarray &old_array, dynarray &&new_array) noexcept
+		 * @return false if input runs out
+		 * @exception std::invalid_argument if the data is broken
+		 */
+		template<typename T, typename TaskRunner>
+		bool read_compressed_block(const TaskRunner &run_tasks, std::istream &input, T *block, std::uint64_t element_count)
 		{
-			dynarray current_array = std::move(old_array);
-			if (old_array.entire_array_data == nullptr)
+			compressed_header chunks = {};
+			if (!input.read(reinterpret_cast<char *>(&chunks), sizeof chunks))
+				return false;
+
+			std::uint64_t total_length = element_count * sizeof(T);
+			if (chunks.chunk_length == 0 || chunks.chunk_length % sizeof(T) != 0 || chunks.chunk_length > std::max(compressed_chunk_length, sizeof(T)) ||
+				chunks.chunk_count != (total_length + chunks.chunk_length - 1) / chunks.chunk_length ||
+				(chunks.filter != 0 && (chunks.filter != compressed_byte_shuffle || sizeof(T) == 1)))
+				throw std::invalid_argument("invalid dynarray compressed data");
+
+			unsigned char *bytes = reinterpret_cast<unsigned char *>(block);
+			std::unique_ptr<compressed_chunk[]> group = std::make_unique<compressed_chunk[]>(compressed_group_size);
+			for (std::uint64_t first = 0; first < chunks.chunk_count; first += compressed_group_size)
 			{
-				old_array.swap(new_array);
-			}
-			else
-			{
-				if (new_array.entire_array_data == nullptr)
+				std::size_t group_count = static_cast<std::size_t>(std::min<std::uint64_t>(compressed_group_size, chunks.chunk_count - first));
+				for (std::size_t i = 0; i < group_count; ++i)
 				{
-					dynarray temp_array = std::move(new_array);
-					old_array.swap_all(temp_array);
+					compressed_chunk &chunk = group[i];
+					chunk.length = static_cast<std::size_t>(std::min<std::uint64_t>(chunks.chunk_length, total_length - (first + i) * chunks.chunk_length));
+					std::uint64_t stored_length = 0;
+					if (!input.read(reinterpret_cast<char *>(&stored_length), sizeof stored_length))
+						return false;
+					if (stored_length > chunk.length)
+						throw std::invalid_argument("invalid dynarray compressed data");
+
+					chunk.stored_length = static_cast<std::size_t>(stored_length);
+					if (chunk.stored == nullptr)
+						chunk.stored.reset(new unsigned char[static_cast<std::size_t>(chunks.chunk_length)]);
+					if (chunks.filter != 0 && chunk.filtered == nullptr)
+						chunk.filtered.reset(new unsigned char[static_cast<std::size_t>(chunks.chunk_length)]);
+					if (!input.read(reinterpret_cast<char *>(chunk.stored.get()), static_cast<std::streamsize>(chunk.stored_length)))
+						return false;
 				}
-				else
+
+				run_tasks(group_count, [&](std::size_t i)
 				{
-					old_array.swap_all(new_array);
-				}
+					compressed_chunk &chunk = group[i];
+					unsigned char *destination = bytes + (first + i) * chunks.chunk_length;
+					unsigned char *filtered = chunks.filter != 0 ? chunk.filtered.get() : destination;
+					const unsigned char *source = chunk.stored.get();
+					chunk.valid = true;
+					if (chunk.stored_length < chunk.length)
+					{
+						chunk.valid = lz_decompress(source, chunk.stored_length, filtered, chunk.length);
+						source = filtered;
+					}
+					if (chunks.filter != 0)
+						unshuffle_bytes<sizeof(T)>(source, chunk.length / sizeof(T), destination);
+					else if (source != destination)
+						std::memcpy(destination, source, chunk.length);
+				});
+
+				for (std::size_t i = 0; i < group_count; ++i)
+					if (!group[i].valid)
+						throw std::invalid_argument("invalid dynarray compressed data");
 			}
-			return current_array;
+			return true;
 		}
 
-		friend CPP20_DYNARRAY_CONSTEXPR bool operator==(const dynarray &lhs, const dynarray &rhs)
+		// bytes covered by each bit of dirty_regions created by track_dirty() by default
+		inline constexpr std::size_t dirty_chunk_length = 1 << 16;
+
+		/*!
+		 * @brief Follows the padding of the binary format when binary_delta is set, stored in the byte order of the writer.
+		 *
+		 * It is followed by run_count runs, each of them is a 64-bit first chunk, a 64-bit chunk count,
+		 * and then the elements of these chunks (the last chunk of the block may be shorter).
+		 */
+		struct delta_header
 		{
-			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-		}
+			std::uint64_t chunk_elements;
+			std::uint64_t run_count;
+		};
 
-#ifdef DYNARRAY_USING_CPP20
-		friend CPP20_DYNARRAY_CONSTEXPR auto operator<=>(const dynarray &lhs, const dynarray &rhs)
+		/*!
+		 * @brief Sets flags in the header held by prefix.
+		 */
+		inline void set_binary_flags(binary_prefix &prefix, std::uint32_t flags) noexcept
 		{
-			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+			binary_header header = {};
+			std::memcpy(&header, prefix.bytes.get(), sizeof header);
+			header.flags |= flags;
+			std::memcpy(prefix.bytes.get(), &header, sizeof header);
 		}
-#else
-		friend bool operator!=(const dynarray &lhs, const dynarray &rhs)
+
+		/*!
+		 * @brief Writes the prefix of the binary format with binary_delta set, and then each run of dirty chunks with a single write.
+		 *
+		 * The bitmap is cleared once everything has been written.
+		 */
+		template<typename T, typename Dirty>
+		void write_delta_data(std::ostream &output, binary_prefix prefix, const T *block, std::uint64_t element_count, Dirty &dirty)
 		{
-			return !(lhs == rhs);
+			if (dirty.data() != block || dirty.size() != element_count)
+				throw std::invalid_argument("dirty_regions does not belong to dynarray");
+
+			std::size_t chunk_count = dirty.chunk_count();
+			delta_header delta = { dirty.chunk_size(), 0 };
+			for (std::size_t chunk = 0; chunk < chunk_count; ++chunk)
+				if (dirty.dirty(chunk) && (chunk == 0 || !dirty.dirty(chunk - 1)))
+					++delta.run_count;
+
+			set_binary_flags(prefix, binary_delta);
+			if (!output.write(prefix.bytes.get(), static_cast<std::streamsize>(prefix.length)) ||
+				!output.write(reinterpret_cast<const char *>(&delta), sizeof delta))
+				return;
+
+			for (std::size_t first = 0; first < chunk_count; ++first)
+			{
+				if (!dirty.dirty(first))
+					continue;
+				std::size_t last = first + 1;
+				while (last < chunk_count && dirty.dirty(last))
+					++last;
+
+				std::uint64_t run[2] = { first, last - first };
+				std::uint64_t begin = first * delta.chunk_elements;
+				std::uint64_t end = std::min<std::uint64_t>(last * delta.chunk_elements, element_count);
+				if (!output.write(reinterpret_cast<const char *>(run), sizeof run) ||
+					!output.write(reinterpret_cast<const char *>(block + begin), static_cast<std::streamsize>((end - begin) * sizeof(T))))
+					return;
+				first = last;
+			}
+			dirty.clear();
 		}
 
-		friend bool operator<(const dynarray &lhs, const dynarray &rhs)
+		/*!
+		 * @brief Reads data written by write_delta_data into block, in place.
+		 *
+		 * @param expected Prefix of the array to be updated, the delta must have been written by an array of the same shape
+		 * @exception std::invalid_argument if the data is broken, or does not match the array
+		 */
+		template<typename T>
+		void read_delta_data(std::istream &input, binary_prefix expected, T *block, std::uint64_t element_count)
 		{
-			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+			set_binary_flags(expected, binary_delta);
+			std::unique_ptr<char[]> prefix = std::make_unique<char[]>(expected.length);
+			delta_header delta = {};
+			if (!input.read(prefix.get(), static_cast<std::streamsize>(expected.length)))
+				return;
+			if (std::memcmp(prefix.get(), expected.bytes.get(), expected.length) != 0)
+				throw std::invalid_argument("delta does not match dynarray");
+			if (!input.read(reinterpret_cast<char *>(&delta), sizeof delta))
+				return;
+			if (delta.chunk_elements == 0)
+				throw std::invalid_argument("invalid dynarray delta data");
+
+			std::uint64_t chunk_count = element_count == 0 ? 0 : (element_count - 1) / delta.chunk_elements + 1;
+			for (std::uint64_t i = 0; i < delta.run_count; ++i)
+			{
+				std::uint64_t run[2] = {};
+				if (!input.read(reinterpret_cast<char *>(run), sizeof run))
+					return;
+				if (run[0] >= chunk_count || run[1] == 0 || run[1] > chunk_count - run[0])
+					throw std::invalid_argument("invalid dynarray delta data");
+
+				std::uint64_t begin = run[0] * delta.chunk_elements;
+				std::uint64_t end = run[0] + run[1] == chunk_count ? element_count : (run[0] + run[1]) * delta.chunk_elements;
+				if (!input.read(reinterpret_cast<char *>(block + begin), static_cast<std::streamsize>((end - begin) * sizeof(T))))
+					return;
+			}
 		}
 
-		friend bool operator>(const dynarray &lhs, const dynarray &rhs)
+		/*!
+		 * @brief Appends value to bytes in little-endian byte order, as stored in ZIP archives.
+		 */
+		inline void append_little_endian(std::string &bytes, std::uint64_t value, std::size_t length)
 		{
-			return rhs < lhs;
+			for (std::size_t i = 0; i < length; ++i)
+				bytes += static_cast<char>((value >> (i * 8)) & 0xff);
 		}
 
-		friend bool operator<=(const dynarray &lhs, const dynarray &rhs)
+		inline std::uint64_t read_little_endian(const char *bytes, std::size_t length) noexcept
 		{
-			return !(rhs < lhs);
+			std::uint64_t value = 0;
+			for (std::size_t i = length; i != 0; --i)
+				value = value << 8 | static_cast<unsigned char>(bytes[i - 1]);
+			return value;
 		}
 
-		friend bool operator>=(const dynarray &lhs, const dynarray &rhs)
+		struct crc32_table
 		{
-			return !(lhs < rhs);
-		}
-#endif
-	};
+			std::uint32_t entries[256];
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::size_type
-		dynarray<T, _Allocator>::expand_list(std::initializer_list<Ty> init)
-	{
-		return init.size();
-	}
+			constexpr crc32_table() : entries{}
+			{
+				for (std::uint32_t i = 0; i < 256; ++i)
+				{
+					std::uint32_t value = i;
+					for (int bit = 0; bit < 8; ++bit)
+						value = (value & 1) != 0 ? 0xedb88320u ^ (value >> 1) : value >> 1;
+					entries[i] = value;
+				}
+			}
+		};
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::size_type
-		dynarray<T, _Allocator>::expand_counts(size_type count, Args && ...args)
-	{
-		return count;
-	}
+		inline constexpr crc32_table crc32_entries{};
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::contiguous_allocator_type
-		dynarray<T, _Allocator>::expand_allocator(const allocator_type &_allocator, Args && ...args)
-	{
-		return _allocator;
-	}
+		/*!
+		 * @brief Forwards everything to another stream buffer, counting the bytes and their CRC-32 on the way.
+		 */
+		class crc32_streambuf : public std::streambuf
+		{
+		public:
+			explicit crc32_streambuf(std::streambuf *target) : target(target) {}
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename Skip, typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::contiguous_allocator_type
-		dynarray<T, _Allocator>::expand_allocators(const Skip &skip, const allocator_type &_allocator, Args && ...args)
-	{
-		return _allocator;
-	}
+			std::uint32_t checksum() const noexcept { return ~crc; }
+			std::uint64_t length() const noexcept { return written; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::initialise(const allocator_type &other_allocator)
-	{
-		contiguous_allocator = other_allocator;
-		reset();
-	}
+		protected:
+			std::streamsize xsputn(const char *source, std::streamsize count) override
+			{
+				std::streamsize accepted = target->sputn(source, count);
+				for (std::streamsize i = 0; i < accepted; ++i)
+					crc = crc32_entries.entries[(crc ^ static_cast<unsigned char>(source[i])) & 0xff] ^ (crc >> 8);
+				written += static_cast<std::uint64_t>(accepted);
+				return accepted;
+			}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::reset()
-	{
-		entire_array_data = nullptr;
-		this_level_array_head = nullptr;
-		this_level_array_tail = nullptr;
-	}
+			int_type overflow(int_type ch) override
+			{
+				if (traits_type::eq_int_type(ch, traits_type::eof()))
+					return traits_type::not_eof(ch);
+				char c = traits_type::to_char_type(ch);
+				return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+			}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::verify_size(size_type count)
-	{
-		if (count > static_cast<size_type>(std::numeric_limits<difference_type>::max()))
-			throw std::length_error("array too long");
-	}
+			int sync() override { return target->pubsync(); }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(size_type count)
-	{
-		if (count == 0)
+		private:
+			std::streambuf *target;
+			std::uint32_t crc = 0xffffffffu;
+			std::uint64_t written = 0;
+		};
+
+		// ZIP archives without ZIP64 extensions cannot describe sizes or offsets from this value on
+		inline constexpr std::uint64_t zip_limit = 0xffffffffu;
+
+		/*!
+		 * @brief Turns a std::streambuf into transfer(bytes, length) for read_rows and write_rows, other transfers are used as they are.
+		 */
+		template<bool Reading, typename Transfer>
+		decltype(auto) byte_transfer(Transfer &transfer)
 		{
-			reset();
-			return;
+			if constexpr (std::is_base_of_v<std::streambuf, Transfer>)
+			{
+				return [&transfer](void *bytes, std::size_t length)
+				{
+					std::streamsize count = static_cast<std::streamsize>(length);
+					if constexpr (Reading)
+						return transfer.sgetn(static_cast<char *>(bytes), count) == count;
+					else
+						return transfer.sputn(static_cast<const char *>(bytes), count) == count;
+				};
+			}
+			else
+				return (transfer);
 		}
 
-		verify_size(count);
-		entire_array_data = contiguous_allocator.allocate(count);
-		for (size_type i = 0; i < count; ++i)
-			std::allocator_traits<allocator_type>::construct(contiguous_allocator, entire_array_data + i);
+		/*!
+		 * @brief Moves the elements of block between memory and transfer, rows_per_step outer rows at a time.
+		 *
+		 * Each group of rows is transferred asynchronously while step is called on its neighbour, so I/O overlaps with computing.
+		 * Reading: a group is handed to step after it has arrived. Writing: a group is written after step has filled it.
+		 * The rows themselves are the I/O buffers, nothing is copied.
+		 *
+		 * @param block Contiguous block of the array
+		 * @param rows Number of outer rows
+		 * @param row_elements row_elements(row) returns the number of elements of the row
+		 * @param transfer transfer(bytes, length) reads or writes length bytes, returns false on failure
+		 * @param step step(first_row, last_row) is called for the rows [first_row, last_row)
+		 * @return false if transfer failed
+		 */
+		template<bool Reading, typename T, typename RowElements, typename Transfer, typename Step>
+		bool stream_rows(T *block, std::size_t rows, std::size_t rows_per_step, RowElements row_elements, Transfer &&transfer, Step &step)
+		{
+			if (rows_per_step == 0)
+				throw std::invalid_argument("rows_per_step must not be 0");
+			if (rows == 0)
+				return true;
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+			struct row_group
+			{
+				std::size_t first_row, last_row;
+				std::size_t first_offset, last_offset;	// position of the elements in block
+			};
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count)
-	{
-		// reached the innermost layer
-		if (std::is_same_v<T, internal_value_type>)
-		{
-			entire_array_data = nullptr;	// always nullptr in nested-dynarray
+			auto next_group = [&](const row_group &group)
+			{
+				row_group next = { group.last_row, group.last_row, group.last_offset, group.last_offset };
+				next.last_row += std::min(rows_per_step, rows - group.last_row);
+				for (std::size_t row = next.first_row; row < next.last_row; ++row)
+					next.last_offset += row_elements(row);
+				return next;
+			};
+
+			auto move_group = [&transfer, block](const row_group &group)
+			{
+				return group.first_offset == group.last_offset ||
+				       transfer(block + group.first_offset, (group.last_offset - group.first_offset) * sizeof(T));
+			};
 
-			for (size_type i = 0; i < count; ++i)
-				std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, starting_address + i);
+			row_group current = next_group(row_group{});
+			if constexpr (Reading)
+			{
+				if (!move_group(current))
+					return false;
+			}
+			else
+				step(current.first_row, current.last_row);
 
-			this_level_array_head = starting_address;
-			this_level_array_tail = this_level_array_head + count - 1;
+			while (current.first_row < rows)
+			{
+				row_group next = next_group(current);
+				std::future<bool> moved;
+				if constexpr (Reading)
+				{
+					if (next.first_row < rows)
+						moved = std::async(std::launch::async, move_group, next);
+					step(current.first_row, current.last_row);
+				}
+				else
+				{
+					moved = std::async(std::launch::async, move_group, current);
+					if (next.first_row < rows)
+						step(next.first_row, next.last_row);
+				}
+
+				if (moved.valid() && !moved.get())
+					return false;
+				current = next;
+			}
+			return true;
 		}
-		else reset();
-	}
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename ... Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(size_type count, Args&& ...args)
-	{
-		verify_size(count);
+		// delimited text is parsed concurrently in pieces of about this many bytes
+		inline constexpr std::size_t delimited_piece_size = 1 << 20;
 
-		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
-		if (nested_level > sizeof...(args) || count == 0)
+		/*!
+		 * @brief Piece of delimited text made of whole lines, with the position of its rows and elements in the whole text.
+		 */
+		struct delimited_piece
 		{
-			reset();
-			return;
+			const char *first;
+			const char *last;
+			std::size_t rows;
+			std::size_t elements;
+			std::size_t first_row;
+			std::size_t first_element;
+			bool valid;
+		};
+
+		/*!
+		 * @brief Cuts text into piece_count pieces of similar size, each one ends after a line break or at the end of text.
+		 */
+		inline void split_delimited(std::string_view text, delimited_piece *pieces, std::size_t piece_count) noexcept
+		{
+			const char *first = text.data();
+			const char *text_end = text.data() + text.size();
+			for (std::size_t i = 0; i < piece_count; ++i)
+			{
+				const char *last = i + 1 == piece_count ? text_end : text.data() + text.size() / piece_count * (i + 1);
+				if (last < first)
+					last = first;
+				if (last != text_end)
+				{
+					const char *line_break = static_cast<const char *>(std::memchr(last, '\n', static_cast<std::size_t>(text_end - last)));
+					last = line_break == nullptr ? text_end : line_break + 1;
+				}
+				pieces[i] = delimited_piece{ first, last, 0, 0, 0, 0, true };
+				first = last;
+			}
 		}
 
-		entire_array_data = contiguous_allocator.allocate(count);
+		/*!
+		 * @brief Calls line(first, last) for each non-blank line of [first, last), without its line break.
+		 */
+		template<typename Function>
+		void for_each_line(const char *first, const char *last, Function &&line)
+		{
+			while (first < last)
+			{
+				const char *line_break = static_cast<const char *>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+				const char *line_end = line_break == nullptr ? last : line_break;
+				const char *content_end = line_end != first && line_end[-1] == '\r' ? line_end - 1 : line_end;
+				if (content_end != first)
+					line(first, content_end);
+				first = line_break == nullptr ? last : line_break + 1;
+			}
+		}
 
-		for (size_type i = 0; i < count; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::forward<Args>(args)...);
+		inline void count_piece(delimited_piece &piece, char delimiter) noexcept
+		{
+			for_each_line(piece.first, piece.last, [&](const char *first, const char *last)
+			{
+				++piece.rows;
+				piece.elements += 1 + static_cast<std::size_t>(std::count(first, last, delimiter));
+			});
+		}
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+		/*!
+		 * @brief Parses the numbers of a piece with std::from_chars, straight into values.
+		 *
+		 * @param values Receives the elements of the piece
+		 * @param row_sizes Receives the number of elements of each row of the piece
+		 * @return false if a field is not a number
+		 */
+		template<typename T>
+		bool parse_piece(const delimited_piece &piece, char delimiter, T *values, std::uint64_t *row_sizes) noexcept
+		{
+			bool valid = true;
+			auto is_blank = [delimiter](char ch) { return (ch == ' ' || ch == '\t') && ch != delimiter; };
+			for_each_line(piece.first, piece.last, [&](const char *first, const char *last)
+			{
+				T *row_head = values;
+				while (valid)
+				{
+					while (first != last && is_blank(*first))
+						++first;
+					if (first != last && *first == '+' && last - first > 1 && first[1] != '-')
+						++first;
+
+					std::from_chars_result result = std::from_chars(first, last, *values);
+					first = result.ptr;
+					while (first != last && is_blank(*first))
+						++first;
+					valid = result.ec == std::errc() && (first == last || *first == delimiter);
+					++values;
+					if (first == last)
+						break;
+					++first;
+				}
+				*row_sizes++ = static_cast<std::uint64_t>(values - row_head);
+			});
+			return valid;
+		}
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename ... Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count, Args&& ... args)
-	{
-		entire_array_data = nullptr;	// always nullptr in nested-dynarray
+	}	// internal namespace
 
-		for (size_type i = 0; i < count; ++i)
-			std::allocator_traits<allocator_type>::construct(contiguous_allocator, starting_address + i, std::forward<Args>(args)...);
+	template<typename T>
+	class vla_iterator
+	{
+		using self_value_type = vla_iterator<T>;
+		using self_reference = vla_iterator<T> &;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+		CPP20_DYNARRAY_CONSTEXPR explicit vla_iterator(pointer ptr = nullptr) : dynarray_ptr(ptr) {}
+		CPP20_DYNARRAY_CONSTEXPR vla_iterator(const vla_iterator<T> &other_iterator) : dynarray_ptr(other_iterator.dynarray_ptr) {}
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename _Alloc_t, typename, typename ... Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(size_type count, _Alloc_t &&other_allocator, Args&& ... args)
-	{
-		verify_size(count);
+		// operators
 
-		size_type entire_array_size = count;
-		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
-		if (nested_level * 2 > sizeof...(args) || entire_array_size == 0)
-		{
-			reset();
-			return;
-		}
+		CPP20_DYNARRAY_CONSTEXPR reference operator*() const noexcept { return *dynarray_ptr; }
 
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		CPP20_DYNARRAY_CONSTEXPR pointer operator->() const noexcept { return dynarray_ptr; }
 
-		for (size_type i = 0; i < entire_array_size; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::forward<Args>(args)...);
+		CPP20_DYNARRAY_CONSTEXPR reference operator[](difference_type offset) const noexcept { return dynarray_ptr[offset]; }
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
-	}
+		CPP20_DYNARRAY_CONSTEXPR self_reference operator=(const self_value_type & right_iterator) noexcept { dynarray_ptr = right_iterator.dynarray_ptr; return *this; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename _Alloc_t, typename, typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count, _Alloc_t &&other_allocator, Args&& ... args)
-	{
-		entire_array_data = nullptr;	// always nullptr in nested-dynarray
-		contiguous_allocator = other_allocator;
+		CPP20_DYNARRAY_CONSTEXPR self_reference operator=(pointer ptr) noexcept { dynarray_ptr = ptr; return *this; }
 
-		for (size_type i = 0; i < count; ++i)
-			std::allocator_traits<allocator_type>::construct(contiguous_allocator, starting_address + i, std::forward<Args>(args)...);
+		CPP20_DYNARRAY_CONSTEXPR self_reference operator++() noexcept { ++dynarray_ptr; return *this; }
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+		CPP20_DYNARRAY_CONSTEXPR self_value_type operator++(int) noexcept { return self_value_type(dynarray_ptr++); }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(std::initializer_list<T> input_list)
-	{
-		size_type count = input_list.size();
-		if (count == 0) return;
-		verify_size(count);
-		entire_array_data = contiguous_allocator.allocate(count);
-		auto list_iter = input_list.begin();
-		for (size_type i = 0; i < count; ++i, ++list_iter)
-			std::allocator_traits<allocator_type>::construct(contiguous_allocator, entire_array_data + i, *list_iter);
+		CPP20_DYNARRAY_CONSTEXPR self_reference operator--() noexcept { --dynarray_ptr; return *this; }
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+		CPP20_DYNARRAY_CONSTEXPR self_value_type operator--(int) noexcept { return self_value_type(dynarray_ptr--); }
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty, typename ... Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list,
-			const allocator_type &other_allocator, Args&& ...args)
-	{
-		contiguous_allocator = other_allocator;
-		size_type count = input_list.size();
-		verify_size(count);
-		entire_array_data = nullptr;
+		CPP20_DYNARRAY_CONSTEXPR self_reference operator+=(difference_type offset) noexcept { dynarray_ptr += offset; return *this; }
 
-		auto list_iter = input_list.begin();
-		for (size_type i = 0; i < count; ++i, ++list_iter)
-			std::allocator_traits<allocator_type>::construct(contiguous_allocator, starting_address + i, *list_iter);
+		CPP20_DYNARRAY_CONSTEXPR self_reference operator-=(difference_type offset) noexcept { dynarray_ptr -= offset; return *this; }
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+		CPP20_DYNARRAY_CONSTEXPR self_value_type operator+(difference_type offset) const noexcept { return self_value_type(dynarray_ptr) += offset; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::deallocate_array()
-	{
-		size_type entire_array_size = static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
-		if (entire_array_data)
-		{
-			for (size_type i = entire_array_size; i != 0; --i)
-				std::allocator_traits<allocator_type>::destroy(contiguous_allocator, entire_array_data + i - 1);
-			contiguous_allocator.deallocate(entire_array_data, entire_array_size);
-			entire_array_data = nullptr;
-		}
-	}
+		CPP20_DYNARRAY_CONSTEXPR self_value_type operator-(difference_type offset) const noexcept { return self_value_type(dynarray_ptr - offset); }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::copy_array(const dynarray &other)
-	{
-		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-		if (entire_array_size == 0) return;
+		CPP20_DYNARRAY_CONSTEXPR difference_type operator-(const self_value_type & right_iterator) const noexcept { return dynarray_ptr - right_iterator.dynarray_ptr; }
 
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
-		for (size_type i = 0; i < entire_array_size; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, *(other_array_data + i));
+		CPP20_DYNARRAY_CONSTEXPR bool operator==(const self_value_type &right_iterator) const noexcept { return dynarray_ptr == right_iterator.dynarray_ptr; }
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
-	}
+#ifdef DYNARRAY_USING_CPP20
+		CPP20_DYNARRAY_CONSTEXPR auto operator<=>(const self_value_type &right_iterator) const noexcept = default;
+#else
+		bool operator!=(const self_value_type &right_iterator) const noexcept { return dynarray_ptr != right_iterator.dynarray_ptr; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::copy_array(const dynarray &other, const allocator_type &other_allocator, Args&&... args)
-	{
-		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-		if (entire_array_size == 0) return;
+		bool operator<(const self_value_type &right_iterator) const noexcept { return dynarray_ptr < right_iterator.dynarray_ptr; }
 
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
-		for (size_type i = 0; i < entire_array_size; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, *(other_array_data + i));
+		bool operator>(const self_value_type &right_iterator) const noexcept { return dynarray_ptr > right_iterator.dynarray_ptr; }
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
-	}
+		bool operator<=(const self_value_type &right_iterator) const noexcept { return dynarray_ptr <= right_iterator.dynarray_ptr; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other)
-	{
-		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-		entire_array_data = nullptr;
+		bool operator>=(const self_value_type &right_iterator) const noexcept { return dynarray_ptr >= right_iterator.dynarray_ptr; }
+#endif
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
-	}
+		friend CPP20_DYNARRAY_CONSTEXPR self_value_type operator+(typename vla_iterator::difference_type offset, const self_value_type &other) noexcept { return self_value_type(other) += offset; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other, const allocator_type &other_allocator, Args&& ... args)
-	{
-		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-		contiguous_allocator = other_allocator;
-		entire_array_data = nullptr;
+	private:
+		pointer dynarray_ptr;
+	};
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
-	}
 
-	template<typename T, template<typename U> typename _Allocator>
-	template<typename InputIterator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::copy_array(InputIterator other_begin, InputIterator other_end)
+	/*!
+	 * @brief Tag of the constructors which take over a contiguous block allocated elsewhere, see dynarray(adopt_block_t, ...)
+	 */
+	struct adopt_block_t { explicit adopt_block_t() = default; };
+	inline constexpr adopt_block_t adopt_block{};
+
+	/*!
+	 * @brief Tag of the constructors which refer to a contiguous block owned elsewhere, see dynarray(view_block_t, ...)
+	 */
+	struct view_block_t { explicit view_block_t() = default; };
+	inline constexpr view_block_t view_block{};
+
+	/*!
+	 * @brief Tag of the constructors which construct every element from a function, see dynarray(from_generator_t, ...)
+	 */
+	struct from_generator_t { explicit from_generator_t() = default; };
+	inline constexpr from_generator_t from_generator{};
+
+	/*!
+	 * @brief Allocator with std::malloc and std::free, for handing contiguous blocks over to and from C code.
+	 *
+	 * A block allocated with std::malloc can be adopted by a dynarray using it, and a block released by such a dynarray
+	 * can be freed with std::free (destroy the elements first unless they are trivially destructible).
+	 */
+	template<typename T>
+	struct malloc_allocator
 	{
-		static_assert(std::is_same_v<std::decay_t<decltype(*other_begin)>, T> ||
-			std::is_convertible_v<T, internal_value_type>,
-			"invalid iterator, cannot convert to a valid dynarray");
+		using value_type = T;
 
-		size_type count = static_cast<size_type>(std::abs(other_end - other_begin));
-		if (count == 0) return;
+		malloc_allocator() noexcept = default;
 
-		entire_array_data = contiguous_allocator.allocate(count);
+		template<typename U>
+		malloc_allocator(const malloc_allocator<U> &) noexcept {}
 
-		InputIterator other_iterator = other_begin;
-		for (size_type i = 0; i < count; ++i, ++other_iterator)
-			std::allocator_traits<allocator_type>::construct(contiguous_allocator, entire_array_data + i, *other_iterator);
+		T* allocate(std::size_t count)
+		{
+			if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+				throw std::bad_array_new_length();
+			void *memory = std::malloc(count == 0 ? 1 : count * sizeof(T));
+			if (memory == nullptr)
+				throw std::bad_alloc();
+			return static_cast<T *>(memory);
+		}
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + count - 1;
-	}
+		void deallocate(T *ptr, std::size_t) noexcept { std::free(ptr); }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::loop_copy(const dynarray &other) noexcept
-	{
-		if (size() == 0 || other.size() == 0) return;
+		friend bool operator==(const malloc_allocator &, const malloc_allocator &) noexcept { return true; }
 
-		difference_type length = std::min<difference_type>(this_level_array_tail - this_level_array_head + 1,
-			other.this_level_array_tail - other.this_level_array_head + 1);
-		for (difference_type i = 0; i < length; ++i)
-			*(this_level_array_head + i) = *(other.this_level_array_head + i);
-	}
+		friend bool operator!=(const malloc_allocator &, const malloc_allocator &) noexcept { return false; }
+	};
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::loop_copy(std::initializer_list<T> input_list) noexcept
+	/*!
+	 * @brief Opt-in record of the chunks of a contiguous block which have been written, one bit per chunk.
+	 *
+	 * Created by track_dirty(). Writes are recorded through write() or mark(), save_delta() then writes only the dirty chunks
+	 * and clears the bitmap. Marking is lock-free, several threads may mark at the same time.
+	 * A dynarray does not know about its dirty_regions: writes which bypass it are not recorded.
+	 */
+	template<typename T>
+	class dirty_regions
 	{
-		size_type count = input_list.size();
-		if (size() == 0 || count == 0) return;
-
-		auto list_iter = input_list.begin();
-		size_type length = static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
-		for (size_type i = 0; i < count && i < length; ++i, ++list_iter)
-			*(this_level_array_head + i) = *list_iter;
-	}
+	public:
+		dirty_regions() noexcept = default;
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::move_array(dynarray &other) noexcept
-	{
-		if (other.empty())
+		/*!
+		 * @param block First element of the contiguous block
+		 * @param element_count Number of elements in the block
+		 * @param chunk_elements Number of elements covered by each bit
+		 * @exception std::invalid_argument if chunk_elements is 0
+		 */
+		dirty_regions(T *block, std::size_t element_count, std::size_t chunk_elements)
+			: block(block), element_count(element_count), chunk_elements(chunk_elements)
 		{
-			initialise();
-			return;
+			if (chunk_elements == 0)
+				throw std::invalid_argument("chunk_elements must not be 0");
+			word_count = (chunk_count() + 63) / 64;
+			bits = std::make_unique<std::atomic<std::uint64_t>[]>(word_count);
 		}
 
-		if (other.entire_array_data == nullptr)
+		/*!
+		 * @brief Write proxy: marks the chunk of element, and returns element to be written, e.g. dirty.write(arr[i][j]) = value;
+		 */
+		T& write(T &element) noexcept
 		{
-			initialise();
+			mark(&element);
+			return element;
+		}
 
-			size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-			if (entire_array_size == 0) return;
+		/*!
+		 * @brief Marks the chunk of element, which must be in the block.
+		 */
+		void mark(const T *element) noexcept
+		{
+			set(static_cast<std::size_t>(element - block) / chunk_elements);
+		}
 
-			entire_array_data = contiguous_allocator.allocate(entire_array_size);
-			internal_pointer_type other_array_data = other.this_level_array_head;
-			for (size_type i = 0; i < entire_array_size; ++i)
-				std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::move(*(other_array_data + i)));
-
-			this_level_array_head = entire_array_data;
-			this_level_array_tail = this_level_array_head + entire_array_size - 1;
-		}
-		else
+		/*!
+		 * @brief Marks all chunks overlapped by [first, last), e.g. after a row has been written by an algorithm.
+		 */
+		void mark(const T *first, const T *last) noexcept
 		{
-			contiguous_allocator = other.contiguous_allocator;
-			entire_array_data = other.entire_array_data;
-			this_level_array_head = other.this_level_array_head;
-			this_level_array_tail = other.this_level_array_tail;
-			other.reset();
+			if (first == last)
+				return;
+			std::size_t last_chunk = static_cast<std::size_t>(last - 1 - block) / chunk_elements;
+			for (std::size_t chunk = static_cast<std::size_t>(first - block) / chunk_elements; chunk <= last_chunk; ++chunk)
+				set(chunk);
 		}
-	}
-
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::move_values(dynarray &other) noexcept
-	{
-		if (size() == 0 || other.size() == 0) return;
-
-		difference_type length = std::min<difference_type>(this_level_array_tail - this_level_array_head + 1,
-			other.this_level_array_tail - other.this_level_array_head + 1);
-		for (difference_type i = 0; i < length; ++i)
-			*(this_level_array_head + i) = std::move(*(other.this_level_array_head + i));
-	}
-
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::swap_all(dynarray &other) noexcept
-	{
-		std::swap(entire_array_data, other.entire_array_data);
-		std::swap(this_level_array_head, other.this_level_array_head);
-		std::swap(this_level_array_tail, other.this_level_array_tail);
-		std::swap(contiguous_allocator, other.contiguous_allocator);
-	}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::swap_outside(dynarray &other) noexcept
-	{
-		if (entire_array_data == nullptr || other.entire_array_data == nullptr)
-			swap(other);
-		else
-			swap_all(other);
-	}
+		void mark_all() noexcept
+		{
+			for (std::size_t chunk = 0; chunk < chunk_count(); ++chunk)
+				set(chunk);
+		}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
-		dynarray<T, _Allocator>::at(size_type pos)
-	{
-		if (pos >= size())
-			throw std::out_of_range("out of range, incorrect position");
-		return (*this)[pos];
-	}
+		void clear() noexcept
+		{
+			for (std::size_t i = 0; i < word_count; ++i)
+				bits[i].store(0, std::memory_order_relaxed);
+		}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
-		dynarray<T, _Allocator>::at(size_type pos) const
-	{
-		if (pos >= size())
-			throw std::out_of_range("out of range, incorrect position");
-		return (*this)[pos];
-	}
+		bool dirty(std::size_t chunk) const noexcept
+		{
+			return (bits[chunk / 64].load(std::memory_order_relaxed) >> (chunk % 64) & 1) != 0;
+		}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
-		dynarray<T, _Allocator>::operator[](size_type pos)
-	{
-		return *(this_level_array_head + pos);
-	}
+		std::size_t dirty_count() const noexcept
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < word_count; ++i)
+				for (std::uint64_t word = bits[i].load(std::memory_order_relaxed); word != 0; word &= word - 1)
+					++count;
+			return count;
+		}
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
-		dynarray<T, _Allocator>::operator[](size_type pos) const
-	{
-		return *(this_level_array_head + pos);
-	}
+		std::size_t chunk_count() const noexcept { return element_count == 0 ? 0 : (element_count - 1) / chunk_elements + 1; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
-		dynarray<T, _Allocator>::back()
-	{
-		return *(this_level_array_tail);
-	}
+		std::size_t chunk_size() const noexcept { return chunk_elements; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
-		dynarray<T, _Allocator>::back() const
-	{
-		return *(this_level_array_tail);
-	}
+		std::size_t size() const noexcept { return element_count; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::swap(dynarray &other) noexcept
-	{
-		difference_type length = std::min<difference_type>(this_level_array_tail - this_level_array_head + 1,
-			other.this_level_array_tail - other.this_level_array_head + 1);
-		for (difference_type i = 0; i < length; ++i)
-			std::swap(*(this_level_array_head + i), *(other.this_level_array_head + i));
-	}
+		T* data() const noexcept { return block; }
 
-	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<T, _Allocator>::fill(const internal_value_type &value)
-	{
-		for (auto current_address = this_level_array_head;
-			current_address != this_level_array_tail + 1;
-			++current_address)
-			*current_address = value;
-	}
+	private:
+		void set(std::size_t chunk) noexcept
+		{
+			std::atomic<std::uint64_t> &word = bits[chunk / 64];
+			std::uint64_t bit = std::uint64_t(1) << (chunk % 64);
+			if ((word.load(std::memory_order_relaxed) & bit) == 0)
+				word.fetch_or(bit, std::memory_order_relaxed);
+		}
 
+		T *block = nullptr;
+		std::size_t element_count = 0;
+		std::size_t chunk_elements = 1;
+		std::size_t word_count = 0;
+		std::unique_ptr<std::atomic<std::uint64_t>[]> bits;
+	};
 
 
-	template<typename T, template<typename U> typename _Allocator>
-	class dynarray<dynarray<T, _Allocator>, _Allocator>
+	template<typename T, template<typename U> typename _Allocator = std::allocator>
+	class dynarray
 	{
-		using Td = dynarray<T, _Allocator>;
-		friend class dynarray<dynarray<Td, _Allocator>, _Allocator>;
+		friend class dynarray<dynarray<T, _Allocator>, _Allocator>;
+		template<typename U, template<typename V> typename A>
+		friend class dynarray;
+		template<std::size_t Rank, template<typename V> typename A>
+		friend class bit_dynarray;
+		friend class npz_writer;
 	public:
 
 		// Member types
 
-		using value_type = Td;
+		using value_type = T;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
 		using reference = value_type &;
@@ -1314,14 +2462,14 @@ namespace vla
 		using pointer = value_type *;
 		using const_pointer = const value_type *;
 
-		using iterator = vla_iterator<Td>;
-		using const_iterator = vla_iterator<const Td>;
+		using iterator = vla_iterator<T>;
+		using const_iterator = vla_iterator<const T>;
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-		using allocator_type = _Allocator<Td>;
+		using allocator_type = _Allocator<T>;
 	private:
-		using internal_value_type = typename internal_impl::inner_type<Td, _Allocator>::value_type;
+		using internal_value_type = typename internal_impl::inner_type<T, _Allocator>::value_type;
 		using internal_pointer_type = internal_value_type *;
 	public:
 		using contiguous_allocator_type = _Allocator<internal_value_type>;
@@ -1448,27 +2596,72 @@ namespace vla
 		}
 
 		/*!
-		 * @brief Create a multiple-dimensional array with initializer_list.
+		 * @brief Create a one-dimensional array with initializer_list and use your allocator (if any)
 		 *
-		 * @param input_listYour initializer_list
+		 * @param input_list Your initializer_list
+		 * @param other_allocator Your allocator (if any)
 		 */
-		template<typename Ty>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(std::initializer_list<std::initializer_list<Ty>> input_list)
+		CPP20_DYNARRAY_CONSTEXPR dynarray(std::initializer_list<T> input_list, const allocator_type &other_allocator = allocator_type())
 		{
-			initialise();
+			initialise(other_allocator);
 			allocate_array(input_list);
 		}
 
 		/*!
-		 * @brief Create a multiple-dimensional array with initializer_list.
+		 * @brief Takes over a contiguous block allocated elsewhere, without copying or moving the elements.
 		 *
-		 * @param input_listYour initializer_list
+		 * The elements must have been constructed. When the dynarray no longer needs the block, it destroys the elements
+		 * and deallocates the block with owner, so the block has to come from owner (e.g. std::malloc for malloc_allocator).
+		 * If the constructor throws, the block is not taken over: the caller still owns the block and its elements.
+		 *
+		 * @param block Elements of the array, may be nullptr if there are no elements
+		 * @param count Number of elements
+		 * @param owner The allocator to release the block with
+		 * @exception std::length_error if count is too large
 		 */
-		template<typename Ty, typename ... Args>
-		CPP20_DYNARRAY_CONSTEXPR dynarray(std::initializer_list<std::initializer_list<Ty>> input_list, const allocator_type &other_allocator, Args&& ...args)
+		dynarray(adopt_block_t, internal_pointer_type block, size_type count, const contiguous_allocator_type &owner = contiguous_allocator_type())
 		{
-			initialise(other_allocator);
-			allocate_array(input_list, std::forward<Args>(args)...);
+			initialise();
+			attach_extents(block, &count, &owner);
+		}
+
+		/*!
+		 * @brief Refers to a contiguous block owned elsewhere, without copying the elements.
+		 *
+		 * The same as view_binary, the dynarray does not own the block, which has to outlive it.
+		 * Assigning to the view replaces the values in the block, the same way as assigning to an inner layer.
+		 *
+		 * @param block Elements of the array
+		 * @param count Number of elements
+		 */
+		dynarray(view_block_t, internal_pointer_type block, size_type count)
+		{
+			initialise();
+			attach_extents(block, &count, nullptr);
+		}
+
+		/*!
+		 * @brief Construct by count, every element is constructed in place with the value returned by generator.\n
+		 * Example: dynarray<float> my_array(vla::from_generator, count, [](std::size_t i) { return float(i) * 0.5f; });
+		 *
+		 * @param count Number of elements
+		 * @param generator Called with the position of each element
+		 */
+		template<typename Generator>
+		dynarray(from_generator_t, size_type count, Generator generator)
+		{
+			initialise();
+			generate_array(&count, generator, internal_impl::sequenced_tasks());
+		}
+
+		/*!
+		 * @brief Same as above, the elements are constructed in parallel with policy (std::execution::par, etc.), generator has to be safe to call concurrently.
+		 */
+		template<typename ExecutionPolicy, typename Generator>
+		dynarray(from_generator_t, ExecutionPolicy &&policy, size_type count, Generator generator)
+		{
+			initialise();
+			generate_array(&count, generator, internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy });
 		}
 
 		/*!
@@ -1511,20 +2704,7 @@ namespace vla
 		 * @param input_list Your initializer_list
 		 * @return A new dynarray
 		 */
-		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(std::initializer_list<internal_value_type> input_list) noexcept
-		{
-			loop_copy(input_list);
-			return *this;
-		}
-
-		/*!
-		 * @brief Erase existing data and construct a new dynarray with initializer_list.
-		 *
-		 * @param input_list Your initializer_list
-		 * @return A new dynarray
-		 */
-		template<typename Ty>
-		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept
+		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(std::initializer_list<T> input_list) noexcept
 		{
 			loop_copy(input_list);
 			return *this;
@@ -1634,6 +2814,51 @@ namespace vla
 		*/
 		CPP20_DYNARRAY_CONSTEXPR const internal_pointer_type data() const noexcept { return this_level_array_head; }
 
+		/*!
+		 * @brief Hands the contiguous block over to the caller, and leaves the container empty.
+		 *
+		 * The elements are not destroyed. The block holds as many elements as the whole array had, in the same order;
+		 * destroy them and deallocate the block with contiguous_allocator_type (std::free for malloc_allocator).
+		 *
+		 * @return The contiguous block, nullptr if the container does not own one (an inner layer, a view, or empty)
+		*/
+		internal_pointer_type release() noexcept;
+
+		/*!
+		 * @brief Views the same elements with another shape, only the node skeleton is built, the elements are neither copied nor moved.
+		 *
+		 * The view refers to the contiguous block of this container, which has to outlive it.\n
+		 * Example: auto matrix = vla_array.reshape({ rows, cols });
+		 *
+		 * @param extents Extent of each dimension, their product has to equal the number of elements
+		 * @return A view with the new shape
+		 * @exception std::invalid_argument if the extents do not match the number of elements
+		*/
+		template<std::size_t M>
+		internal_impl::nested_dynarray_t<T, M, _Allocator> reshape(const size_type (&extents)[M]) &
+		{
+			internal_impl::nested_dynarray_t<T, M, _Allocator> reshaped;
+			reshaped.attach_extents(reshape_block(extents, M), extents, nullptr);
+			return reshaped;
+		}
+
+		/*!
+		 * @brief Same as above, but a container owning its block hands the block over to the result and is left empty.
+		 *
+		 * Example: auto matrix = std::move(vla_array).reshape({ rows, cols });
+		*/
+		template<std::size_t M>
+		internal_impl::nested_dynarray_t<T, M, _Allocator> reshape(const size_type (&extents)[M]) &&
+		{
+			internal_impl::nested_dynarray_t<T, M, _Allocator> reshaped = reshape(extents);
+			if (entire_array_data != nullptr && reshaped.this_level_array_head != nullptr)
+			{
+				reshaped.contiguous_allocator = contiguous_allocator;
+				reshaped.entire_array_data = release();
+			}
+			return reshaped;
+		}
+
 		/*!
 		 * @brief Returns pointer to the underlying array serving as element storage.
 		 *
@@ -1642,7 +2867,7 @@ namespace vla
 		 * @return Pointer to the underlying element storage.
 		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR pointer get() noexcept { return current_dimension_array_data; }
+		CPP20_DYNARRAY_CONSTEXPR pointer get() noexcept { return this_level_array_head; }
 
 		/*!
 		 * @brief Returns const pointer to the underlying array serving as element storage.
@@ -1652,7 +2877,7 @@ namespace vla
 		 * @return Const pointer to the underlying element storage.
 		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR const pointer get() const noexcept { return current_dimension_array_data; }
+		CPP20_DYNARRAY_CONSTEXPR const pointer get() const noexcept { return this_level_array_head; }
 
 		/*!
 		 * @brief Checks if the container has no elements.
@@ -1660,9 +2885,7 @@ namespace vla
 		*/
 		CPP20_DYNARRAY_CONSTEXPR CPP20_DYNARRAY_NODISCARD bool empty() const noexcept
 		{
-			if (this_level_array_tail == this_level_array_head)
-				return true;
-			return static_cast<bool>(this_level_array_tail - this_level_array_head + 1);
+			return this_level_array_head == nullptr || this_level_array_tail == nullptr;
 		}
 
 		/*!
@@ -1713,7 +2936,7 @@ namespace vla
 		 *
 		 * @return Iterator to the first element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR iterator begin() noexcept { return iterator(current_dimension_array_data); }
+		CPP20_DYNARRAY_CONSTEXPR iterator begin() noexcept { return iterator(this_level_array_head); }
 
 		/*!
 		 * @brief Returns an iterator to the first element of the vector.
@@ -1722,7 +2945,7 @@ namespace vla
 		 *
 		 * @return Iterator to the first element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator begin() const noexcept { return const_iterator(current_dimension_array_data); }
+		CPP20_DYNARRAY_CONSTEXPR const_iterator begin() const noexcept { return const_iterator(this_level_array_head); }
 
 		/*!
 		 * @brief Returns an iterator to the first element of the vector.
@@ -1740,7 +2963,7 @@ namespace vla
 		 *
 		 * @return Iterator to the element following the last element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR iterator end() noexcept { return iterator(current_dimension_array_data + current_dimension_array_size); }
+		CPP20_DYNARRAY_CONSTEXPR iterator end() noexcept { return iterator(this_level_array_tail + 1); }
 
 		/*!
 		 * @brief Returns an iterator to the element following the last element of the vector.
@@ -1749,7 +2972,7 @@ namespace vla
 		 *
 		 * @return Iterator to the element following the last element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator end() const noexcept { return const_iterator(current_dimension_array_data + current_dimension_array_size); }
+		CPP20_DYNARRAY_CONSTEXPR const_iterator end() const noexcept { return const_iterator(this_level_array_tail + 1); }
 
 		/*!
 		 * @brief Returns an iterator to the element following the last element of the vector.
@@ -1819,15 +3042,13 @@ namespace vla
 
 	private:
 
-		internal_pointer_type entire_array_data;	// always nullptr in nested-dynarray
+		static constexpr size_type dimensions = internal_impl::inner_type<dynarray, _Allocator>::nested_level;
 
-		size_type current_dimension_array_size;
-		pointer current_dimension_array_data;	// as node managers if not innermost layer
+		internal_pointer_type entire_array_data;	// always nullptr in nested-dynarray
 
 		internal_pointer_type this_level_array_head;
 		internal_pointer_type this_level_array_tail;
 
-		allocator_type array_allocator;
 		contiguous_allocator_type contiguous_allocator;
 
 
@@ -1842,17 +3063,19 @@ namespace vla
 			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
 		}
 
+		CPP20_DYNARRAY_CONSTEXPR size_type get_element_count() const noexcept
+		{
+			if (this_level_array_head == nullptr)
+				return 0;
+			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		}
+
 		template<typename Ty>
 		static CPP20_DYNARRAY_CONSTEXPR size_type expand_list(std::initializer_list<Ty> init);
 
 		template<typename ... Args>
 		static CPP20_DYNARRAY_CONSTEXPR size_type expand_counts(size_type count, Args&& ... args);
 
-		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocator(const allocator_type &_allocator);
-
-		template<typename Skip>
-		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocators(const Skip &ignore, const allocator_type &_allocator);
-
 		template<typename ... Args>
 		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocator(const allocator_type &_allocator, Args&& ... args);
 
@@ -1877,11 +3100,7 @@ namespace vla
 		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ...Args>
 		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count, _Alloc_t &&other_allocator, Args&& ... args);
 
-		template<typename Ty>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list);
-
-		template<typename Ty, typename ... Args>
-		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list, Args&& ...args);
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<T> input_list);
 
 		template<typename Ty, typename ... Args>
 		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list,
@@ -1905,10 +3124,7 @@ namespace vla
 
 		CPP20_DYNARRAY_CONSTEXPR void loop_copy(const dynarray &other) noexcept;
 
-		CPP20_DYNARRAY_CONSTEXPR void loop_copy(std::initializer_list<internal_value_type> input_list) noexcept;
-
-		template<typename Ty>
-		CPP20_DYNARRAY_CONSTEXPR void loop_copy(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept;
+		CPP20_DYNARRAY_CONSTEXPR void loop_copy(std::initializer_list<T> input_list) noexcept;
 
 		CPP20_DYNARRAY_CONSTEXPR void move_array(dynarray &other) noexcept;
 
@@ -1916,742 +3132,4978 @@ namespace vla
 
 		CPP20_DYNARRAY_CONSTEXPR void swap_all(dynarray &other) noexcept;
 
-		CPP20_DYNARRAY_CONSTEXPR void swap_outside(dynarray &other) noexcept;
+		CPP20_DYNARRAY_CONSTEXPR void swap_outside(dynarray &other) noexcept;
+
+		template<typename U>
+		CPP20_DYNARRAY_CONSTEXPR bool same_shape(const dynarray<U, _Allocator> &other) const noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR bool equal_to(const dynarray &other) const;
+
+		CPP20_DYNARRAY_CONSTEXPR std::size_t hash_shape(std::size_t seed) const noexcept;
+
+		std::size_t hash_code() const;
+
+		friend struct std::hash<dynarray>;
+
+		template<typename Index>
+		dynarray<internal_value_type, _Allocator> gather_elements(const dynarray<Index, _Allocator> &indices) const;
+
+		template<typename Index>
+		CPP20_DYNARRAY_CONSTEXPR void scatter_elements(const dynarray<Index, _Allocator> &indices, const dynarray<internal_value_type, _Allocator> &values);
+
+		template<typename M>
+		dynarray<internal_value_type, _Allocator> select_elements(const dynarray<M, _Allocator> &mask) const;
+
+		template<typename M>
+		CPP20_DYNARRAY_CONSTEXPR void blend_elements(const dynarray<M, _Allocator> &mask, const dynarray &other);
+
+		CPP20_DYNARRAY_CONSTEXPR void copy_region_from(const size_type (&dst_origin)[dimensions], const dynarray &src, const size_type (&src_origin)[dimensions], const size_type (&region)[dimensions]);
+
+		CPP20_DYNARRAY_CONSTEXPR void fill_region_with(const size_type (&origin)[dimensions], const size_type (&region)[dimensions], const internal_value_type &value);
+
+		CPP20_DYNARRAY_CONSTEXPR bool get_extents(size_type *extents) const;
+
+		template<typename TaskRunner, typename BinaryOperation>
+		CPP20_DYNARRAY_CONSTEXPR void scan_along(const TaskRunner &run_tasks, size_type axis, BinaryOperation op, const internal_value_type *init);
+
+		CPP20_DYNARRAY_CONSTEXPR void count_nodes(std::uint64_t *totals) const noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void write_offsets(std::uint64_t **cursors) const noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void attach_nodes(internal_pointer_type block, const std::uint64_t *const *levels, std::uint64_t node);
+
+		internal_impl::binary_prefix make_binary_prefix() const;
+
+		void write_binary(std::ostream &output) const;
+
+		template<typename TaskRunner>
+		void write_compressed(const TaskRunner &run_tasks, std::ostream &output) const;
+
+		void write_delta(std::ostream &output, dirty_regions<T> &dirty) const;
+
+		void read_delta(std::istream &input);
+
+		std::string make_npy_header() const;
+		void write_npy(std::ostream &output) const;
+
+		template<bool Reading, typename Transfer, typename Step>
+		bool transfer_rows(Transfer &&transfer, size_type rows_per_step, Step &step);
+
+		template<typename Format, typename ReadBlock = internal_impl::read_raw_block>
+		void read_stream(std::istream &input, ReadBlock &&read_block = ReadBlock());
+
+		template<typename Format>
+		void attach_buffer(void *buffer, std::size_t length, const contiguous_allocator_type *owner);
+
+		template<typename Segment>
+		void attach_segments(const Segment *segments, std::size_t count);
+
+		void attach_block(internal_pointer_type block, const internal_impl::binary_shape &shape, const contiguous_allocator_type *owner);
+
+		void attach_extents(internal_pointer_type block, const size_type *extents, const contiguous_allocator_type *owner);
+
+		internal_pointer_type reshape_block(const size_type *extents, std::size_t rank) const;
+
+		template<typename Construct>
+		void construct_block(const size_type *extents, Construct construct_elements);
+
+		template<typename Result>
+		static Result join_arrays(const dynarray *const *arrays, size_type count, size_type axis, bool stacking);
+
+		std::vector<dynarray> split_array(size_type axis, size_type parts);
+
+		template<typename Generator, typename TaskRunner>
+		void generate_array(const size_type *extents, Generator &generator, const TaskRunner &run_tasks);
+
+
+		/**** Non-member functions  ***/
+
+		/*!
+		 * @brief Exchanges the contents of the container with those of other.
+		 *
+		 * If both of the containers are outter-most layer, they will be swapped completely, including sizes.
+		 *
+		 * Otherwise swap the contents only.
+		 *
+		 * @param lhs A dynarray
+		 * @param rhs Another dynarray
+		 * @return
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void swap(dynarray &lhs, dynarray &rhs) noexcept { lhs.swap_outside(rhs); }
+
+		/*!
+		 * @brief Replaces old_array with new_array and returns the old value of old_array.
+		 *
+		 * If old_array is an inner layer, exchange() will replaces the contents of the container only, the size of old_array will keeps unchanged.
+		 *
+		 * @param old_array Old array to be replaced
+		 * @param new_array New array replace with
+		 * @return The value of old_array
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR dynarray exchange(dynarray &old_array, dynarray &&new_array) noexcept
+		{
+			dynarray current_array = std::move(old_array);
+			if (old_array.entire_array_data == nullptr)
+			{
+				old_array.swap(new_array);
+			}
+			else
+			{
+				if (new_array.entire_array_data == nullptr)
+				{
+					dynarray temp_array = std::move(new_array);
+					old_array.swap_all(temp_array);
+				}
+				else
+				{
+					old_array.swap_all(new_array);
+				}
+			}
+			return current_array;
+		}
+
+		friend CPP20_DYNARRAY_CONSTEXPR bool operator==(const dynarray &lhs, const dynarray &rhs)
+		{
+			return lhs.equal_to(rhs);
+		}
+
+#ifdef DYNARRAY_USING_CPP20
+		friend CPP20_DYNARRAY_CONSTEXPR auto operator<=>(const dynarray &lhs, const dynarray &rhs)
+		{
+			if constexpr (internal_impl::is_bitwise_comparable_v<internal_value_type>)
+			{
+				size_type common_size = std::min(lhs.size(), rhs.size());
+				size_type position = internal_impl::mismatch_bitwise(lhs.this_level_array_head, rhs.this_level_array_head, common_size);
+				if (position < common_size)
+					return lhs.this_level_array_head[position] <=> rhs.this_level_array_head[position];
+				return lhs.size() <=> rhs.size();
+			}
+			else
+				return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+#else
+		friend bool operator!=(const dynarray &lhs, const dynarray &rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		friend bool operator<(const dynarray &lhs, const dynarray &rhs)
+		{
+			if constexpr (internal_impl::is_bitwise_comparable_v<internal_value_type>)
+			{
+				size_type common_size = std::min(lhs.size(), rhs.size());
+				size_type position = internal_impl::mismatch_bitwise(lhs.this_level_array_head, rhs.this_level_array_head, common_size);
+				if (position < common_size)
+					return lhs.this_level_array_head[position] < rhs.this_level_array_head[position];
+				return lhs.size() < rhs.size();
+			}
+			else
+				return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+		friend bool operator>(const dynarray &lhs, const dynarray &rhs)
+		{
+			return rhs < lhs;
+		}
+
+		friend bool operator<=(const dynarray &lhs, const dynarray &rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		friend bool operator>=(const dynarray &lhs, const dynarray &rhs)
+		{
+			return !(lhs < rhs);
+		}
+#endif
+
+		/*!
+		 * @brief Replaces the elements with their inclusive prefix sums along the given axis.
+		 *
+		 * Axis 0 is the outer-most dimension. The array must be rectangular, every row of the same layer must have the same size.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @exception std::out_of_range if axis is not less than the number of dimensions
+		 * @exception std::invalid_argument if arr is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void inclusive_scan(dynarray &arr, size_type axis)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, std::plus<>(), nullptr);
+		}
+
+		/*!
+		 * @brief Replaces the elements with their inclusive prefix results of op along the given axis.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param op Binary function object, applied as op(previous result, current element)
+		*/
+		template<typename BinaryOperation>
+		friend CPP20_DYNARRAY_CONSTEXPR void inclusive_scan(dynarray &arr, size_type axis, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, op, nullptr);
+		}
+
+		/*!
+		 * @brief Replaces the elements with their exclusive prefix sums along the given axis, the first element of each line becomes init.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param init The initial value
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void exclusive_scan(dynarray &arr, size_type axis, const internal_value_type &init)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, std::plus<>(), &init);
+		}
+
+		/*!
+		 * @brief Replaces the elements with their exclusive prefix results of op along the given axis, the first element of each line becomes init.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param init The initial value
+		 * @param op Binary function object, applied as op(previous result, current element)
+		*/
+		template<typename BinaryOperation>
+		friend CPP20_DYNARRAY_CONSTEXPR void exclusive_scan(dynarray &arr, size_type axis, const internal_value_type &init, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, op, &init);
+		}
+
+		/*!
+		 * @brief Same as inclusive_scan(arr, axis), tasks are executed according to policy.
+		 *
+		 * Include <execution> to use the policies. Like std::inclusive_scan with a policy, op must be associative.
+		 *
+		 * @param policy The execution policy to use
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		*/
+		template<typename ExecutionPolicy>
+		friend void inclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, std::plus<>(), nullptr);
+		}
+
+		template<typename ExecutionPolicy, typename BinaryOperation>
+		friend void inclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, op, nullptr);
+		}
+
+		/*!
+		 * @brief Same as exclusive_scan(arr, axis, init), tasks are executed according to policy.
+		 *
+		 * @param policy The execution policy to use
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param init The initial value
+		*/
+		template<typename ExecutionPolicy>
+		friend void exclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis, const internal_value_type &init)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, std::plus<>(), &init);
+		}
+
+		template<typename ExecutionPolicy, typename BinaryOperation>
+		friend void exclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis, const internal_value_type &init, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, op, &init);
+		}
+
+		/*!
+		 * @brief Collects elements at the given positions.
+		 *
+		 * Positions count the elements in row-major order, as if src were flattened.
+		 * All positions are verified in one pass first, then the elements are read without further checks.
+		 *
+		 * @param src The source array
+		 * @param indices Positions of the elements to collect
+		 * @return One-dimensional dynarray, the i-th element is the element of src at indices[i]
+		 * @exception std::out_of_range if any position is not less than the number of elements of src
+		*/
+		template<typename Index>
+		friend dynarray<internal_value_type, _Allocator> gather(const dynarray &src, const dynarray<Index, _Allocator> &indices)
+		{
+			return src.gather_elements(indices);
+		}
+
+		/*!
+		 * @brief Writes values to the given positions, the counterpart of gather().
+		 *
+		 * If a position appears more than once, the last value is kept.
+		 *
+		 * @param dst The destination array
+		 * @param indices Positions of the elements to be written, in row-major order
+		 * @param values Values to write, must have the same size as indices
+		 * @exception std::out_of_range if any position is not less than the number of elements of dst
+		 * @exception std::invalid_argument if the sizes of indices and values are different
+		*/
+		template<typename Index>
+		friend CPP20_DYNARRAY_CONSTEXPR void scatter(dynarray &dst, const dynarray<Index, _Allocator> &indices, const dynarray<internal_value_type, _Allocator> &values)
+		{
+			dst.scatter_elements(indices, values);
+		}
+
+		/*!
+		 * @brief Collects the elements whose corresponding mask elements are true, in row-major order.
+		 *
+		 * @param src The source array
+		 * @param mask Array of the same shape as src, elements are converted to bool
+		 * @return One-dimensional dynarray of the selected elements
+		 * @exception std::invalid_argument if the shapes of src and mask are different
+		*/
+		template<typename M>
+		friend dynarray<internal_value_type, _Allocator> select(const dynarray &src, const dynarray<M, _Allocator> &mask)
+		{
+			static_assert(static_cast<int>(internal_impl::inner_type<dynarray<M, _Allocator>, _Allocator>::nested_level) == static_cast<int>(internal_impl::inner_type<dynarray, _Allocator>::nested_level),
+				"mask must have the same number of dimensions");
+			return src.select_elements(mask);
+		}
+
+		/*!
+		 * @brief Chooses elements from lhs where mask is true, from rhs otherwise.
+		 *
+		 * @param mask Array of the same shape as lhs and rhs, elements are converted to bool
+		 * @param lhs Array providing the elements where mask is true
+		 * @param rhs Array providing the elements where mask is false
+		 * @return A new dynarray of the same shape
+		 * @exception std::invalid_argument if the shapes of the arrays are different
+		*/
+		template<typename M>
+		friend CPP20_DYNARRAY_CONSTEXPR dynarray where(const dynarray<M, _Allocator> &mask, const dynarray &lhs, const dynarray &rhs)
+		{
+			static_assert(static_cast<int>(internal_impl::inner_type<dynarray<M, _Allocator>, _Allocator>::nested_level) == static_cast<int>(internal_impl::inner_type<dynarray, _Allocator>::nested_level),
+				"mask must have the same number of dimensions");
+			dynarray result(lhs);
+			result.blend_elements(mask, rhs);
+			return result;
+		}
+
+		/*!
+		 * @brief Copies a rectangular region of src into dst.
+		 *
+		 * Both arrays must be rectangular. Each contiguous run of the region is copied at once,
+		 * when the region covers whole rows (or whole planes, etc.) of both arrays, the runs merge into larger blocks.
+		 * dst and src may be the same array, overlapping regions are handled.
+		 *
+		 * @param dst The destination array
+		 * @param dst_origin Position of the region in dst, one index for each dimension
+		 * @param src The source array
+		 * @param src_origin Position of the region in src, one index for each dimension
+		 * @param extents Size of the region, one size for each dimension
+		 * @exception std::out_of_range if the region exceeds dst or src
+		 * @exception std::invalid_argument if dst or src is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void copy_region(dynarray &dst, const size_type (&dst_origin)[dimensions],
+		                                                 const dynarray &src, const size_type (&src_origin)[dimensions], const size_type (&extents)[dimensions])
+		{
+			dst.copy_region_from(dst_origin, src, src_origin, extents);
+		}
+
+		/*!
+		 * @brief Joins two arrays along an existing axis, the other extents of both arrays must be equal.
+		 *
+		 * The result is allocated once. For every index in front of axis, the contiguous part of each array is copied at once.
+		 *
+		 * @param lhs The first array
+		 * @param rhs The second array
+		 * @param axis The dimension to join along
+		 * @return The joined array
+		 * @exception std::out_of_range if axis is not a dimension of the arrays
+		 * @exception std::invalid_argument if an array is not rectangular, or the shapes do not match
+		*/
+		friend dynarray concat(const dynarray &lhs, const dynarray &rhs, size_type axis)
+		{
+			const dynarray *arrays[2] = { &lhs, &rhs };
+			return join_arrays<dynarray>(arrays, 2, axis, false);
+		}
+
+		/*!
+		 * @brief Same as above, joins every array of [first, last).
+		*/
+		template<typename InputIterator, typename = std::enable_if_t<std::is_same_v<std::decay_t<decltype(*std::declval<InputIterator&>())>, dynarray>>>
+		friend dynarray concat(InputIterator first, InputIterator last, size_type axis)
+		{
+			std::vector<const dynarray *> arrays;
+			for (; first != last; ++first)
+				arrays.push_back(std::addressof(*first));
+			return join_arrays<dynarray>(arrays.data(), arrays.size(), axis, false);
+		}
+
+		/*!
+		 * @brief Stacks arrays of the same shape along a new dimension, which is inserted in front of axis.\n
+		 * Example: std::vector<dynarray<float>> samples; dynarray<dynarray<float>> batch = stack(samples.begin(), samples.end(), 0);
+		 *
+		 * The result is allocated once and filled the same way as concat.
+		 *
+		 * @param first Iterator to the first array
+		 * @param last End of the arrays
+		 * @param axis Position of the new dimension, from 0 to the number of dimensions of the arrays
+		 * @return The stacked array, with one dimension more
+		 * @exception std::out_of_range if axis is too large
+		 * @exception std::invalid_argument if [first, last) is empty, an array is not rectangular, or the shapes do not match
+		*/
+		template<typename InputIterator, typename = std::enable_if_t<std::is_same_v<std::decay_t<decltype(*std::declval<InputIterator&>())>, dynarray>>>
+		friend dynarray<dynarray, _Allocator> stack(InputIterator first, InputIterator last, size_type axis)
+		{
+			std::vector<const dynarray *> arrays;
+			for (; first != last; ++first)
+				arrays.push_back(std::addressof(*first));
+			return join_arrays<dynarray<dynarray, _Allocator>>(arrays.data(), arrays.size(), axis, true);
+		}
+
+		/*!
+		 * @brief Splits an array into equal parts along an axis.
+		 *
+		 * If every extent in front of axis is 1 (e.g. axis 0), each part is contiguous in the block of arr and is returned as a view,
+		 * arr has to outlive the parts. Otherwise each part is a copy, allocated once and filled with one copy per contiguous run.
+		 *
+		 * @param arr The array to split
+		 * @param axis The dimension to split along
+		 * @param parts Number of parts, it has to divide the extent of axis
+		 * @return The parts in order
+		 * @exception std::out_of_range if axis is not a dimension of arr
+		 * @exception std::invalid_argument if arr is not rectangular, or the extent of axis cannot be divided by parts
+		*/
+		friend std::vector<dynarray> split(dynarray &arr, size_type axis, size_type parts) { return arr.split_array(axis, parts); }
+
+		/*!
+		 * @brief Assigns value to every element of a rectangular region of dst.
+		 *
+		 * @param dst The array to be filled
+		 * @param origin Position of the region, one index for each dimension
+		 * @param extents Size of the region, one size for each dimension
+		 * @param value The value to be assigned
+		 * @exception std::out_of_range if the region exceeds dst
+		 * @exception std::invalid_argument if dst is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void fill_region(dynarray &dst, const size_type (&origin)[dimensions], const size_type (&extents)[dimensions], const internal_value_type &value)
+		{
+			dst.fill_region_with(origin, extents, value);
+		}
+
+		/*!
+		 * @brief Writes a dynarray to a binary stream.
+		 *
+		 * The header records rank, extents, element type, byte order and alignment. A jagged array stores an offset table after it.
+		 * The contiguous block follows at a 64-byte aligned offset, and is written with a single write.
+		 * Elements must be trivially copyable.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		*/
+		friend std::ostream& save_binary(std::ostream &output, const dynarray &input)
+		{
+			input.write_binary(output);
+			return output;
+		}
+
+		/*!
+		 * @brief Reads a dynarray written by save_binary, the contiguous block is read with a single read.
+		 *
+		 * output is left unchanged if input runs out, check the state of input.
+		 * If output is an inner layer, only the values are replaced, the same way as operator=.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, or does not match the rank or the element type of output
+		*/
+		friend std::istream& load_binary(std::istream &input, dynarray &output)
+		{
+			output.read_stream<internal_impl::binary_format>(input);
+			return input;
+		}
+
+		/*!
+		 * @brief Turns output into a view of data written by save_binary, without copying the elements.
+		 *
+		 * Only the nodes are allocated, the elements stay in buffer, which has to outlive output.
+		 * output does not own buffer, like an inner layer: moving it out copies the elements into a new array.
+		 * Any buffer aligned to 64 bytes, such as a mapped file, keeps the elements suitably aligned.
+		 *
+		 * @param buffer Data written by save_binary
+		 * @param length Size of buffer in bytes
+		 * @param output The array to become a view, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void view_binary(void *buffer, std::size_t length, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::binary_format>(buffer, length, nullptr);
+		}
+
+		/*!
+		 * @brief Same as view_binary, but output also takes over the contiguous block.
+		 *
+		 * The block (at buffer + block offset) will be released with owner.deallocate(block, element count), and elements are not destroyed before that.
+		 * This lets an allocator hand in storage it did not allocate itself, such as a memory-mapped file.
+		 * If the data holds no elements, output becomes empty and the block stays with the caller.
+		 *
+		 * @param buffer Data written by save_binary
+		 * @param length Size of buffer in bytes
+		 * @param owner Allocator that releases the block, it replaces the allocator of output
+		 * @param output The array to take over the block, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void adopt_binary(void *buffer, std::size_t length, const contiguous_allocator_type &owner, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::binary_format>(buffer, length, &owner);
+		}
+
+		/*!
+		 * @brief Describes input in the binary format as two segments for writev or sendmsg, the elements are not copied.
+		 *
+		 * segments[0] refers to the returned header, the same bytes as save_binary writes in front of the elements,
+		 * offset tables of a jagged array included. segments[1] refers to the contiguous block shared by all nodes of input.
+		 * Keep the returned header alive, and input unchanged, until the data has been sent.
+		 *
+		 * @param input The array to be sent
+		 * @param segments Receives the two segments, struct iovec or any type with iov_base and iov_len
+		 * @return Storage of the header
+		*/
+		template<typename Segment>
+		friend std::unique_ptr<char[]> to_iovecs(const dynarray &input, Segment (&segments)[2])
+		{
+			static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
+			internal_impl::binary_prefix prefix = input.make_binary_prefix();
+			segments[0].iov_base = prefix.bytes.get();
+			segments[0].iov_len = prefix.length;
+			segments[1].iov_base = input.this_level_array_head;
+			segments[1].iov_len = input.get_element_count() * sizeof(internal_value_type);
+			return std::move(prefix.bytes);
+		}
+
+		/*!
+		 * @brief Turns output into a view of data received into segments, such as the buffers filled by readv or recvmsg.
+		 *
+		 * segments[0] starts with the header produced by to_iovecs or save_binary. The elements follow it in the same segment,
+		 * or fill segments[1] if segments[0] ends at the block offset. The elements are not copied: the same as view_binary,
+		 * output does not own the buffers, which have to outlive it.
+		 *
+		 * @param segments Received data, struct iovec or any type with iov_base and iov_len
+		 * @param count Number of segments
+		 * @param output The array to become a view, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		template<typename Segment>
+		friend void from_iovecs(const Segment *segments, std::size_t count, dynarray &output)
+		{
+			output.attach_segments(segments, count);
+		}
+
+		/*!
+		 * @brief Writes a dynarray in the binary format with the contiguous block compressed, for checkpoints of large arrays.
+		 *
+		 * The block is split into chunks of about 1 MiB. The bytes of each chunk are shuffled (byte k of every element grouped together,
+		 * which turns the exponents of floating point grids into long runs) and then compressed with a fast LZ77 codec.
+		 * A chunk which does not shrink is stored as it is. Every chunk can be decompressed independently.
+		 * Elements must be trivially copyable.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		*/
+		friend std::ostream& save_compressed(std::ostream &output, const dynarray &input)
+		{
+			input.write_compressed(internal_impl::sequenced_tasks(), output);
+			return output;
+		}
+
+		/*!
+		 * @brief Same as save_compressed(output, input), the chunks are compressed according to policy.
+		 *
+		 * Include <execution> to use the policies.
+		 *
+		 * @param policy The execution policy to use
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		*/
+		template<typename ExecutionPolicy>
+		friend std::ostream& save_compressed(ExecutionPolicy &&policy, std::ostream &output, const dynarray &input)
+		{
+			input.write_compressed(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, output);
+			return output;
+		}
+
+		/*!
+		 * @brief Reads a dynarray written by save_compressed, the chunks are decompressed straight into the contiguous block.
+		 *
+		 * output is left unchanged if input runs out, check the state of input.
+		 * If output is an inner layer, only the values are replaced, the same way as operator=.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, or does not match the rank or the element type of output
+		*/
+		friend std::istream& load_compressed(std::istream &input, dynarray &output)
+		{
+			output.read_stream<internal_impl::compressed_format>(input, [](std::istream &source, auto *block, std::size_t count)
+				{ return internal_impl::read_compressed_block(internal_impl::sequenced_tasks(), source, block, count); });
+			return input;
+		}
+
+		/*!
+		 * @brief Same as load_compressed(input, output), the chunks are decompressed according to policy.
+		 *
+		 * Include <execution> to use the policies.
+		 *
+		 * @param policy The execution policy to use
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		*/
+		template<typename ExecutionPolicy>
+		friend std::istream& load_compressed(ExecutionPolicy &&policy, std::istream &input, dynarray &output)
+		{
+			internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>> run_tasks{ policy };
+			output.read_stream<internal_impl::compressed_format>(input, [&run_tasks](std::istream &source, auto *block, std::size_t count)
+				{ return internal_impl::read_compressed_block(run_tasks, source, block, count); });
+			return input;
+		}
+
+		/*!
+		 * @brief Starts recording writes to the contiguous block of array, see dirty_regions.
+		 *
+		 * The record refers to the current block, it becomes invalid once array is resized, moved from, or destroyed.
+		 *
+		 * @param array The array to be tracked
+		 * @param chunk_elements Number of elements covered by each bit, elements covering 64 KiB by default
+		 * @return An empty bitmap
+		*/
+		friend dirty_regions<T> track_dirty(dynarray &array, std::size_t chunk_elements = std::max<std::size_t>(1, internal_impl::dirty_chunk_length / sizeof(T)))
+		{
+			return dirty_regions<T>(array.this_level_array_head, array.get_element_count(), chunk_elements);
+		}
+
+		/*!
+		 * @brief Writes only the chunks of input marked in dirty, each run of dirty chunks with a single write, and then clears dirty.
+		 *
+		 * Starting from a full checkpoint written by save_binary, load_delta of every delta in order restores input.
+		 * The header is the same as save_binary writes, so load_delta checks the shape and the element type.
+		 * input must not be written while the delta is being saved.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @param dirty Created by track_dirty(input)
+		 * @return output
+		 * @exception std::invalid_argument if dirty does not belong to input
+		*/
+		friend std::ostream& save_delta(std::ostream &output, const dynarray &input, dirty_regions<T> &dirty)
+		{
+			input.write_delta(output, dirty);
+			return output;
+		}
+
+		/*!
+		 * @brief Applies a delta written by save_delta to output in place, the chunks are read straight into the contiguous block.
+		 *
+		 * output must have the same shape as the array which was saved. If input runs out, output may have been partly updated,
+		 * check the state of input.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be updated
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, or does not match the shape or the element type of output
+		*/
+		friend std::istream& load_delta(std::istream &input, dynarray &output)
+		{
+			output.read_delta(input);
+			return input;
+		}
+
+		/*!
+		 * @brief Writes a rectangular dynarray as a NumPy .npy file (C order), the contiguous block is written with a single write.
+		 *
+		 * The file can be opened by numpy.load, including with mmap_mode, since the data starts at a 64-byte aligned offset.
+		 * Elements must be of an arithmetic type.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		 * @exception std::invalid_argument if input is jagged
+		*/
+		friend std::ostream& save_npy(std::ostream &output, const dynarray &input)
+		{
+			input.write_npy(output);
+			return output;
+		}
+
+		/*!
+		 * @brief Reads a NumPy .npy file in C order with the same element type and number of dimensions, the same way as load_binary.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, in Fortran order, or does not match the rank or the element type of output
+		*/
+		friend std::istream& load_npy(std::istream &input, dynarray &output)
+		{
+			output.read_stream<internal_impl::npy_format>(input);
+			return input;
+		}
+
+		/*!
+		 * @brief Turns output into a view of a NumPy .npy file in memory, the same way as view_binary.
+		 *
+		 * @param buffer Content of the .npy file
+		 * @param length Size of buffer in bytes
+		 * @param output The array to become a view, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void view_npy(void *buffer, std::size_t length, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::npy_format>(buffer, length, nullptr);
+		}
+
+		/*!
+		 * @brief Same as view_npy, but output also takes over the contiguous block, the same way as adopt_binary.
+		 *
+		 * @param buffer Content of the .npy file
+		 * @param length Size of buffer in bytes
+		 * @param owner Allocator that releases the block, it replaces the allocator of output
+		 * @param output The array to take over the block, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void adopt_npy(void *buffer, std::size_t length, const contiguous_allocator_type &owner, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::npy_format>(buffer, length, &owner);
+		}
+
+		/*!
+		 * @brief Reads the elements of output from source, rows_per_step elements at a time, straight into the storage of output.
+		 *
+		 * The elements are read in the order of the contiguous block, output must already have its final shape.
+		 * Each group is handed to process(first_row, last_row) as soon as it has arrived, while the next group is being read asynchronously.
+		 * No intermediate buffer is used.
+		 *
+		 * @param source A std::streambuf, or read_bytes(bytes, length) returning false on failure, such as a wrapper of ::read
+		 * @param output The array to be filled
+		 * @param rows_per_step Number of elements read at a time
+		 * @param process Called on the calling thread with the range [first_row, last_row)
+		 * @return false if source runs out or fails
+		 * @exception std::invalid_argument if rows_per_step is 0
+		*/
+		template<typename Source, typename RowFunction>
+		friend bool read_rows(Source &&source, dynarray &output, size_type rows_per_step, RowFunction &&process)
+		{
+			static_assert(std::is_trivially_copyable_v<internal_value_type>, "streaming requires trivially copyable elements");
+			return output.transfer_rows<true>(internal_impl::byte_transfer<true>(source), rows_per_step, process);
+		}
+
+		/*!
+		 * @brief Writes the elements of input to sink, rows_per_step elements at a time, straight from the storage of input.
+		 *
+		 * Each group is first passed to produce(first_row, last_row), which may fill it, and then written asynchronously
+		 * while produce works on the next group. No second copy of the array is made.
+		 *
+		 * @param sink A std::streambuf, or write_bytes(bytes, length) returning false on failure, such as a wrapper of ::write
+		 * @param input The array to be written
+		 * @param rows_per_step Number of elements written at a time
+		 * @param produce Called on the calling thread with the range [first_row, last_row)
+		 * @return false if sink fails
+		 * @exception std::invalid_argument if rows_per_step is 0
+		*/
+		template<typename Sink, typename RowFunction>
+		friend bool write_rows(Sink &&sink, dynarray &input, size_type rows_per_step, RowFunction &&produce)
+		{
+			static_assert(std::is_trivially_copyable_v<internal_value_type>, "streaming requires trivially copyable elements");
+			return input.transfer_rows<false>(internal_impl::byte_transfer<false>(sink), rows_per_step, produce);
+		}
+	};
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::size_type
+		dynarray<T, _Allocator>::expand_list(std::initializer_list<Ty> init)
+	{
+		return init.size();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::size_type
+		dynarray<T, _Allocator>::expand_counts(size_type count, Args && ...args)
+	{
+		return count;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::contiguous_allocator_type
+		dynarray<T, _Allocator>::expand_allocator(const allocator_type &_allocator, Args && ...args)
+	{
+		return _allocator;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Skip, typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::contiguous_allocator_type
+		dynarray<T, _Allocator>::expand_allocators(const Skip &skip, const allocator_type &_allocator, Args && ...args)
+	{
+		return _allocator;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::initialise(const allocator_type &other_allocator)
+	{
+		contiguous_allocator = other_allocator;
+		reset();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::reset()
+	{
+		entire_array_data = nullptr;
+		this_level_array_head = nullptr;
+		this_level_array_tail = nullptr;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::verify_size(size_type count)
+	{
+		if (count > static_cast<size_type>(std::numeric_limits<difference_type>::max()))
+			throw std::length_error("array too long");
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(size_type count)
+	{
+		if (count == 0)
+		{
+			reset();
+			return;
+		}
+
+		verify_size(count);
+		entire_array_data = contiguous_allocator.allocate(count);
+		for (size_type i = 0; i < count; ++i)
+			std::allocator_traits<allocator_type>::construct(contiguous_allocator, entire_array_data + i);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count)
+	{
+		// reached the innermost layer
+		if (std::is_same_v<T, internal_value_type>)
+		{
+			entire_array_data = nullptr;	// always nullptr in nested-dynarray
+
+			for (size_type i = 0; i < count; ++i)
+				std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, starting_address + i);
+
+			this_level_array_head = starting_address;
+			this_level_array_tail = this_level_array_head + count - 1;
+		}
+		else reset();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(size_type count, Args&& ...args)
+	{
+		verify_size(count);
+
+		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
+		if (nested_level > sizeof...(args) || count == 0)
+		{
+			reset();
+			return;
+		}
+
+		entire_array_data = contiguous_allocator.allocate(count);
+
+		for (size_type i = 0; i < count; ++i)
+			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::forward<Args>(args)...);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count, Args&& ... args)
+	{
+		entire_array_data = nullptr;	// always nullptr in nested-dynarray
+
+		for (size_type i = 0; i < count; ++i)
+			std::allocator_traits<allocator_type>::construct(contiguous_allocator, starting_address + i, std::forward<Args>(args)...);
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename _Alloc_t, typename, typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(size_type count, _Alloc_t &&other_allocator, Args&& ... args)
+	{
+		verify_size(count);
+
+		size_type entire_array_size = count;
+		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
+		if (nested_level * 2 > sizeof...(args) || entire_array_size == 0)
+		{
+			reset();
+			return;
+		}
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+
+		for (size_type i = 0; i < entire_array_size; ++i)
+			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::forward<Args>(args)...);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename _Alloc_t, typename, typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count, _Alloc_t &&other_allocator, Args&& ... args)
+	{
+		entire_array_data = nullptr;	// always nullptr in nested-dynarray
+		contiguous_allocator = other_allocator;
+
+		for (size_type i = 0; i < count; ++i)
+			std::allocator_traits<allocator_type>::construct(contiguous_allocator, starting_address + i, std::forward<Args>(args)...);
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(std::initializer_list<T> input_list)
+	{
+		size_type count = input_list.size();
+		if (count == 0) return;
+		verify_size(count);
+		entire_array_data = contiguous_allocator.allocate(count);
+		internal_impl::copy_construct_block(contiguous_allocator, entire_array_data, input_list.begin(), count);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty, typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list,
+			const allocator_type &other_allocator, Args&& ...args)
+	{
+		contiguous_allocator = other_allocator;
+		size_type count = input_list.size();
+		verify_size(count);
+		entire_array_data = nullptr;
+
+		auto list_iter = input_list.begin();
+		for (size_type i = 0; i < count; ++i, ++list_iter)
+			std::allocator_traits<allocator_type>::construct(contiguous_allocator, starting_address + i, *list_iter);
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::deallocate_array()
+	{
+		size_type entire_array_size = static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		if (entire_array_data)
+		{
+			for (size_type i = entire_array_size; i != 0; --i)
+				std::allocator_traits<allocator_type>::destroy(contiguous_allocator, entire_array_data + i - 1);
+			contiguous_allocator.deallocate(entire_array_data, entire_array_size);
+			entire_array_data = nullptr;
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::copy_array(const dynarray &other)
+	{
+		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+		if (entire_array_size == 0) return;
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
+		internal_impl::copy_construct_block(contiguous_allocator, entire_array_data, other_array_data, entire_array_size);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::copy_array(const dynarray &other, const allocator_type &other_allocator, Args&&... args)
+	{
+		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+		if (entire_array_size == 0) return;
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
+		internal_impl::copy_construct_block(contiguous_allocator, entire_array_data, other_array_data, entire_array_size);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other)
+	{
+		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+		entire_array_data = nullptr;
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other, const allocator_type &other_allocator, Args&& ... args)
+	{
+		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+		contiguous_allocator = other_allocator;
+		entire_array_data = nullptr;
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename InputIterator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::copy_array(InputIterator other_begin, InputIterator other_end)
+	{
+		static_assert(std::is_same_v<std::decay_t<decltype(*other_begin)>, T> ||
+			std::is_convertible_v<T, internal_value_type>,
+			"invalid iterator, cannot convert to a valid dynarray");
+
+		size_type count = static_cast<size_type>(std::abs(other_end - other_begin));
+		if (count == 0) return;
+
+		entire_array_data = contiguous_allocator.allocate(count);
+
+		internal_impl::copy_construct_range(contiguous_allocator, entire_array_data, other_begin, count);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::loop_copy(const dynarray &other) noexcept
+	{
+		if (size() == 0 || other.size() == 0) return;
+
+		difference_type length = std::min<difference_type>(this_level_array_tail - this_level_array_head + 1,
+			other.this_level_array_tail - other.this_level_array_head + 1);
+		for (difference_type i = 0; i < length; ++i)
+			*(this_level_array_head + i) = *(other.this_level_array_head + i);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::loop_copy(std::initializer_list<T> input_list) noexcept
+	{
+		size_type count = input_list.size();
+		if (size() == 0 || count == 0) return;
+
+		auto list_iter = input_list.begin();
+		size_type length = static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		for (size_type i = 0; i < count && i < length; ++i, ++list_iter)
+			*(this_level_array_head + i) = *list_iter;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::move_array(dynarray &other) noexcept
+	{
+		if (other.empty())
+		{
+			initialise();
+			return;
+		}
+
+		if (other.entire_array_data == nullptr)
+		{
+			initialise();
+
+			size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+			if (entire_array_size == 0) return;
+
+			entire_array_data = contiguous_allocator.allocate(entire_array_size);
+			internal_pointer_type other_array_data = other.this_level_array_head;
+			for (size_type i = 0; i < entire_array_size; ++i)
+				std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::move(*(other_array_data + i)));
+
+			this_level_array_head = entire_array_data;
+			this_level_array_tail = this_level_array_head + entire_array_size - 1;
+		}
+		else
+		{
+			contiguous_allocator = other.contiguous_allocator;
+			entire_array_data = other.entire_array_data;
+			this_level_array_head = other.this_level_array_head;
+			this_level_array_tail = other.this_level_array_tail;
+			other.reset();
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::move_values(dynarray &other) noexcept
+	{
+		if (size() == 0 || other.size() == 0) return;
+
+		difference_type length = std::min<difference_type>(this_level_array_tail - this_level_array_head + 1,
+			other.this_level_array_tail - other.this_level_array_head + 1);
+		for (difference_type i = 0; i < length; ++i)
+			*(this_level_array_head + i) = std::move(*(other.this_level_array_head + i));
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::swap_all(dynarray &other) noexcept
+	{
+		std::swap(entire_array_data, other.entire_array_data);
+		std::swap(this_level_array_head, other.this_level_array_head);
+		std::swap(this_level_array_tail, other.this_level_array_tail);
+		std::swap(contiguous_allocator, other.contiguous_allocator);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::swap_outside(dynarray &other) noexcept
+	{
+		if (entire_array_data == nullptr || other.entire_array_data == nullptr)
+			swap(other);
+		else
+			swap_all(other);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
+		dynarray<T, _Allocator>::at(size_type pos)
+	{
+		if (pos >= size())
+			throw std::out_of_range("out of range, incorrect position");
+		return (*this)[pos];
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
+		dynarray<T, _Allocator>::at(size_type pos) const
+	{
+		if (pos >= size())
+			throw std::out_of_range("out of range, incorrect position");
+		return (*this)[pos];
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
+		dynarray<T, _Allocator>::operator[](size_type pos)
+	{
+		return *(this_level_array_head + pos);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
+		dynarray<T, _Allocator>::operator[](size_type pos) const
+	{
+		return *(this_level_array_head + pos);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
+		dynarray<T, _Allocator>::back()
+	{
+		return *(this_level_array_tail);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
+		dynarray<T, _Allocator>::back() const
+	{
+		return *(this_level_array_tail);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::swap(dynarray &other) noexcept
+	{
+		internal_impl::swap_block(this_level_array_head, other.this_level_array_head, std::min(size(), other.size()));
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::fill(const internal_value_type &value)
+	{
+		for (auto current_address = this_level_array_head;
+			current_address != this_level_array_tail + 1;
+			++current_address)
+			*current_address = value;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR bool
+		dynarray<T, _Allocator>::get_extents(size_type *extents) const
+	{
+		extents[0] = size();
+		return true;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename TaskRunner, typename BinaryOperation>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::scan_along(const TaskRunner &run_tasks, size_type axis, BinaryOperation op, const internal_value_type *init)
+	{
+		if (axis >= 1)
+			throw std::out_of_range("out of range, incorrect axis");
+
+		size_type extents[1] = { size() };
+		internal_impl::scan_along_axis(this_level_array_head, extents, 1, axis, op, init, run_tasks);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename U>
+	inline CPP20_DYNARRAY_CONSTEXPR bool
+		dynarray<T, _Allocator>::same_shape(const dynarray<U, _Allocator> &other) const noexcept
+	{
+		return size() == other.size();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR bool
+		dynarray<T, _Allocator>::equal_to(const dynarray &other) const
+	{
+		if constexpr (internal_impl::is_bitwise_comparable_v<internal_value_type>)
+			return size() == other.size() && internal_impl::equal_bitwise(this_level_array_head, other.this_level_array_head, size());
+		else
+			return std::equal(begin(), end(), other.begin(), other.end());
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR std::size_t
+		dynarray<T, _Allocator>::hash_shape(std::size_t seed) const noexcept
+	{
+		return internal_impl::hash_combine(seed, size());
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::size_t
+		dynarray<T, _Allocator>::hash_code() const
+	{
+		std::size_t seed = hash_shape(0);
+		size_type count = get_element_count();
+		if constexpr (std::has_unique_object_representations_v<internal_value_type>)
+			return internal_impl::hash_combine(seed, static_cast<std::size_t>(internal_impl::hash_bytes(this_level_array_head, count * sizeof(internal_value_type), seed)));
+		else
+		{
+			std::hash<internal_value_type> element_hash;
+			for (size_type i = 0; i < count; ++i)
+				seed = internal_impl::hash_combine(seed, element_hash(this_level_array_head[i]));
+			return seed;
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Index>
+	inline dynarray<typename dynarray<T, _Allocator>::internal_value_type, _Allocator>
+		dynarray<T, _Allocator>::gather_elements(const dynarray<Index, _Allocator> &indices) const
+	{
+		size_type count = indices.size();
+		internal_impl::verify_indices(indices.this_level_array_head, count, get_element_count());
+		const Index *positions = indices.this_level_array_head;
+		auto gathered = [this, positions](size_type i) -> const internal_value_type & { return this_level_array_head[positions[i]]; };
+
+		dynarray<internal_value_type, _Allocator> result;
+		const size_type extents[1] = { count };
+		result.construct_block(extents, [&](auto block, size_type constructing)
+		{
+			internal_impl::generate_elements<1>(result.contiguous_allocator, block, extents, 0, constructing, gathered);
+		});
+		return result;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Index>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::scatter_elements(const dynarray<Index, _Allocator> &indices, const dynarray<internal_value_type, _Allocator> &values)
+	{
+		size_type count = indices.size();
+		if (values.size() != count)
+			throw std::invalid_argument("sizes of indices and values do not match");
+
+		internal_impl::verify_indices(indices.this_level_array_head, count, get_element_count());
+		for (size_type i = 0; i < count; ++i)
+			this_level_array_head[indices.this_level_array_head[i]] = values.this_level_array_head[i];
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename M>
+	inline dynarray<typename dynarray<T, _Allocator>::internal_value_type, _Allocator>
+		dynarray<T, _Allocator>::select_elements(const dynarray<M, _Allocator> &mask) const
+	{
+		if (!same_shape(mask))
+			throw std::invalid_argument("shapes of dynarray and mask do not match");
+
+		size_type count = get_element_count();
+		size_type selected_count = 0;
+		for (size_type i = 0; i < count; ++i)
+			selected_count += static_cast<bool>(mask.this_level_array_head[i]) ? 1 : 0;
+
+		// called in order, each call returns the next selected element
+		size_type next = 0;
+		auto selected = [this, &mask, &next](size_type) -> const internal_value_type &
+		{
+			while (!static_cast<bool>(mask.this_level_array_head[next]))
+				++next;
+			return this_level_array_head[next++];
+		};
+
+		dynarray<internal_value_type, _Allocator> result;
+		const size_type extents[1] = { selected_count };
+		result.construct_block(extents, [&](auto block, size_type constructing)
+		{
+			internal_impl::generate_elements<1>(result.contiguous_allocator, block, extents, 0, constructing, selected);
+		});
+		return result;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename M>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::blend_elements(const dynarray<M, _Allocator> &mask, const dynarray &other)
+	{
+		if (!same_shape(mask) || !same_shape(other))
+			throw std::invalid_argument("shapes of dynarray and mask do not match");
+
+		size_type count = get_element_count();
+		for (size_type i = 0; i < count; ++i)
+			this_level_array_head[i] = static_cast<bool>(mask.this_level_array_head[i]) ? this_level_array_head[i] : other.this_level_array_head[i];
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::copy_region_from(const size_type (&dst_origin)[dimensions], const dynarray &src, const size_type (&src_origin)[dimensions], const size_type (&region)[dimensions])
+	{
+		size_type dst_extents[dimensions] = {};
+		size_type src_extents[dimensions] = {};
+		if (!get_extents(dst_extents) || !src.get_extents(src_extents))
+			throw std::invalid_argument("dynarray is not rectangular");
+
+		internal_impl::verify_region(dst_extents, dst_origin, region, dimensions);
+		internal_impl::verify_region(src_extents, src_origin, region, dimensions);
+		internal_impl::copy_box<dimensions>(this_level_array_head, dst_extents, dst_origin, src.this_level_array_head, src_extents, src_origin, region);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::fill_region_with(const size_type (&origin)[dimensions], const size_type (&region)[dimensions], const internal_value_type &value)
+	{
+		size_type extents[dimensions] = {};
+		if (!get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
+
+		internal_impl::verify_region(extents, origin, region, dimensions);
+		internal_impl::fill_box<dimensions>(this_level_array_head, extents, origin, region, value);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::count_nodes(std::uint64_t *totals) const noexcept
+	{
+		totals[0] += get_element_count();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::write_offsets(std::uint64_t **cursors) const noexcept
+	{
+		*cursors[0] = cursors[0][-1] + get_element_count();
+		++cursors[0];
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<T, _Allocator>::attach_nodes(internal_pointer_type block, const std::uint64_t *const *levels, std::uint64_t node)
+	{
+		this_level_array_head = block + levels[0][node];
+		this_level_array_tail = block + levels[0][node + 1] - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline internal_impl::binary_prefix
+		dynarray<T, _Allocator>::make_binary_prefix() const
+	{
+		std::uint64_t counts[1] = { get_element_count() };
+		return internal_impl::make_binary_prefix<T>(1, counts, nullptr, 0, counts[0]);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<T, _Allocator>::write_binary(std::ostream &output) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::write_binary_data(output, make_binary_prefix(), this_level_array_head, get_element_count());
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename TaskRunner>
+	inline void
+		dynarray<T, _Allocator>::write_compressed(const TaskRunner &run_tasks, std::ostream &output) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::write_compressed_data(run_tasks, output, make_binary_prefix(), this_level_array_head, get_element_count());
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<T, _Allocator>::write_delta(std::ostream &output, dirty_regions<T> &dirty) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::write_delta_data(output, make_binary_prefix(), this_level_array_head, get_element_count(), dirty);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<T, _Allocator>::read_delta(std::istream &input)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::read_delta_data(input, make_binary_prefix(), this_level_array_head, get_element_count());
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::string
+		dynarray<T, _Allocator>::make_npy_header() const
+	{
+		std::uint64_t counts[1] = { get_element_count() };
+		return internal_impl::npy_header(internal_impl::npy_descr<internal_value_type>(), counts, 1);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<T, _Allocator>::write_npy(std::ostream &output) const
+	{
+		internal_impl::write_npy_data(output, make_npy_header(), this_level_array_head, get_element_count());
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<bool Reading, typename Transfer, typename Step>
+	inline bool
+		dynarray<T, _Allocator>::transfer_rows(Transfer &&transfer, size_type rows_per_step, Step &step)
+	{
+		return internal_impl::stream_rows<Reading>(this_level_array_head, get_element_count(), rows_per_step,
+			[](size_type) { return size_type(1); }, std::forward<Transfer>(transfer), step);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Format, typename ReadBlock>
+	inline void
+		dynarray<T, _Allocator>::read_stream(std::istream &input, ReadBlock &&read_block)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::binary_shape shape = {};
+		if (!Format::template read_shape<T>(internal_impl::stream_reader{ input }, 1, shape) ||
+			!input.ignore(static_cast<std::streamsize>(shape.header.block_offset - shape.prefix_length)))
+			return;
+
+		dynarray loaded;
+		loaded.initialise(contiguous_allocator);
+
+		size_type entire_array_size = static_cast<size_type>(shape.header.element_count);
+		if (entire_array_size > 0)
+		{
+			verify_size(entire_array_size);
+			internal_pointer_type block = loaded.contiguous_allocator.allocate(entire_array_size);
+			loaded.entire_array_data = loaded.this_level_array_head = block;
+			loaded.this_level_array_tail = block + entire_array_size - 1;
+			if (!read_block(input, block, entire_array_size))
+				return;
+
+			loaded.attach_nodes(block, shape.levels.get(), 0);
+		}
+		else
+		{
+			// the block of save_compressed still has its compressed_header when it is empty
+			if (!read_block(input, internal_pointer_type(), entire_array_size))
+				return;
+		}
+
+		if (entire_array_data == nullptr && this_level_array_head != nullptr)
+			move_values(loaded);
+		else
+		{
+			deallocate_array();
+			reset();
+			swap_all(loaded);
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Format>
+	inline void
+		dynarray<T, _Allocator>::attach_buffer(void *buffer, std::size_t length, const contiguous_allocator_type *owner)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::binary_shape shape = {};
+		if (!Format::template read_shape<T>(internal_impl::buffer_reader{ static_cast<const char *>(buffer), length, 0 }, 1, shape))
+			throw std::invalid_argument("binary data is too short");
+
+		internal_pointer_type block = internal_impl::block_in_buffer<T>(buffer, length, shape.header.block_offset, shape.header.element_count);
+		attach_block(block, shape, owner);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Segment>
+	inline void
+		dynarray<T, _Allocator>::attach_segments(const Segment *segments, std::size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "binary format requires trivially copyable elements");
+
+		internal_impl::binary_shape shape = {};
+		if (count == 0 || !internal_impl::binary_format::read_shape<T>(internal_impl::buffer_reader{ static_cast<const char *>(segments[0].iov_base), segments[0].iov_len, 0 }, 1, shape))
+			throw std::invalid_argument("binary data is too short");
+
+		// the block either follows the offset tables in the first segment, or fills the second one
+		internal_pointer_type block = count == 1 || segments[0].iov_len > shape.header.block_offset ?
+			internal_impl::block_in_buffer<T>(segments[0].iov_base, segments[0].iov_len, shape.header.block_offset, shape.header.element_count) :
+			internal_impl::block_in_buffer<T>(segments[1].iov_base, segments[1].iov_len, 0, shape.header.element_count);
+		attach_block(block, shape, nullptr);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<T, _Allocator>::attach_block(internal_pointer_type block, const internal_impl::binary_shape &shape, const contiguous_allocator_type *owner)
+	{
+		deallocate_array();
+		reset();
+		if (shape.header.element_count == 0)
+			return;
+
+		if (owner != nullptr)
+			contiguous_allocator = *owner;
+		attach_nodes(block, shape.levels.get(), 0);
+		if (owner != nullptr)
+			entire_array_data = block;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<T, _Allocator>::attach_extents(internal_pointer_type block, const size_type *extents, const contiguous_allocator_type *owner)
+	{
+		std::uint64_t counts[1] = {};
+		std::copy(extents, extents + 1, counts);
+		internal_impl::binary_shape shape = {};
+		internal_impl::rectangular_levels(counts, 1, shape);
+		attach_block(block, shape, owner);
+		if (shape.header.element_count == 0 && owner != nullptr && block != nullptr)
+		{
+			contiguous_allocator = *owner;
+			contiguous_allocator.deallocate(block, 0);
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Generator, typename TaskRunner>
+	inline void
+		dynarray<T, _Allocator>::generate_array(const size_type *extents, Generator &generator, const TaskRunner &run_tasks)
+	{
+		construct_block(extents, [&](internal_pointer_type block, size_type count)
+		{
+			internal_impl::generate_block<1>(contiguous_allocator, block, extents, count, generator, run_tasks);
+		});
+	}
+
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline typename dynarray<T, _Allocator>::internal_pointer_type
+		dynarray<T, _Allocator>::release() noexcept
+	{
+		internal_pointer_type block = entire_array_data;
+		if (block == nullptr)
+			return nullptr;
+
+		entire_array_data = nullptr;
+		deallocate_array();
+		reset();
+		return block;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline typename dynarray<T, _Allocator>::internal_pointer_type
+		dynarray<T, _Allocator>::reshape_block(const size_type *extents, std::size_t rank) const
+	{
+		size_type count = 1;
+		for (std::size_t k = 0; k < rank; ++k)
+		{
+			if (extents[k] != 0 && count > std::numeric_limits<size_type>::max() / extents[k])
+				throw std::length_error("array too long");
+			count *= extents[k];
+		}
+		if (count != get_element_count())
+			throw std::invalid_argument("the extents do not match the number of elements");
+		return this_level_array_head;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Construct>
+	inline void
+		dynarray<T, _Allocator>::construct_block(const size_type *extents, Construct construct_elements)
+	{
+		std::uint64_t counts[1] = {};
+		std::copy(extents, extents + 1, counts);
+		internal_impl::binary_shape shape = {};
+		internal_impl::rectangular_levels(counts, 1, shape);
+		if (shape.header.element_count > std::allocator_traits<contiguous_allocator_type>::max_size(contiguous_allocator))
+			throw std::length_error("array too long");
+
+		size_type count = static_cast<size_type>(shape.header.element_count);
+		if (count == 0)
+		{
+			construct_elements(internal_pointer_type(), count);
+			return;
+		}
+
+		internal_pointer_type block = contiguous_allocator.allocate(count);
+		try
+		{
+			construct_elements(block, count);
+		}
+		catch (...)
+		{
+			// construct_elements destroys the elements it has built before it throws
+			contiguous_allocator.deallocate(block, count);
+			throw;
+		}
+
+		try
+		{
+			attach_block(block, shape, &contiguous_allocator);
+		}
+		catch (...)
+		{
+			for (size_type i = count; i > 0; --i)
+				std::allocator_traits<contiguous_allocator_type>::destroy(contiguous_allocator, block + i - 1);
+			contiguous_allocator.deallocate(block, count);
+			throw;
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Result>
+	inline Result
+		dynarray<T, _Allocator>::join_arrays(const dynarray *const *arrays, size_type count, size_type axis, bool stacking)
+	{
+		if (count == 0)
+			throw std::invalid_argument("no array to join");
+		if (axis > 1 || (axis == 1 && !stacking))
+			throw std::out_of_range("out of range, incorrect axis");
+
+		std::unique_ptr<const internal_value_type *[]> sources = std::make_unique<const internal_value_type *[]>(count);
+		std::unique_ptr<size_type[]> lengths = std::make_unique<size_type[]>(count);
+		size_type total = 0;
+		for (size_type i = 0; i < count; ++i)
+		{
+			sources[i] = arrays[i]->this_level_array_head;
+			lengths[i] = arrays[i]->size();
+			if (stacking && lengths[i] != lengths[0])
+				throw std::invalid_argument("the shapes of the arrays do not match");
+			total += lengths[i];
+		}
+
+		Result joined;
+		joined.contiguous_allocator = arrays[0]->contiguous_allocator;
+		if (stacking && axis == 1)
+		{
+			// every row of the result takes one element from each source
+			const size_type result_extents[2] = { lengths[0], count };
+			size_type outer = lengths[0];
+			std::fill(lengths.get(), lengths.get() + count, size_type(1));
+			joined.construct_block(result_extents, [&](auto block, size_type)
+			{
+				internal_impl::interleave_blocks(joined.contiguous_allocator, block, sources.get(), lengths.get(), lengths.get(), count, outer);
+			});
+			return joined;
+		}
+
+		// the sources are copied one after another
+		const size_type result_extents[2] = { stacking ? count : total, lengths[0] };
+		joined.construct_block(result_extents, [&](auto block, size_type)
+		{
+			internal_impl::interleave_blocks(joined.contiguous_allocator, block, sources.get(), lengths.get(), lengths.get(), count, 1);
+		});
+		return joined;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::vector<dynarray<T, _Allocator>>
+		dynarray<T, _Allocator>::split_array(size_type axis, size_type parts)
+	{
+		if (axis >= 1)
+			throw std::out_of_range("out of range, incorrect axis");
+		if (parts == 0 || size() % parts != 0)
+			throw std::invalid_argument("the array cannot be split into equal parts");
+
+		// the parts are consecutive ranges of the block, so every piece is a view
+		const size_type extents[1] = { size() / parts };
+		std::vector<dynarray> pieces(parts);
+		for (size_type p = 0; p < parts; ++p)
+			pieces[p].attach_extents(this_level_array_head + p * extents[0], extents, nullptr);
+		return pieces;
+	}
+
+
+
+	template<typename T, template<typename U> typename _Allocator>
+	class dynarray<dynarray<T, _Allocator>, _Allocator>
+	{
+		using Td = dynarray<T, _Allocator>;
+		static constexpr std::size_t dimensions = internal_impl::inner_type<dynarray, _Allocator>::nested_level;
+		friend class dynarray<dynarray<Td, _Allocator>, _Allocator>;
+		template<typename U, template<typename V> typename A>
+		friend class dynarray;
+		template<std::size_t Rank, template<typename V> typename A>
+		friend class bit_dynarray;
+		friend class npz_writer;
+	public:
+
+		// Member types
+
+		using value_type = Td;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type &;
+		using const_reference = const value_type &;
+		using pointer = value_type *;
+		using const_pointer = const value_type *;
+
+		using iterator = vla_iterator<Td>;
+		using const_iterator = vla_iterator<const Td>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		using allocator_type = _Allocator<Td>;
+	private:
+		using internal_value_type = typename internal_impl::inner_type<Td, _Allocator>::value_type;
+		using internal_pointer_type = internal_value_type *;
+	public:
+		using contiguous_allocator_type = _Allocator<internal_value_type>;
+
+		// Member functions
+
+		/*!
+		 * @brief Default Constructor.
+		 * Create a zero-size array.
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray() noexcept
+		{
+			initialise();
+		}
+
+		/*!
+		 * @brief Construct by count.
+		 * Create a one-dimensional array.
+		 *
+		 * @param count The size (length) of array
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count)
+		{
+			initialise();
+			allocate_array(count);
+		}
+
+		/*!
+		 * @brief Construct by count and use your custom allocator.
+		 * Create a one-dimensional array.
+		 *
+		 * @param count The size (length) of array
+		 * @param other_allocator Your custom allocator
+		 */
+		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count, _Alloc_t &&other_allocator)
+		{
+			initialise(other_allocator);
+			allocate_array(count);
+		}
+
+		/*!
+		 * @brief Usage 1: Construct by multiple 'count'.\n
+		 * Create a multi-dimensional array.\n
+		 * Example A: dynarray<dynarray<int>> my_array(10, 10);         // creates a 2D array (10 × 10), initialise with default value (zero)\n
+		 * Example B: dynarray<dynarray<int>> my_array(10, 10, 20);     // creates a 2D array (10 × 10), initialise with value (20)
+		 *
+		 * Usage 2: Construct by a 'count' and initialise the elements with 'args'\n
+		 * Create a one-dimensional array, use 'args' to initialise the array's elements.\n
+		 * Example A: dynarray<int> my_array(100);                      // creates an array (100 elements), initialise with default value (zero)\n
+		 * Example B: dynarray<int> my_array(100, 20);                  // creates an array (100 elements), initialise with value (20)
+		 *
+		 * @param count The first dimention
+		 * @param ...args If 'sizeof...(args)' is greater than the level of nested array, the rest of arg(s) will be used for initial array's elements.
+		 */
+		template<typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count, Args&& ... args)
+		{
+			initialise();
+			allocate_array(count, std::forward<Args>(args)...);
+		}
+
+		/*!
+		 * @brief Construct by multiple 'count' and use your custom allocator.
+		 *
+		 * @param count The first dimension
+		 * @param other_allocator Your custom allocator
+		 * @param ...args If 'sizeof...(args)' is greater than the level of nested array, the rest of arg(s) will be used for initial array's elements.
+		 */
+		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(size_type count, _Alloc_t &&other_allocator, Args&& ... args)
+		{
+			initialise(other_allocator);
+			allocate_array(count, other_allocator, std::forward<Args>(args)...);
+		}
+
+		/*!
+		 * @brief Duplicate an existing dynarray.
+		 *
+		 * @param other Another array to be copied
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray(const dynarray &other)
+		{
+			initialise();
+			copy_array(other);
+		}
+
+		/*!
+		 * @brief Initialise with rvalue.
+		 *
+		 * @param other Another array
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray(dynarray &&other) noexcept
+		{
+			move_array(other);
+		}
+
+		/*!
+		 * @brief Duplicate an existing dynarray and use your custom allocator.
+		 *
+		 * @param other Another array to be copied
+		 * @param other_allocator Allocator for the first level
+		 * @param ...args Other dimention's allocator(s)
+		 */
+		template<typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(const dynarray &other, const allocator_type &other_allocator, Args&& ... args)
+		{
+			initialise(other_allocator);
+			copy_array(other, other_allocator, std::forward<Args>(args)...);
+		}
+
+		/*!
+		 * @brief Duplicate an existing dynarray by using iterator.
+		 *
+		 * @param other_begin begin(), cbegin() of iterator; or rbegin(), crbegin() of reverse iterator
+		 * @param other_end end(), cend() of iterator; or rend(), crend() of reverse iterator
+		 */
+
+		template<typename InputIterator, typename = decltype(*std::declval<InputIterator&>(), ++std::declval<InputIterator&>(), void())>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(InputIterator other_begin, InputIterator other_end)
+		{
+			initialise();
+			copy_array(other_begin, other_end);
+		}
+
+		/*!
+		 * @brief Create a multiple-dimensional array from elements in row-major order and the extent of each dimension.\n
+		 * Example: dynarray<float, 2> my_array(flat.begin(), flat.end(), { rows, cols });
+		 *
+		 * Trivially copyable elements of a contiguous range (pointers, std::vector, std::span, etc.) are copied with a single memcpy.
+		 *
+		 * @param flat_begin Forward iterator to the first element
+		 * @param flat_end End of the elements, the range has to hold as many elements as the extents describe
+		 * @param extents Extent of each dimension
+		 */
+		template<typename ForwardIterator, typename = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<ForwardIterator>::iterator_category>>>
+		dynarray(ForwardIterator flat_begin, ForwardIterator flat_end, const size_type (&extents)[dimensions])
+		{
+			initialise();
+			copy_flat(flat_begin, flat_end, extents);
+		}
+
+		/*!
+		 * @brief Create a multiple-dimensional array with initializer_list.
+		 *
+		 * @param input_listYour initializer_list
+		 */
+		template<typename Ty>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(std::initializer_list<std::initializer_list<Ty>> input_list)
+		{
+			initialise();
+			allocate_array(input_list);
+		}
+
+		/*!
+		 * @brief Create a multiple-dimensional array with initializer_list.
+		 *
+		 * @param input_listYour initializer_list
+		 */
+		template<typename Ty, typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(std::initializer_list<std::initializer_list<Ty>> input_list, const allocator_type &other_allocator, Args&& ...args)
+		{
+			initialise(other_allocator);
+			allocate_array(input_list, std::forward<Args>(args)...);
+		}
+
+		/*!
+		 * @brief Takes over a contiguous block allocated elsewhere, without copying or moving the elements.
+		 *
+		 * The elements must have been constructed. When the dynarray no longer needs the block, it destroys the elements
+		 * and deallocates the block with owner, so the block has to come from owner (e.g. std::malloc for malloc_allocator).
+		 * If the constructor throws, the block is not taken over: the caller still owns the block and its elements.
+		 *
+		 * @param block Elements of the whole array in row-major order, may be nullptr if there are no elements
+		 * @param extents Extent of each dimension
+		 * @param owner The allocator to release the block with
+		 * @exception std::length_error if the array is too long, std::bad_alloc if the nodes cannot be allocated
+		 */
+		dynarray(adopt_block_t, internal_pointer_type block, const size_type (&extents)[dimensions], const contiguous_allocator_type &owner = contiguous_allocator_type())
+		{
+			initialise();
+			attach_extents(block, extents, &owner);
+		}
+
+		/*!
+		 * @brief Refers to a contiguous block owned elsewhere, without copying the elements.
+		 *
+		 * The same as view_binary, the dynarray does not own the block, which has to outlive it.
+		 * Assigning to the view replaces the values in the block, the same way as assigning to an inner layer.
+		 *
+		 * @param block Elements of the whole array in row-major order
+		 * @param extents Extent of each dimension
+		 */
+		dynarray(view_block_t, internal_pointer_type block, const size_type (&extents)[dimensions])
+		{
+			initialise();
+			attach_extents(block, extents, nullptr);
+		}
+
+		/*!
+		 * @brief Construct by the extent of each dimension, every element is constructed in place with the value returned by generator.\n
+		 * Example A: dynarray<float, 3> my_array(vla::from_generator, { x, y, z }, [](std::size_t i, std::size_t j, std::size_t k) { return float(i + j + k); });\n
+		 * Example B: dynarray<float, 3> my_array(vla::from_generator, { x, y, z }, [](std::size_t position) { return float(position); });
+		 *
+		 * @param extents Extent of each dimension
+		 * @param generator Called with one index per dimension if it accepts them, otherwise with the position in row-major order
+		 */
+		template<typename Generator>
+		dynarray(from_generator_t, const size_type (&extents)[dimensions], Generator generator)
+		{
+			initialise();
+			generate_array(extents, generator, internal_impl::sequenced_tasks());
+		}
+
+		/*!
+		 * @brief Same as above, the elements are constructed in parallel with policy (std::execution::par, etc.), generator has to be safe to call concurrently.
+		 */
+		template<typename ExecutionPolicy, typename Generator>
+		dynarray(from_generator_t, ExecutionPolicy &&policy, const size_type (&extents)[dimensions], Generator generator)
+		{
+			initialise();
+			generate_array(extents, generator, internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy });
+		}
+
+		/*!
+		 * @brief Copy an existing dynarray.
+		 *
+		 * If using operator= in nested dynarray, the original structure will not change. Replace original values only.
+		 *
+		 * @param other The right side of '='
+		 * @return A copied dynarray
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(const dynarray &other) noexcept
+		{
+			loop_copy(other);
+			return *this;
+		}
+
+		/*!
+		 * @brief Save an temporary created dynarray.
+		 *
+		 * If using operator= in nested dynarray, the original structure will not change. Replace original values only.
+		 *
+		 * @param other The right side of '='
+		 * @return A new dynarray
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(dynarray &&other) noexcept
+		{
+			if (entire_array_data == nullptr && this_level_array_head != nullptr)
+				move_values(other);
+			else
+			{
+				deallocate_array();
+				move_array(other);
+			}
+			return *this;
+		}
+
+		/*!
+		 * @brief Erase existing data and construct a new dynarray with initializer_list.
+		 *
+		 * @param input_list Your initializer_list
+		 * @return A new dynarray
+		 */
+		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(std::initializer_list<internal_value_type> input_list) noexcept
+		{
+			loop_copy(input_list);
+			return *this;
+		}
+
+		/*!
+		 * @brief Erase existing data and construct a new dynarray with initializer_list.
+		 *
+		 * @param input_list Your initializer_list
+		 * @return A new dynarray
+		 */
+		template<typename Ty>
+		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept
+		{
+			loop_copy(input_list);
+			return *this;
+		}
+
+		/*!
+		 * @brief Deconstruct.
+		 *
+		 */
+		CPP20_DYNARRAY_CONSTEXPR ~dynarray()
+		{
+			deallocate_array();
+		}
+
+		// Element access
+
+		/*!
+		 * @brief Returns a reference to the element at specified location pos, with bounds checking.
+		 *
+		 * If pos is not within the range of the container, an exception of type std::out_of_range is thrown.
+		 *
+		 * @param pos Position of the element to return
+		 * @return Reference to the requested element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR reference at(size_type pos);
+
+		/*!
+		 * @brief Returns a const reference to the element at specified location pos, with bounds checking.
+		 *
+		 * If pos is not within the range of the container, an exception of type std::out_of_range is thrown.
+		 *
+		 * @param pos Position of the element to return
+		 * @return Reference to the requested element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reference at(size_type pos) const;
+
+		/*!
+		 * Returns a reference to the element at specified location pos. No bounds checking is performed.
+		 *
+		 * @param pos Position of the element to return
+		 * @return Reference to the requested element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR reference operator[](size_type pos);
+
+		/*!
+		 * Returns a const reference to the element at specified location pos. No bounds checking is performed.
+		 *
+		 * @param pos Position of the element to return
+		 * @return Reference to the requested element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reference operator[](size_type pos) const;
+
+		/*!
+		 * @brief Returns a reference to the first element in the container.
+		 *
+		 * Calling front() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 *
+		 * @return Reference to the first element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR reference front() { return (*this)[0]; }
+
+		/*!
+		 * @brief Returns a const reference to the first element in the container.
+		 *
+		 * Calling front() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 *
+		 * @return Const reference to the first element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reference front() const { return (*this)[0]; }
+
+		/*!
+		 * @brief Returns a reference to the last element in the container.
+		 *
+		 * Calling back() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 *
+		 * @return Reference to the last element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR reference back();
+
+		/*!
+		 * @brief Returns a const reference to the first element in the container.
+		 *
+		 * Calling back() on an empty container should be undefined. But for everyone's convenience, nullptr is returned here.
+		 *
+		 * @return Const reference to the first element
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reference back() const;
+
+		/*!
+		 * @brief Returns pointer to the innermost underlying array serving as element storage.
+		 *
+		 * For everyone's convenience, calling data() on an empty container will return nullptr.
+		 *
+		 * @return Pointer to the innermost underlying element storage.
+		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
+		 *
+		*/
+		CPP20_DYNARRAY_CONSTEXPR internal_pointer_type data() noexcept { return this_level_array_head; }
+
+		/*!
+		 * @brief Returns const pointer to the innermost underlying array serving as element storage.
+		 *
+		 * For everyone's convenience, calling data() on an empty container will return nullptr.
+		 *
+		 * @return Const pointer to the innermost underlying element storage.
+		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const internal_pointer_type data() const noexcept { return this_level_array_head; }
+
+		/*!
+		 * @brief Hands the contiguous block over to the caller, and leaves the container empty.
+		 *
+		 * The elements are not destroyed. The block holds as many elements as the whole array had, in the same order;
+		 * destroy them and deallocate the block with contiguous_allocator_type (std::free for malloc_allocator).
+		 *
+		 * @return The contiguous block, nullptr if the container does not own one (an inner layer, a view, or empty)
+		*/
+		internal_pointer_type release() noexcept;
+
+		/*!
+		 * @brief Views the same elements with another shape, only the node skeleton is built, the elements are neither copied nor moved.
+		 *
+		 * The view refers to the contiguous block of this container, which has to outlive it.\n
+		 * Example: auto matrix = vla_array.reshape({ rows, cols });
+		 *
+		 * @param extents Extent of each dimension, their product has to equal the number of elements
+		 * @return A view with the new shape
+		 * @exception std::invalid_argument if the extents do not match the number of elements
+		*/
+		template<std::size_t M>
+		internal_impl::nested_dynarray_t<internal_value_type, M, _Allocator> reshape(const size_type (&extents)[M]) &
+		{
+			internal_impl::nested_dynarray_t<internal_value_type, M, _Allocator> reshaped;
+			reshaped.attach_extents(reshape_block(extents, M), extents, nullptr);
+			return reshaped;
+		}
+
+		/*!
+		 * @brief Same as above, but a container owning its block hands the block over to the result and is left empty.
+		 *
+		 * Example: auto matrix = std::move(vla_array).reshape({ rows, cols });
+		*/
+		template<std::size_t M>
+		internal_impl::nested_dynarray_t<internal_value_type, M, _Allocator> reshape(const size_type (&extents)[M]) &&
+		{
+			internal_impl::nested_dynarray_t<internal_value_type, M, _Allocator> reshaped = reshape(extents);
+			if (entire_array_data != nullptr && reshaped.this_level_array_head != nullptr)
+			{
+				reshaped.contiguous_allocator = contiguous_allocator;
+				reshaped.entire_array_data = release();
+			}
+			return reshaped;
+		}
+
+		/*!
+		 * @brief Views all elements as a one-dimensional array, the same as reshape({ number of elements }).
+		*/
+		dynarray<internal_value_type, _Allocator> flatten() &
+		{
+			const size_type extents[1] = { get_element_count() };
+			return reshape(extents);
+		}
+
+		/*!
+		 * @brief Same as above, but a container owning its block hands the block over to the result and is left empty.
+		*/
+		dynarray<internal_value_type, _Allocator> flatten() &&
+		{
+			const size_type extents[1] = { get_element_count() };
+			return std::move(*this).reshape(extents);
+		}
+
+		/*!
+		 * @brief Gives up the container and hands out one of its rows, no element is copied or moved.
+		 *
+		 * Moving a row out of its parent allocates a block and moves every element. detach() moves the container itself
+		 * into a shared allocation instead, which only takes its pointers when it owns its block, and returns a pointer
+		 * to the row that keeps the whole block alive. The container is left empty.
+		 *
+		 * @param pos Position of the row
+		 * @return Shared pointer to the row, the block is released when the last pointer to any of its rows is gone
+		 * @exception std::out_of_range if pos is not within the range of the container
+		*/
+		std::shared_ptr<value_type> detach(size_type pos) &&
+		{
+			if (pos >= current_dimension_array_size)
+				throw std::out_of_range("out of range, incorrect position");
+			std::shared_ptr<dynarray> parent = std::make_shared<dynarray>(std::move(*this));
+			return std::shared_ptr<value_type>(parent, &(*parent)[pos]);
+		}
+
+		/*!
+		 * @brief Same as above, for all rows at once: every row can be passed on and outlive the others.
+		*/
+		std::vector<std::shared_ptr<value_type>> detach_rows() &&
+		{
+			std::shared_ptr<dynarray> parent = std::make_shared<dynarray>(std::move(*this));
+			std::vector<std::shared_ptr<value_type>> rows;
+			rows.reserve(parent->current_dimension_array_size);
+			for (size_type i = 0; i < parent->current_dimension_array_size; ++i)
+				rows.emplace_back(parent, &(*parent)[i]);
+			return rows;
+		}
+
+		/*!
+		 * @brief Returns pointer to the underlying array serving as element storage.
+		 *
+		 * For everyone's convenience, calling data() on an empty container will return nullptr.
+		 *
+		 * @return Pointer to the underlying element storage.
+		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR pointer get() noexcept { return current_dimension_array_data; }
+
+		/*!
+		 * @brief Returns const pointer to the underlying array serving as element storage.
+		 *
+		 * For everyone's convenience, calling data() on an empty container will return nullptr.
+		 *
+		 * @return Const pointer to the underlying element storage.
+		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const pointer get() const noexcept { return current_dimension_array_data; }
+
+		/*!
+		 * @brief Checks if the container has no elements.
+		 * @return true if the container is empty, false otherwise
+		*/
+		CPP20_DYNARRAY_CONSTEXPR CPP20_DYNARRAY_NODISCARD bool empty() const noexcept
+		{
+			return this_level_array_head == nullptr || this_level_array_tail == nullptr;
+		}
+
+		/*!
+		 * @brief Returns the number of elements in the container.
+		 * @return The number of elements in the container.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR size_type size() const noexcept
+		{
+			if (this_level_array_tail == nullptr && this_level_array_head == nullptr)
+				return 0;
+			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		}
+
+		/*!
+		 * @brief Returns the maximum number of elements the container is able to hold due to system or library implementation limitations.
+		 *
+		 * This value typically reflects the theoretical limit on the size of the container, at most std::numeric_limits<difference_type>::max().
+		 * At runtime, the size of the container may be limited to a value smaller than max_size() by the amount of RAM available.
+		 *
+		 * @return Maximum number of elements.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR size_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+
+		/*!
+		 * @brief Exchanges the contents of the container with those of other.
+		 *
+		 * Does not invoke any move, copy, or swap operations on individual elements.
+		 *
+		 * All iterators and references remain valid. The past-the-end iterator is invalidated.
+		 *
+		 * @param other dynarray to exchange the contents with
+		*/
+		CPP20_DYNARRAY_CONSTEXPR void swap(dynarray &other) noexcept;
+
+		/*!
+		 * @brief Assigns the given value value to all elements in the container.
+		 * @param value The value to assign to the elements
+		*/
+		CPP20_DYNARRAY_CONSTEXPR void fill(const internal_value_type& value);
+
+
+		// Iterators
+
+		/*!
+		 * @brief Returns an iterator to the first element of the vector.
+		 *
+		 * If the vector is empty, the returned iterator will be equal to end().
+		 *
+		 * @return Iterator to the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR iterator begin() noexcept { return iterator(current_dimension_array_data); }
+
+		/*!
+		 * @brief Returns an iterator to the first element of the vector.
+		 *
+		 * If the vector is empty, the returned iterator will be equal to end().
+		 *
+		 * @return Iterator to the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_iterator begin() const noexcept { return const_iterator(current_dimension_array_data); }
+
+		/*!
+		 * @brief Returns an iterator to the first element of the vector.
+		 *
+		 * If the vector is empty, the returned iterator will be equal to end().
+		 *
+		 * @return Iterator to the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_iterator cbegin() const noexcept { return begin(); }
+
+		/*!
+		 * @brief Returns an iterator to the element following the last element of the vector.
+		 *
+		 * This element acts as a placeholder; attempting to access it results in undefined behavior.
+		 *
+		 * @return Iterator to the element following the last element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR iterator end() noexcept { return iterator(current_dimension_array_data + current_dimension_array_size); }
+
+		/*!
+		 * @brief Returns an iterator to the element following the last element of the vector.
+		 *
+		 * This element acts as a placeholder; attempting to access it results in undefined behavior.
+		 *
+		 * @return Iterator to the element following the last element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_iterator end() const noexcept { return const_iterator(current_dimension_array_data + current_dimension_array_size); }
+
+		/*!
+		 * @brief Returns an iterator to the element following the last element of the vector.
+		 *
+		 * This element acts as a placeholder; attempting to access it results in undefined behavior.
+		 *
+		 * @return Iterator to the element following the last element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_iterator cend() const noexcept { return end(); }
+
+		/*!
+		 * @brief Returns a reverse iterator to the first element of the reversed vector.
+		 *
+		 * It corresponds to the last element of the non-reversed vector. If the vector is empty, the returned iterator is equal to rend().
+		 *
+		 * @return Reverse iterator to the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+		/*!
+		 * @brief Returns a reverse iterator to the first element of the reversed vector.
+		 *
+		 * It corresponds to the last element of the non-reversed vector. If the vector is empty, the returned iterator is equal to rend().
+		 *
+		 * @return Reverse iterator to the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+		/*!
+		 * @brief Returns a reverse iterator to the first element of the reversed vector.
+		 *
+		 * It corresponds to the last element of the non-reversed vector. If the vector is empty, the returned iterator is equal to rend().
+		 *
+		 * @return Reverse iterator to the first element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+		/*!
+		 * @brief Returns a reverse iterator to the element following the last element of the reversed vector.
+		 *
+		 * It corresponds to the element preceding the first element of the non-reversed vector.
+		 * This element acts as a placeholder, attempting to access it results in undefined behavior.
+		 *
+		 * @return Reverse iterator to the element following the last element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+		/*!
+		 * @brief Returns a reverse iterator to the element following the last element of the reversed vector.
+		 *
+		 * It corresponds to the element preceding the first element of the non-reversed vector.
+		 * This element acts as a placeholder, attempting to access it results in undefined behavior.
+		 *
+		 * @return Reverse iterator to the element following the last element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		/*!
+		 * @brief Returns a reverse iterator to the element following the last element of the reversed vector.
+		 *
+		 * It corresponds to the element preceding the first element of the non-reversed vector.
+		 * This element acts as a placeholder, attempting to access it results in undefined behavior.
+		 *
+		 * @return Reverse iterator to the element following the last element.
+		*/
+		CPP20_DYNARRAY_CONSTEXPR const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+	private:
+
+
+		internal_pointer_type entire_array_data;	// always nullptr in nested-dynarray
+
+		size_type current_dimension_array_size;
+		pointer current_dimension_array_data;	// as node managers if not innermost layer
+
+		internal_pointer_type this_level_array_head;
+		internal_pointer_type this_level_array_tail;
+
+		allocator_type array_allocator;
+		contiguous_allocator_type contiguous_allocator;
+
+
+		CPP20_DYNARRAY_CONSTEXPR void initialise(const allocator_type &other_allocator = allocator_type());
+
+		CPP20_DYNARRAY_CONSTEXPR void reset();
+
+		CPP20_DYNARRAY_CONSTEXPR size_type get_block_size() const
+		{
+			if (this_level_array_tail == this_level_array_head)
+				return true;
+			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		}
+
+		CPP20_DYNARRAY_CONSTEXPR size_type get_element_count() const noexcept
+		{
+			if (this_level_array_head == nullptr)
+				return 0;
+			return static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+		}
+
+		template<typename Ty>
+		static CPP20_DYNARRAY_CONSTEXPR size_type expand_list(std::initializer_list<Ty> init);
+
+		template<typename ... Args>
+		static CPP20_DYNARRAY_CONSTEXPR size_type expand_counts(size_type count, Args&& ... args);
+
+		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocator(const allocator_type &_allocator);
+
+		template<typename Skip>
+		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocators(const Skip &ignore, const allocator_type &_allocator);
+
+		template<typename ... Args>
+		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocator(const allocator_type &_allocator, Args&& ... args);
+
+		template<typename Skip, typename ... Args>
+		static CPP20_DYNARRAY_CONSTEXPR contiguous_allocator_type expand_allocators(const Skip &ignore, const allocator_type &_allocator, Args&& ... args);
+
+		CPP20_DYNARRAY_CONSTEXPR void verify_size(size_type count);
+
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count);
+
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count);
+
+		template<typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count, Args&& ... args);
+
+		template<typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count, Args&& ... args);
+
+		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count, _Alloc_t &&other_allocator, Args&& ... args);
+
+		template<typename _Alloc_t, typename = std::enable_if_t<std::is_same_v<std::decay_t<_Alloc_t>, allocator_type>>, typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, size_type count, _Alloc_t &&other_allocator, Args&& ... args);
+
+		template<typename Ty>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list);
+
+		template<typename Ty, typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list, Args&& ...args);
+
+		template<typename Ty, typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list,
+			const allocator_type &other_allocator = allocator_type(), Args&& ...args);
+
+		CPP20_DYNARRAY_CONSTEXPR void deallocate_array();
+
+		CPP20_DYNARRAY_CONSTEXPR void copy_array(const dynarray &other);
+
+		template<typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void copy_array(const dynarray &other, const allocator_type &other_allocator, Args&& ... args);
+
+		CPP20_DYNARRAY_CONSTEXPR void copy_array(internal_pointer_type starting_address, const dynarray &other);
+
+		template<typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void copy_array(internal_pointer_type starting_address, const dynarray &other,
+			const allocator_type &other_allocator, Args&& ... args);
+
+		template<typename InputIterator>
+		CPP20_DYNARRAY_CONSTEXPR void copy_array(InputIterator other_begin, InputIterator other_end);
+
+		CPP20_DYNARRAY_CONSTEXPR void loop_copy(const dynarray &other) noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void loop_copy(std::initializer_list<internal_value_type> input_list) noexcept;
+
+		template<typename Ty>
+		CPP20_DYNARRAY_CONSTEXPR void loop_copy(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void move_array(dynarray &other) noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void move_values(dynarray &other) noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void swap_all(dynarray &other) noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void swap_outside(dynarray &other) noexcept;
+
+		template<typename U>
+		CPP20_DYNARRAY_CONSTEXPR bool same_shape(const dynarray<U, _Allocator> &other) const noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR bool equal_to(const dynarray &other) const;
+
+		CPP20_DYNARRAY_CONSTEXPR std::size_t hash_shape(std::size_t seed) const noexcept;
+
+		std::size_t hash_code() const;
+
+		friend struct std::hash<dynarray>;
+
+		template<typename Index>
+		dynarray<internal_value_type, _Allocator> gather_elements(const dynarray<Index, _Allocator> &indices) const;
+
+		template<typename Index>
+		CPP20_DYNARRAY_CONSTEXPR void scatter_elements(const dynarray<Index, _Allocator> &indices, const dynarray<internal_value_type, _Allocator> &values);
+
+		template<typename M>
+		dynarray<internal_value_type, _Allocator> select_elements(const dynarray<M, _Allocator> &mask) const;
+
+		template<typename M>
+		CPP20_DYNARRAY_CONSTEXPR void blend_elements(const dynarray<M, _Allocator> &mask, const dynarray &other);
+
+		CPP20_DYNARRAY_CONSTEXPR void copy_region_from(const size_type (&dst_origin)[dimensions], const dynarray &src, const size_type (&src_origin)[dimensions], const size_type (&region)[dimensions]);
+
+		CPP20_DYNARRAY_CONSTEXPR void fill_region_with(const size_type (&origin)[dimensions], const size_type (&region)[dimensions], const internal_value_type &value);
+
+		CPP20_DYNARRAY_CONSTEXPR bool get_extents(size_type *extents) const;
+
+		template<typename TaskRunner, typename BinaryOperation>
+		CPP20_DYNARRAY_CONSTEXPR void scan_along(const TaskRunner &run_tasks, size_type axis, BinaryOperation op, const internal_value_type *init);
+
+		template<typename TaskRunner>
+		CPP20_DYNARRAY_CONSTEXPR void summed_area(const TaskRunner &run_tasks);
+
+		CPP20_DYNARRAY_CONSTEXPR void count_nodes(std::uint64_t *totals) const noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void write_offsets(std::uint64_t **cursors) const noexcept;
+
+		CPP20_DYNARRAY_CONSTEXPR void attach_nodes(internal_pointer_type block, const std::uint64_t *const *levels, std::uint64_t node);
+
+		internal_impl::binary_prefix make_binary_prefix() const;
+
+		void write_binary(std::ostream &output) const;
+
+		template<typename TaskRunner>
+		void write_compressed(const TaskRunner &run_tasks, std::ostream &output) const;
+
+		void write_delta(std::ostream &output, dirty_regions<internal_value_type> &dirty) const;
+
+		void read_delta(std::istream &input);
+
+		std::string make_npy_header() const;
+		void write_npy(std::ostream &output) const;
+
+		template<bool Reading, typename Transfer, typename Step>
+		bool transfer_rows(Transfer &&transfer, size_type rows_per_step, Step &step);
+
+		template<typename TaskRunner>
+		void parse_text(const TaskRunner &run_tasks, std::string_view text, char delimiter);
+
+		template<typename Format, typename ReadBlock = internal_impl::read_raw_block>
+		void read_stream(std::istream &input, ReadBlock &&read_block = ReadBlock());
+
+		template<typename Format>
+		void attach_buffer(void *buffer, std::size_t length, const contiguous_allocator_type *owner);
+
+		template<typename Segment>
+		void attach_segments(const Segment *segments, std::size_t count);
+
+		void attach_block(internal_pointer_type block, const internal_impl::binary_shape &shape, const contiguous_allocator_type *owner);
+
+		void attach_extents(internal_pointer_type block, const size_type *extents, const contiguous_allocator_type *owner);
+
+		internal_pointer_type reshape_block(const size_type *extents, std::size_t rank) const;
+
+		template<typename Construct>
+		void construct_block(const size_type *extents, Construct construct_elements);
+
+		template<typename Result>
+		static Result join_arrays(const dynarray *const *arrays, size_type count, size_type axis, bool stacking);
+
+		std::vector<dynarray> split_array(size_type axis, size_type parts);
+
+		template<typename Generator, typename TaskRunner>
+		void generate_array(const size_type *extents, Generator &generator, const TaskRunner &run_tasks);
+
+		template<typename ForwardIterator>
+		void copy_flat(ForwardIterator flat_begin, ForwardIterator flat_end, const size_type *extents);
+
+
+		/**** Non-member functions  ***/
+
+		/*!
+		 * @brief Exchanges the contents of the container with those of other.
+		 *
+		 * If both of the containers are outter-most layer, they will be swapped completely, including sizes.
+		 *
+		 * Otherwise swap the contents only.
+		 *
+		 * @param lhs A dynarray
+		 * @param rhs Another dynarray
+		 * @return
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void swap(dynarray &lhs, dynarray &rhs) noexcept { lhs.swap_outside(rhs); }
+
+		/*!
+		 * @brief Replaces old_array with new_array and returns the old value of old_array.
+		 *
+		 * If old_array is an inner layer, exchange() will replaces the contents of the container only, the size of old_array will keeps unchanged.
+		 *
+		 * @param old_array Old array to be replaced
+		 * @param new_array New array replace with
+		 * @return The value of old_array
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR dynarray exchange(dynarray &old_array, dynarray &&new_array) noexcept
+		{
+			dynarray current_array = std::move(old_array);
+			if (old_array.entire_array_data == nullptr && old_array.current_dimension_array_size > 0)
+			{
+				old_array.swap(new_array);
+			}
+			else
+			{
+				if (new_array.entire_array_data == nullptr && new_array.current_dimension_array_size > 0)
+				{
+					dynarray temp_array = std::move(new_array);
+					old_array.swap_all(temp_array);
+				}
+				else
+				{
+					old_array.swap_all(new_array);
+				}
+			}
+			return current_array;
+		}
+
+		friend CPP20_DYNARRAY_CONSTEXPR bool operator==(const dynarray &lhs, const dynarray &rhs)
+		{
+			return lhs.equal_to(rhs);
+		}
+
+#ifdef DYNARRAY_USING_CPP20
+		friend CPP20_DYNARRAY_CONSTEXPR auto operator<=>(const dynarray &lhs, const dynarray &rhs)
+		{
+			if constexpr (internal_impl::is_bitwise_comparable_v<internal_value_type>)
+			{
+				if (lhs.same_shape(rhs))
+				{
+					size_type count = lhs.get_element_count();
+					size_type position = internal_impl::mismatch_bitwise(lhs.this_level_array_head, rhs.this_level_array_head, count);
+					if (position < count)
+						return lhs.this_level_array_head[position] <=> rhs.this_level_array_head[position];
+					return std::strong_ordering::equal;
+				}
+			}
+			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+#else
+		friend bool operator!=(const dynarray &lhs, const dynarray &rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		friend bool operator<(const dynarray &lhs, const dynarray &rhs)
+		{
+			if constexpr (internal_impl::is_bitwise_comparable_v<internal_value_type>)
+			{
+				if (lhs.same_shape(rhs))
+				{
+					size_type count = lhs.get_element_count();
+					size_type position = internal_impl::mismatch_bitwise(lhs.this_level_array_head, rhs.this_level_array_head, count);
+					return position < count && lhs.this_level_array_head[position] < rhs.this_level_array_head[position];
+				}
+			}
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+		friend bool operator>(const dynarray &lhs, const dynarray &rhs)
+		{
+			return rhs < lhs;
+		}
+
+		friend bool operator<=(const dynarray &lhs, const dynarray &rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		friend bool operator>=(const dynarray &lhs, const dynarray &rhs)
+		{
+			return !(lhs < rhs);
+		}
+#endif
+
+		/*!
+		 * @brief Replaces the elements with their inclusive prefix sums along the given axis.
+		 *
+		 * Axis 0 is the outer-most dimension. The array must be rectangular, every row of the same layer must have the same size.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @exception std::out_of_range if axis is not less than the number of dimensions
+		 * @exception std::invalid_argument if arr is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void inclusive_scan(dynarray &arr, size_type axis)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, std::plus<>(), nullptr);
+		}
+
+		/*!
+		 * @brief Replaces the elements with their inclusive prefix results of op along the given axis.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param op Binary function object, applied as op(previous result, current element)
+		*/
+		template<typename BinaryOperation>
+		friend CPP20_DYNARRAY_CONSTEXPR void inclusive_scan(dynarray &arr, size_type axis, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, op, nullptr);
+		}
+
+		/*!
+		 * @brief Replaces the elements with their exclusive prefix sums along the given axis, the first element of each line becomes init.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param init The initial value
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void exclusive_scan(dynarray &arr, size_type axis, const internal_value_type &init)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, std::plus<>(), &init);
+		}
+
+		/*!
+		 * @brief Replaces the elements with their exclusive prefix results of op along the given axis, the first element of each line becomes init.
+		 *
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param init The initial value
+		 * @param op Binary function object, applied as op(previous result, current element)
+		*/
+		template<typename BinaryOperation>
+		friend CPP20_DYNARRAY_CONSTEXPR void exclusive_scan(dynarray &arr, size_type axis, const internal_value_type &init, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::sequenced_tasks(), axis, op, &init);
+		}
+
+		/*!
+		 * @brief Same as inclusive_scan(arr, axis), tasks are executed according to policy.
+		 *
+		 * Include <execution> to use the policies. Like std::inclusive_scan with a policy, op must be associative.
+		 *
+		 * @param policy The execution policy to use
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		*/
+		template<typename ExecutionPolicy>
+		friend void inclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, std::plus<>(), nullptr);
+		}
+
+		template<typename ExecutionPolicy, typename BinaryOperation>
+		friend void inclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, op, nullptr);
+		}
+
+		/*!
+		 * @brief Same as exclusive_scan(arr, axis, init), tasks are executed according to policy.
+		 *
+		 * @param policy The execution policy to use
+		 * @param arr The array to be scanned in place
+		 * @param axis The dimension to scan along
+		 * @param init The initial value
+		*/
+		template<typename ExecutionPolicy>
+		friend void exclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis, const internal_value_type &init)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, std::plus<>(), &init);
+		}
+
+		template<typename ExecutionPolicy, typename BinaryOperation>
+		friend void exclusive_scan(ExecutionPolicy &&policy, dynarray &arr, size_type axis, const internal_value_type &init, BinaryOperation op)
+		{
+			arr.scan_along(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, axis, op, &init);
+		}
+
+		/*!
+		 * @brief Builds the summed-area table (integral image) of a two-dimensional dynarray.
+		 *
+		 * result[i][j] is the sum of arr[0..i][0..j]. The sum of any rectangle can then be computed with four lookups.
+		 *
+		 * @param arr A rectangular two-dimensional dynarray
+		 * @return The summed-area table of arr
+		 * @exception std::invalid_argument if arr is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR dynarray summed_area_table(const dynarray &arr)
+		{
+			static_assert(internal_impl::inner_type<Td, _Allocator>::nested_level == 1, "summed_area_table() requires a two-dimensional dynarray");
+			dynarray result(arr);
+			result.summed_area(internal_impl::sequenced_tasks());
+			return result;
+		}
+
+		template<typename ExecutionPolicy>
+		friend dynarray summed_area_table(ExecutionPolicy &&policy, const dynarray &arr)
+		{
+			static_assert(internal_impl::inner_type<Td, _Allocator>::nested_level == 1, "summed_area_table() requires a two-dimensional dynarray");
+			dynarray result(arr);
+			result.summed_area(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy });
+			return result;
+		}
+
+		/*!
+		 * @brief Collects elements at the given positions.
+		 *
+		 * Positions count the elements in row-major order, as if src were flattened.
+		 * All positions are verified in one pass first, then the elements are read without further checks.
+		 *
+		 * @param src The source array
+		 * @param indices Positions of the elements to collect
+		 * @return One-dimensional dynarray, the i-th element is the element of src at indices[i]
+		 * @exception std::out_of_range if any position is not less than the number of elements of src
+		*/
+		template<typename Index>
+		friend dynarray<internal_value_type, _Allocator> gather(const dynarray &src, const dynarray<Index, _Allocator> &indices)
+		{
+			return src.gather_elements(indices);
+		}
+
+		/*!
+		 * @brief Writes values to the given positions, the counterpart of gather().
+		 *
+		 * If a position appears more than once, the last value is kept.
+		 *
+		 * @param dst The destination array
+		 * @param indices Positions of the elements to be written, in row-major order
+		 * @param values Values to write, must have the same size as indices
+		 * @exception std::out_of_range if any position is not less than the number of elements of dst
+		 * @exception std::invalid_argument if the sizes of indices and values are different
+		*/
+		template<typename Index>
+		friend CPP20_DYNARRAY_CONSTEXPR void scatter(dynarray &dst, const dynarray<Index, _Allocator> &indices, const dynarray<internal_value_type, _Allocator> &values)
+		{
+			dst.scatter_elements(indices, values);
+		}
+
+		/*!
+		 * @brief Collects the elements whose corresponding mask elements are true, in row-major order.
+		 *
+		 * @param src The source array
+		 * @param mask Array of the same shape as src, elements are converted to bool
+		 * @return One-dimensional dynarray of the selected elements
+		 * @exception std::invalid_argument if the shapes of src and mask are different
+		*/
+		template<typename M>
+		friend dynarray<internal_value_type, _Allocator> select(const dynarray &src, const dynarray<M, _Allocator> &mask)
+		{
+			static_assert(static_cast<int>(internal_impl::inner_type<dynarray<M, _Allocator>, _Allocator>::nested_level) == static_cast<int>(internal_impl::inner_type<dynarray, _Allocator>::nested_level),
+				"mask must have the same number of dimensions");
+			return src.select_elements(mask);
+		}
+
+		/*!
+		 * @brief Chooses elements from lhs where mask is true, from rhs otherwise.
+		 *
+		 * @param mask Array of the same shape as lhs and rhs, elements are converted to bool
+		 * @param lhs Array providing the elements where mask is true
+		 * @param rhs Array providing the elements where mask is false
+		 * @return A new dynarray of the same shape
+		 * @exception std::invalid_argument if the shapes of the arrays are different
+		*/
+		template<typename M>
+		friend CPP20_DYNARRAY_CONSTEXPR dynarray where(const dynarray<M, _Allocator> &mask, const dynarray &lhs, const dynarray &rhs)
+		{
+			static_assert(static_cast<int>(internal_impl::inner_type<dynarray<M, _Allocator>, _Allocator>::nested_level) == static_cast<int>(internal_impl::inner_type<dynarray, _Allocator>::nested_level),
+				"mask must have the same number of dimensions");
+			dynarray result(lhs);
+			result.blend_elements(mask, rhs);
+			return result;
+		}
+
+		/*!
+		 * @brief Copies a rectangular region of src into dst.
+		 *
+		 * Both arrays must be rectangular. Each contiguous run of the region is copied at once,
+		 * when the region covers whole rows (or whole planes, etc.) of both arrays, the runs merge into larger blocks.
+		 * dst and src may be the same array, overlapping regions are handled.
+		 *
+		 * @param dst The destination array
+		 * @param dst_origin Position of the region in dst, one index for each dimension
+		 * @param src The source array
+		 * @param src_origin Position of the region in src, one index for each dimension
+		 * @param extents Size of the region, one size for each dimension
+		 * @exception std::out_of_range if the region exceeds dst or src
+		 * @exception std::invalid_argument if dst or src is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void copy_region(dynarray &dst, const size_type (&dst_origin)[dimensions],
+		                                                 const dynarray &src, const size_type (&src_origin)[dimensions], const size_type (&extents)[dimensions])
+		{
+			dst.copy_region_from(dst_origin, src, src_origin, extents);
+		}
+
+		/*!
+		 * @brief Joins two arrays along an existing axis, the other extents of both arrays must be equal.
+		 *
+		 * The result is allocated once. For every index in front of axis, the contiguous part of each array is copied at once.
+		 *
+		 * @param lhs The first array
+		 * @param rhs The second array
+		 * @param axis The dimension to join along
+		 * @return The joined array
+		 * @exception std::out_of_range if axis is not a dimension of the arrays
+		 * @exception std::invalid_argument if an array is not rectangular, or the shapes do not match
+		*/
+		friend dynarray concat(const dynarray &lhs, const dynarray &rhs, size_type axis)
+		{
+			const dynarray *arrays[2] = { &lhs, &rhs };
+			return join_arrays<dynarray>(arrays, 2, axis, false);
+		}
+
+		/*!
+		 * @brief Same as above, joins every array of [first, last).
+		*/
+		template<typename InputIterator, typename = std::enable_if_t<std::is_same_v<std::decay_t<decltype(*std::declval<InputIterator&>())>, dynarray>>>
+		friend dynarray concat(InputIterator first, InputIterator last, size_type axis)
+		{
+			std::vector<const dynarray *> arrays;
+			for (; first != last; ++first)
+				arrays.push_back(std::addressof(*first));
+			return join_arrays<dynarray>(arrays.data(), arrays.size(), axis, false);
+		}
+
+		/*!
+		 * @brief Stacks arrays of the same shape along a new dimension, which is inserted in front of axis.\n
+		 * Example: std::vector<dynarray<dynarray<float>>> samples; dynarray<dynarray<dynarray<float>>> batch = stack(samples.begin(), samples.end(), 0);
+		 *
+		 * The result is allocated once and filled the same way as concat.
+		 *
+		 * @param first Iterator to the first array
+		 * @param last End of the arrays
+		 * @param axis Position of the new dimension, from 0 to the number of dimensions of the arrays
+		 * @return The stacked array, with one dimension more
+		 * @exception std::out_of_range if axis is too large
+		 * @exception std::invalid_argument if [first, last) is empty, an array is not rectangular, or the shapes do not match
+		*/
+		template<typename InputIterator, typename = std::enable_if_t<std::is_same_v<std::decay_t<decltype(*std::declval<InputIterator&>())>, dynarray>>>
+		friend dynarray<dynarray, _Allocator> stack(InputIterator first, InputIterator last, size_type axis)
+		{
+			std::vector<const dynarray *> arrays;
+			for (; first != last; ++first)
+				arrays.push_back(std::addressof(*first));
+			return join_arrays<dynarray<dynarray, _Allocator>>(arrays.data(), arrays.size(), axis, true);
+		}
+
+		/*!
+		 * @brief Splits an array into equal parts along an axis.
+		 *
+		 * If every extent in front of axis is 1 (e.g. axis 0), each part is contiguous in the block of arr and is returned as a view,
+		 * arr has to outlive the parts. Otherwise each part is a copy, allocated once and filled with one copy per contiguous run.
+		 *
+		 * @param arr The array to split
+		 * @param axis The dimension to split along
+		 * @param parts Number of parts, it has to divide the extent of axis
+		 * @return The parts in order
+		 * @exception std::out_of_range if axis is not a dimension of arr
+		 * @exception std::invalid_argument if arr is not rectangular, or the extent of axis cannot be divided by parts
+		*/
+		friend std::vector<dynarray> split(dynarray &arr, size_type axis, size_type parts) { return arr.split_array(axis, parts); }
+
+		/*!
+		 * @brief Assigns value to every element of a rectangular region of dst.
+		 *
+		 * @param dst The array to be filled
+		 * @param origin Position of the region, one index for each dimension
+		 * @param extents Size of the region, one size for each dimension
+		 * @param value The value to be assigned
+		 * @exception std::out_of_range if the region exceeds dst
+		 * @exception std::invalid_argument if dst is not rectangular
+		*/
+		friend CPP20_DYNARRAY_CONSTEXPR void fill_region(dynarray &dst, const size_type (&origin)[dimensions], const size_type (&extents)[dimensions], const internal_value_type &value)
+		{
+			dst.fill_region_with(origin, extents, value);
+		}
+
+		/*!
+		 * @brief Writes a dynarray to a binary stream.
+		 *
+		 * The header records rank, extents, element type, byte order and alignment. A jagged array stores an offset table after it.
+		 * The contiguous block follows at a 64-byte aligned offset, and is written with a single write.
+		 * Elements must be trivially copyable.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		*/
+		friend std::ostream& save_binary(std::ostream &output, const dynarray &input)
+		{
+			input.write_binary(output);
+			return output;
+		}
+
+		/*!
+		 * @brief Reads a dynarray written by save_binary, the contiguous block is read with a single read.
+		 *
+		 * output is left unchanged if input runs out, check the state of input.
+		 * If output is an inner layer, only the values are replaced, the same way as operator=.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, or does not match the rank or the element type of output
+		*/
+		friend std::istream& load_binary(std::istream &input, dynarray &output)
+		{
+			output.read_stream<internal_impl::binary_format>(input);
+			return input;
+		}
+
+		/*!
+		 * @brief Turns output into a view of data written by save_binary, without copying the elements.
+		 *
+		 * Only the nodes are allocated, the elements stay in buffer, which has to outlive output.
+		 * output does not own buffer, like an inner layer: moving it out copies the elements into a new array.
+		 * Any buffer aligned to 64 bytes, such as a mapped file, keeps the elements suitably aligned.
+		 *
+		 * @param buffer Data written by save_binary
+		 * @param length Size of buffer in bytes
+		 * @param output The array to become a view, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void view_binary(void *buffer, std::size_t length, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::binary_format>(buffer, length, nullptr);
+		}
+
+		/*!
+		 * @brief Same as view_binary, but output also takes over the contiguous block.
+		 *
+		 * The block (at buffer + block offset) will be released with owner.deallocate(block, element count), and elements are not destroyed before that.
+		 * This lets an allocator hand in storage it did not allocate itself, such as a memory-mapped file.
+		 * If the data holds no elements, output becomes empty and the block stays with the caller.
+		 *
+		 * @param buffer Data written by save_binary
+		 * @param length Size of buffer in bytes
+		 * @param owner Allocator that releases the block, it replaces the allocator of output
+		 * @param output The array to take over the block, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void adopt_binary(void *buffer, std::size_t length, const contiguous_allocator_type &owner, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::binary_format>(buffer, length, &owner);
+		}
+
+		/*!
+		 * @brief Describes input in the binary format as two segments for writev or sendmsg, the elements are not copied.
+		 *
+		 * segments[0] refers to the returned header, the same bytes as save_binary writes in front of the elements,
+		 * offset tables of a jagged array included. segments[1] refers to the contiguous block shared by all nodes of input.
+		 * Keep the returned header alive, and input unchanged, until the data has been sent.
+		 *
+		 * @param input The array to be sent
+		 * @param segments Receives the two segments, struct iovec or any type with iov_base and iov_len
+		 * @return Storage of the header
+		*/
+		template<typename Segment>
+		friend std::unique_ptr<char[]> to_iovecs(const dynarray &input, Segment (&segments)[2])
+		{
+			static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
+			internal_impl::binary_prefix prefix = input.make_binary_prefix();
+			segments[0].iov_base = prefix.bytes.get();
+			segments[0].iov_len = prefix.length;
+			segments[1].iov_base = input.this_level_array_head;
+			segments[1].iov_len = input.get_element_count() * sizeof(internal_value_type);
+			return std::move(prefix.bytes);
+		}
+
+		/*!
+		 * @brief Turns output into a view of data received into segments, such as the buffers filled by readv or recvmsg.
+		 *
+		 * segments[0] starts with the header produced by to_iovecs or save_binary. The elements follow it in the same segment,
+		 * or fill segments[1] if segments[0] ends at the block offset. The elements are not copied: the same as view_binary,
+		 * output does not own the buffers, which have to outlive it.
+		 *
+		 * @param segments Received data, struct iovec or any type with iov_base and iov_len
+		 * @param count Number of segments
+		 * @param output The array to become a view, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		template<typename Segment>
+		friend void from_iovecs(const Segment *segments, std::size_t count, dynarray &output)
+		{
+			output.attach_segments(segments, count);
+		}
+
+		/*!
+		 * @brief Writes a dynarray in the binary format with the contiguous block compressed, for checkpoints of large arrays.
+		 *
+		 * The block is split into chunks of about 1 MiB. The bytes of each chunk are shuffled (byte k of every element grouped together,
+		 * which turns the exponents of floating point grids into long runs) and then compressed with a fast LZ77 codec.
+		 * A chunk which does not shrink is stored as it is. Every chunk can be decompressed independently.
+		 * Elements must be trivially copyable.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		*/
+		friend std::ostream& save_compressed(std::ostream &output, const dynarray &input)
+		{
+			input.write_compressed(internal_impl::sequenced_tasks(), output);
+			return output;
+		}
+
+		/*!
+		 * @brief Same as save_compressed(output, input), the chunks are compressed according to policy.
+		 *
+		 * Include <execution> to use the policies.
+		 *
+		 * @param policy The execution policy to use
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		*/
+		template<typename ExecutionPolicy>
+		friend std::ostream& save_compressed(ExecutionPolicy &&policy, std::ostream &output, const dynarray &input)
+		{
+			input.write_compressed(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, output);
+			return output;
+		}
+
+		/*!
+		 * @brief Reads a dynarray written by save_compressed, the chunks are decompressed straight into the contiguous block.
+		 *
+		 * output is left unchanged if input runs out, check the state of input.
+		 * If output is an inner layer, only the values are replaced, the same way as operator=.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, or does not match the rank or the element type of output
+		*/
+		friend std::istream& load_compressed(std::istream &input, dynarray &output)
+		{
+			output.read_stream<internal_impl::compressed_format>(input, [](std::istream &source, auto *block, std::size_t count)
+				{ return internal_impl::read_compressed_block(internal_impl::sequenced_tasks(), source, block, count); });
+			return input;
+		}
+
+		/*!
+		 * @brief Same as load_compressed(input, output), the chunks are decompressed according to policy.
+		 *
+		 * Include <execution> to use the policies.
+		 *
+		 * @param policy The execution policy to use
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		*/
+		template<typename ExecutionPolicy>
+		friend std::istream& load_compressed(ExecutionPolicy &&policy, std::istream &input, dynarray &output)
+		{
+			internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>> run_tasks{ policy };
+			output.read_stream<internal_impl::compressed_format>(input, [&run_tasks](std::istream &source, auto *block, std::size_t count)
+				{ return internal_impl::read_compressed_block(run_tasks, source, block, count); });
+			return input;
+		}
+
+		/*!
+		 * @brief Starts recording writes to the contiguous block of array, see dirty_regions.
+		 *
+		 * The record refers to the current block, it becomes invalid once array is resized, moved from, or destroyed.
+		 *
+		 * @param array The array to be tracked
+		 * @param chunk_elements Number of elements covered by each bit, elements covering 64 KiB by default
+		 * @return An empty bitmap
+		*/
+		friend dirty_regions<internal_value_type> track_dirty(dynarray &array, std::size_t chunk_elements = std::max<std::size_t>(1, internal_impl::dirty_chunk_length / sizeof(internal_value_type)))
+		{
+			return dirty_regions<internal_value_type>(array.this_level_array_head, array.get_element_count(), chunk_elements);
+		}
+
+		/*!
+		 * @brief Writes only the chunks of input marked in dirty, each run of dirty chunks with a single write, and then clears dirty.
+		 *
+		 * Starting from a full checkpoint written by save_binary, load_delta of every delta in order restores input.
+		 * The header is the same as save_binary writes, so load_delta checks the shape and the element type.
+		 * input must not be written while the delta is being saved.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @param dirty Created by track_dirty(input)
+		 * @return output
+		 * @exception std::invalid_argument if dirty does not belong to input
+		*/
+		friend std::ostream& save_delta(std::ostream &output, const dynarray &input, dirty_regions<internal_value_type> &dirty)
+		{
+			input.write_delta(output, dirty);
+			return output;
+		}
+
+		/*!
+		 * @brief Applies a delta written by save_delta to output in place, the chunks are read straight into the contiguous block.
+		 *
+		 * output must have the same shape as the array which was saved. If input runs out, output may have been partly updated,
+		 * check the state of input.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be updated
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, or does not match the shape or the element type of output
+		*/
+		friend std::istream& load_delta(std::istream &input, dynarray &output)
+		{
+			output.read_delta(input);
+			return input;
+		}
+
+		/*!
+		 * @brief Writes a rectangular dynarray as a NumPy .npy file (C order), the contiguous block is written with a single write.
+		 *
+		 * The file can be opened by numpy.load, including with mmap_mode, since the data starts at a 64-byte aligned offset.
+		 * Elements must be of an arithmetic type.
+		 *
+		 * @param output The output stream, opened in binary mode
+		 * @param input The array to be written
+		 * @return output
+		 * @exception std::invalid_argument if input is jagged
+		*/
+		friend std::ostream& save_npy(std::ostream &output, const dynarray &input)
+		{
+			input.write_npy(output);
+			return output;
+		}
+
+		/*!
+		 * @brief Reads a NumPy .npy file in C order with the same element type and number of dimensions, the same way as load_binary.
+		 *
+		 * @param input The input stream, opened in binary mode
+		 * @param output The array to be replaced
+		 * @return input
+		 * @exception std::invalid_argument if the data is broken, in Fortran order, or does not match the rank or the element type of output
+		*/
+		friend std::istream& load_npy(std::istream &input, dynarray &output)
+		{
+			output.read_stream<internal_impl::npy_format>(input);
+			return input;
+		}
+
+		/*!
+		 * @brief Turns output into a view of a NumPy .npy file in memory, the same way as view_binary.
+		 *
+		 * @param buffer Content of the .npy file
+		 * @param length Size of buffer in bytes
+		 * @param output The array to become a view, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void view_npy(void *buffer, std::size_t length, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::npy_format>(buffer, length, nullptr);
+		}
+
+		/*!
+		 * @brief Same as view_npy, but output also takes over the contiguous block, the same way as adopt_binary.
+		 *
+		 * @param buffer Content of the .npy file
+		 * @param length Size of buffer in bytes
+		 * @param owner Allocator that releases the block, it replaces the allocator of output
+		 * @param output The array to take over the block, should be an outer-most layer
+		 * @exception std::invalid_argument if the data is broken or too short, does not match output, or the elements are misaligned
+		*/
+		friend void adopt_npy(void *buffer, std::size_t length, const contiguous_allocator_type &owner, dynarray &output)
+		{
+			output.attach_buffer<internal_impl::npy_format>(buffer, length, &owner);
+		}
+
+		/*!
+		 * @brief Reads the elements of output from source, rows_per_step outer rows at a time, straight into the storage of output.
+		 *
+		 * The elements are read in the order of the contiguous block, output must already have its final shape.
+		 * Each group is handed to process(first_row, last_row) as soon as it has arrived, while the next group is being read asynchronously.
+		 * No intermediate buffer is used.
+		 *
+		 * @param source A std::streambuf, or read_bytes(bytes, length) returning false on failure, such as a wrapper of ::read
+		 * @param output The array to be filled
+		 * @param rows_per_step Number of outer rows read at a time
+		 * @param process Called on the calling thread with the range [first_row, last_row)
+		 * @return false if source runs out or fails
+		 * @exception std::invalid_argument if rows_per_step is 0
+		*/
+		template<typename Source, typename RowFunction>
+		friend bool read_rows(Source &&source, dynarray &output, size_type rows_per_step, RowFunction &&process)
+		{
+			static_assert(std::is_trivially_copyable_v<internal_value_type>, "streaming requires trivially copyable elements");
+			return output.transfer_rows<true>(internal_impl::byte_transfer<true>(source), rows_per_step, process);
+		}
+
+		/*!
+		 * @brief Writes the elements of input to sink, rows_per_step outer rows at a time, straight from the storage of input.
+		 *
+		 * Each group is first passed to produce(first_row, last_row), which may fill it, and then written asynchronously
+		 * while produce works on the next group. No second copy of the array is made.
+		 *
+		 * @param sink A std::streambuf, or write_bytes(bytes, length) returning false on failure, such as a wrapper of ::write
+		 * @param input The array to be written
+		 * @param rows_per_step Number of outer rows written at a time
+		 * @param produce Called on the calling thread with the range [first_row, last_row)
+		 * @return false if sink fails
+		 * @exception std::invalid_argument if rows_per_step is 0
+		*/
+		template<typename Sink, typename RowFunction>
+		friend bool write_rows(Sink &&sink, dynarray &input, size_type rows_per_step, RowFunction &&produce)
+		{
+			static_assert(std::is_trivially_copyable_v<internal_value_type>, "streaming requires trivially copyable elements");
+			return input.transfer_rows<false>(internal_impl::byte_transfer<false>(sink), rows_per_step, produce);
+		}
+
+		/*!
+		 * @brief Parses numbers separated by delimiter and line breaks, one line per row, and replaces output with them.
+		 *
+		 * A first pass counts the rows and the columns, then the elements are parsed with std::from_chars straight into the
+		 * contiguous block, which is never initialised beforehand. No intermediate string or container is created.
+		 * Blank lines are skipped, and a row with a different number of columns makes output jagged.
+		 * If output is an inner layer, only the values are replaced, the same way as operator=.
+		 *
+		 * @param text The whole text, such as the content of a CSV or TSV file
+		 * @param output The array to be replaced
+		 * @param delimiter ',' for CSV, '\t' for TSV
+		 * @exception std::invalid_argument if a field is not a number, output is left unchanged
+		*/
+		friend void parse_delimited(std::string_view text, dynarray &output, char delimiter = ',')
+		{
+			output.parse_text(internal_impl::sequenced_tasks(), text, delimiter);
+		}
+
+		/*!
+		 * @brief Same as parse_delimited(text, output, delimiter), pieces of the text are counted and parsed according to policy.
+		 *
+		 * Include <execution> to use the policies.
+		 *
+		 * @param policy The execution policy to use
+		 * @param text The whole text, such as the content of a CSV or TSV file
+		 * @param output The array to be replaced
+		 * @param delimiter ',' for CSV, '\t' for TSV
+		*/
+		template<typename ExecutionPolicy>
+		friend void parse_delimited(ExecutionPolicy &&policy, std::string_view text, dynarray &output, char delimiter = ',')
+		{
+			output.parse_text(internal_impl::policy_tasks<std::remove_reference_t<ExecutionPolicy>>{ policy }, text, delimiter);
+		}
+	};
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::size_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_list(std::initializer_list<Ty> init)
+	{
+		size_type count = 0;
+		for (Ty sub_list : init)
+			count += dynarray<T, _Allocator>::expand_list(sub_list);
+		return count;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::size_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_counts(size_type count, Args && ...args)
+	{
+		return dynarray<T, _Allocator>::expand_counts(std::forward<Args>(args)...) * count;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocator(const allocator_type &_allocator)
+	{
+		return contiguous_allocator_type();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocator(const allocator_type &_allocator, Args && ...args)
+	{
+		return dynarray<T, _Allocator>::expand_allocator(std::forward<Args>(args)...);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Skip>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocators(const Skip &skip, const allocator_type &_allocator)
+	{
+		return contiguous_allocator_type();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Skip, typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocators(const Skip &skip, const allocator_type &_allocator, Args && ...args)
+	{
+		return dynarray<T, _Allocator>::expand_allocators(std::forward<Args>(args)...);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::initialise(const allocator_type &other_allocator)
+	{
+		contiguous_allocator = contiguous_allocator_type();
+
+		array_allocator = other_allocator;
+		reset();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::reset()
+	{
+		entire_array_data = nullptr;
+		current_dimension_array_size = 0;
+		current_dimension_array_data = nullptr;
+		this_level_array_head = nullptr;
+		this_level_array_tail = nullptr;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::verify_size(size_type count)
+	{
+		if (count > static_cast<size_type>(std::numeric_limits<difference_type>::max()))
+			throw std::length_error("array too long");
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(size_type count)
+	{
+		if (count == 0)
+		{
+			reset();
+			return;
+		}
+
+		verify_size(count);
+		current_dimension_array_size = count;
+		entire_array_data = current_dimension_array_data = array_allocator.allocate(count);
+		for (size_type i = 0; i < count; ++i)
+			std::allocator_traits<allocator_type>::construct(array_allocator, entire_array_data + i);
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count)
+	{
+		reset();
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(size_type count, Args&& ...args)
+	{
+		verify_size(count);
+		size_type each_block_size = dynarray<T, _Allocator>::expand_counts(std::forward<Args>(args)...);
+
+		verify_size(each_block_size);
+
+		size_type entire_array_size = each_block_size * count;
+		verify_size(entire_array_size);
+
+		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
+		if (nested_level > sizeof...(args) || entire_array_size == 0)
+		{
+			reset();
+			return;
+		}
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+
+		current_dimension_array_size = count;
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			internal_pointer_type starting_address = entire_array_data + i * each_block_size;
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(starting_address, std::forward<Args>(args)...);
+		}
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count, Args&& ... args)
+	{
+		entire_array_data = nullptr;	// always nullptr in nested-dynarray
+
+		size_type each_block_size = dynarray<T, _Allocator>::expand_counts(std::forward<Args>(args)...);
+		current_dimension_array_size = count;
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			internal_pointer_type next_starting_address = starting_address + i * each_block_size;
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(next_starting_address, std::forward<Args>(args)...);
+		}
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + each_block_size * count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename _Alloc_t, typename, typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(size_type count, _Alloc_t &&other_allocator, Args&& ... args)
+	{
+		verify_size(count);
+
+		size_type each_block_size = internal_impl::expand_parameters(std::forward<Args>(args)...);
+		contiguous_allocator = expand_allocators(std::forward<Args>(args)...);
+		verify_size(each_block_size);
+
+		size_type entire_array_size = each_block_size * count;
+		verify_size(entire_array_size);
+
+		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
+		if (nested_level * 2 > sizeof...(args) || entire_array_size == 0)
+		{
+			reset();
+			return;
+		}
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+
+		current_dimension_array_size = count;
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			internal_pointer_type starting_address = entire_array_data + i * each_block_size;
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(starting_address, std::forward<Args>(args)...);
+		}
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename _Alloc_t, typename, typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count,
+			_Alloc_t &&other_allocator, Args&& ... args)
+	{
+		entire_array_data = nullptr;	// always nullptr in nested-dynarray
+		array_allocator = other_allocator;
+
+		size_type each_block_size = internal_impl::expand_parameters(std::forward<Args>(args)...);
+		contiguous_allocator = expand_allocators(std::forward<Args>(args)...);
+
+		current_dimension_array_size = count;
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			internal_pointer_type next_starting_address = starting_address + i * each_block_size;
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(next_starting_address, other_allocator, std::forward<Args>(args)...);
+		}
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + each_block_size * count - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list)
+	{
+		size_type count = input_list.size();
+		if (count == 0) return;
+		verify_size(count);
+
+		size_type entire_array_size = expand_list(input_list);
+		if (entire_array_size == 0) return;
+		verify_size(entire_array_size);
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+
+		current_dimension_array_size = count;
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		auto list_iter = input_list.begin();
+		internal_pointer_type starting_address = entire_array_data;
+		for (size_type i = 0; i < current_dimension_array_size; ++i, ++list_iter)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(starting_address, *list_iter);
+			starting_address += dynarray<T, _Allocator>::expand_list(*list_iter);
+		}
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty, typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list, Args&& ...args)
+	{
+		size_type count = input_list.size();
+		if (count == 0) return;
+		verify_size(count);
+
+		size_type entire_array_size = expand_list(input_list);
+		if (entire_array_size == 0) return;
+		verify_size(entire_array_size);
+
+		contiguous_allocator = expand_allocator(std::forward<Args>(args)...);
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+
+		current_dimension_array_size = count;
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		auto list_iter = input_list.begin();
+		internal_pointer_type starting_address = entire_array_data;
+		for (size_type i = 0; i < current_dimension_array_size; ++i, ++list_iter)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(starting_address, *list_iter, std::forward<Args>(args)...);
+			starting_address += dynarray<T, _Allocator>::expand_list(*list_iter);
+		}
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty, typename ... Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list, const allocator_type &other_allocator, Args&& ...args)
+	{
+		array_allocator = other_allocator;
+		size_type count = input_list.size();
+		verify_size(count);
+		current_dimension_array_size = count;
+		entire_array_data = nullptr;
+
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		auto list_iter = input_list.begin();
+		internal_pointer_type next_starting_address = starting_address;
+		for (size_type i = 0; i < current_dimension_array_size; ++i, ++list_iter)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->allocate_array(next_starting_address, *list_iter, std::forward<Args>(args)...);
+			next_starting_address += dynarray<T, _Allocator>::expand_list(*list_iter);
+		}
+
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + expand_list(input_list) - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::deallocate_array()
+	{
+		if (current_dimension_array_data)
+		{
+			for (size_type i = current_dimension_array_size; i != 0; --i)
+				std::allocator_traits<allocator_type>::destroy(array_allocator, current_dimension_array_data + i - 1);
+			array_allocator.deallocate(current_dimension_array_data, current_dimension_array_size);
+			current_dimension_array_data = nullptr;
+		}
+
+		if (entire_array_data)
+		{
+			size_type entire_array_size = static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
+			for (size_type i = entire_array_size; i != 0; --i)
+				std::allocator_traits<contiguous_allocator_type>::destroy(contiguous_allocator, entire_array_data + i - 1);
+			contiguous_allocator.deallocate(entire_array_data, entire_array_size);
+			entire_array_data = nullptr;
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(const dynarray &other)
+	{
+		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+		if (entire_array_size == 0 || other.current_dimension_array_size == 0) return;
+		current_dimension_array_size = other.current_dimension_array_size;
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
+		internal_impl::copy_construct_block(contiguous_allocator, entire_array_data, other_array_data, entire_array_size);
+
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		internal_pointer_type starting_address = entire_array_data;
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->copy_array(starting_address, *(other.current_dimension_array_data + i));
+			starting_address += other[i].get_block_size();
+		}
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(const dynarray &other, const allocator_type &other_allocator, Args&&... args)
+	{
+		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+		if (entire_array_size == 0 || other.current_dimension_array_size == 0) return;
+		current_dimension_array_size = other.current_dimension_array_size;
+
+		contiguous_allocator = expand_allocator(std::forward<Args>(args)...);
+
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
+		internal_impl::copy_construct_block(contiguous_allocator, entire_array_data, other_array_data, entire_array_size);
+
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		internal_pointer_type starting_address = entire_array_data;
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->copy_array(starting_address, *(other.current_dimension_array_data + i), std::forward<Args>(args)...);
+			starting_address += other[i].get_block_size();
+		}
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other)
+	{
+		current_dimension_array_size = other.current_dimension_array_size;
+		entire_array_data = nullptr;
+
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		internal_pointer_type next_starting_address = starting_address;
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->copy_array(next_starting_address, *(other.current_dimension_array_data + i));
+			next_starting_address += other[i].get_block_size();
+		}
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + other.get_block_size() - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ...Args>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other,
+			const allocator_type &other_allocator, Args&& ... args)
+	{
+		array_allocator = other_allocator;
+		current_dimension_array_size = other.current_dimension_array_size;
+		entire_array_data = nullptr;
+
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		internal_pointer_type next_starting_address = starting_address;
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->copy_array(next_starting_address, *(other.current_dimension_array_data + i), std::forward<Args>(args)...);
+			next_starting_address += other[i].get_block_size();
+		}
+		this_level_array_head = starting_address;
+		this_level_array_tail = this_level_array_head + other.get_block_size() - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename InputIterator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(InputIterator other_begin, InputIterator other_end)
+	{
+		static_assert(std::is_same_v<std::decay_t<decltype(*other_begin)>, T>,
+			"invalid iterator, cannot convert to a valid dynarray");
+
+		size_type count = static_cast<size_type>(std::abs(other_end - other_begin));
+		if (count == 0) return;
+
+		internal_pointer_type start_address = other_begin->this_level_array_head;
+		internal_pointer_type end_address = (other_end - 1)->this_level_array_tail;
+		size_type entire_array_size = static_cast<size_type>(end_address - start_address + 1);
+		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		current_dimension_array_size = count;
+
+		internal_impl::copy_construct_block(contiguous_allocator, entire_array_data, start_address, entire_array_size);
+
+		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+		InputIterator other = other_begin;
+		internal_pointer_type starting_address = entire_array_data;
+		for (size_type i = 0; i < current_dimension_array_size; ++i, ++other)
+		{
+			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+			(current_dimension_array_data + i)->copy_array(starting_address, *other);
+			starting_address += other->get_block_size();
+		}
+
+		this_level_array_head = entire_array_data;
+		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::loop_copy(const dynarray &other) noexcept
+	{
+		if (size() == 0 || other.size() == 0) return;
+
+		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
+			*(current_dimension_array_data + i) = *(other.current_dimension_array_data + i);
+	}
 
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::loop_copy(std::initializer_list<internal_value_type> input_list) noexcept
+	{
+		size_type count = input_list.size();
+		if (size() == 0 || count == 0) return;
 
-		/**** Non-member functions  ***/
+		auto list_iter = input_list.begin();
+		for (size_type i = 0; i < count && i < current_dimension_array_size; ++i, ++list_iter)
+			*(this_level_array_head + i) = *list_iter;
+	}
 
-		/*!
-		 * @brief Exchanges the contents of the container with those of other.
-		 *
-		 * If both of the containers are outter-most layer, they will be swapped completely, including sizes.
-		 *
-		 * Otherwise swap the contents only.
-		 *
-		 * @param lhs A dynarray
-		 * @param rhs Another dynarray
-		 * @return
-		*/
-		friend CPP20_DYNARRAY_CONSTEXPR void swap(dynarray &lhs, dynarray &rhs) noexcept { lhs.swap_outside(rhs); }
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Ty>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::loop_copy(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept
+	{
+		size_type count = input_list.size();
+		if (size() == 0 || count == 0) return;
 
-		/*!
-		 * @brief Replaces old_array with new_array and returns the old value of old_array.
-		 *
-		 * If old_array is an inner layer, exchange() will replaces the contents of the container only, the size of old_array will keeps unchanged.
-		 *
-		 * @param old_array Old array to be replaced
-		 * @param new_array New array replace with
-		 * @return The value of old_array
-		*/
-		friend CPP20_DYNARRAY_CONSTEXPR dynarray exchange(dynarray &old_array, dynarray &&new_array) noexcept
-		{
-			dynarray current_array = std::move(old_array);
-			if (old_array.entire_array_data == nullptr && old_array.current_dimension_array_size > 0)
-			{
-				old_array.swap(new_array);
-			}
-			else
-			{
-				if (new_array.entire_array_data == nullptr && new_array.current_dimension_array_size > 0)
-				{
-					dynarray temp_array = std::move(new_array);
-					old_array.swap_all(temp_array);
-				}
-				else
-				{
-					old_array.swap_all(new_array);
-				}
-			}
-			return current_array;
-		}
+		auto list_iter = input_list.begin();
+		for (size_type i = 0; i < count && i < current_dimension_array_size; ++i, ++list_iter)
+			(current_dimension_array_data + i)->loop_copy(*list_iter);
+	}
 
-		friend CPP20_DYNARRAY_CONSTEXPR bool operator==(const dynarray &lhs, const dynarray &rhs)
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::move_array(dynarray &other) noexcept
+	{
+		if (other.empty())
 		{
-			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+			initialise();
+			return;
 		}
 
-#ifdef DYNARRAY_USING_CPP20
-		friend CPP20_DYNARRAY_CONSTEXPR auto operator<=>(const dynarray &lhs, const dynarray &rhs)
-		{
-			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-		}
-#else
-		friend bool operator!=(const dynarray &lhs, const dynarray &rhs)
+		if (other.entire_array_data == nullptr)
 		{
-			return !(lhs == rhs);
-		}
+			initialise();
 
-		friend bool operator<(const dynarray &lhs, const dynarray &rhs)
-		{
-			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-		}
+			size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
+			if (entire_array_size == 0 || other.current_dimension_array_size == 0) return;
+			current_dimension_array_size = other.current_dimension_array_size;
 
-		friend bool operator>(const dynarray &lhs, const dynarray &rhs)
-		{
-			return rhs < lhs;
-		}
+			entire_array_data = contiguous_allocator.allocate(entire_array_size);
+			internal_pointer_type other_array_data = other.this_level_array_head;
+			for (size_type i = 0; i < entire_array_size; ++i)
+				std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::move(*(other_array_data + i)));
 
-		friend bool operator<=(const dynarray &lhs, const dynarray &rhs)
-		{
-			return !(rhs < lhs);
+			current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+			internal_pointer_type starting_address = entire_array_data;
+			for (size_type i = 0; i < current_dimension_array_size; ++i)
+			{
+				std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
+				(current_dimension_array_data + i)->copy_array(starting_address, *(other.current_dimension_array_data + i));
+				starting_address += other[i].get_block_size();
+			}
+			this_level_array_head = entire_array_data;
+			this_level_array_tail = this_level_array_head + entire_array_size - 1;
 		}
-
-		friend bool operator>=(const dynarray &lhs, const dynarray &rhs)
+		else
 		{
-			return !(lhs < rhs);
+			array_allocator = other.array_allocator;
+			contiguous_allocator = other.contiguous_allocator;
+			entire_array_data = other.entire_array_data;
+			current_dimension_array_size = other.current_dimension_array_size;
+			current_dimension_array_data = other.current_dimension_array_data;
+			this_level_array_head = other.this_level_array_head;
+			this_level_array_tail = other.this_level_array_tail;
+			other.reset();
 		}
-#endif
-	};
+	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::size_type
-		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_list(std::initializer_list<Ty> init)
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::move_values(dynarray &other) noexcept
 	{
-		size_type count = 0;
-		for (Ty sub_list : init)
-			count += dynarray<T, _Allocator>::expand_list(sub_list);
-		return count;
+		if (size() == 0 || other.size() == 0) return;
+
+		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
+			*(current_dimension_array_data + i) = std::move(*(other.current_dimension_array_data + i));
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::size_type
-		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_counts(size_type count, Args && ...args)
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::swap_all(dynarray &other) noexcept
 	{
-		return dynarray<T, _Allocator>::expand_counts(std::forward<Args>(args)...) * count;
+		std::swap(entire_array_data, other.entire_array_data);
+		std::swap(current_dimension_array_size, other.current_dimension_array_size);
+		std::swap(current_dimension_array_data, other.current_dimension_array_data);
+		std::swap(this_level_array_head, other.this_level_array_head);
+		std::swap(this_level_array_tail, other.this_level_array_tail);
+		std::swap(array_allocator, other.array_allocator);
+		std::swap(contiguous_allocator, other.contiguous_allocator);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
-		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocator(const allocator_type &_allocator)
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::swap_outside(dynarray &other) noexcept
 	{
-		return contiguous_allocator_type();
+		if ((entire_array_data == nullptr && current_dimension_array_size > 0) ||
+			(other.entire_array_data == nullptr && other.current_dimension_array_size > 0))
+			swap(other);
+		else
+			swap_all(other);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
-		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocator(const allocator_type &_allocator, Args && ...args)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::reference
+		dynarray<dynarray<T, _Allocator>, _Allocator>::at(size_type pos)
 	{
-		return dynarray<T, _Allocator>::expand_allocator(std::forward<Args>(args)...);
+		if (pos >= size())
+			throw std::out_of_range("out of range, incorrect position");
+		return (*this)[pos];
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Skip>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
-		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocators(const Skip &skip, const allocator_type &_allocator)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::const_reference
+		dynarray<dynarray<T, _Allocator>, _Allocator>::at(size_type pos) const
 	{
-		return contiguous_allocator_type();
+		if (pos >= size())
+			throw std::out_of_range("out of range, incorrect position");
+		return (*this)[pos];
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Skip, typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::contiguous_allocator_type
-		dynarray<dynarray<T, _Allocator>, _Allocator>::expand_allocators(const Skip &skip, const allocator_type &_allocator, Args && ...args)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::reference
+		dynarray<dynarray<T, _Allocator>, _Allocator>::operator[](size_type pos)
 	{
-		return dynarray<T, _Allocator>::expand_allocators(std::forward<Args>(args)...);
+		return *(current_dimension_array_data + pos);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::initialise(const allocator_type &other_allocator)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::const_reference
+		dynarray<dynarray<T, _Allocator>, _Allocator>::operator[](size_type pos) const
 	{
-		contiguous_allocator = contiguous_allocator_type();
-
-		array_allocator = other_allocator;
-		reset();
+		return *(current_dimension_array_data + pos);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::reset()
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::reference
+		dynarray<dynarray<T, _Allocator>, _Allocator>::back()
 	{
-		entire_array_data = nullptr;
-		current_dimension_array_size = 0;
-		current_dimension_array_data = nullptr;
-		this_level_array_head = nullptr;
-		this_level_array_tail = nullptr;
+		return (*this)[current_dimension_array_size - 1];
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::verify_size(size_type count)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::const_reference
+		dynarray<dynarray<T, _Allocator>, _Allocator>::back() const
 	{
-		if (count > static_cast<size_type>(std::numeric_limits<difference_type>::max()))
-			throw std::length_error("array too long");
+		return (*this)[current_dimension_array_size - 1];
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(size_type count)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::swap(dynarray &other) noexcept
 	{
-		if (count == 0)
+		// the elements of both arrays line up when the shapes are the same, swap them in one pass
+		if (same_shape(other))
 		{
-			reset();
+			if (this_level_array_head != nullptr)
+				internal_impl::swap_block(this_level_array_head, other.this_level_array_head, static_cast<size_type>(this_level_array_tail - this_level_array_head + 1));
 			return;
 		}
 
-		verify_size(count);
-		current_dimension_array_size = count;
-		entire_array_data = current_dimension_array_data = array_allocator.allocate(count);
-		for (size_type i = 0; i < count; ++i)
-			std::allocator_traits<allocator_type>::construct(array_allocator, entire_array_data + i);
-
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + count - 1;
+		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
+			(current_dimension_array_data + i)->swap(other[i]);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::fill(const internal_value_type &value)
 	{
-		reset();
+		for (auto current_address = this_level_array_head;
+			current_address != this_level_array_tail + 1;
+			++current_address)
+			*current_address = value;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename ... Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(size_type count, Args&& ...args)
+	inline CPP20_DYNARRAY_CONSTEXPR bool
+		dynarray<dynarray<T, _Allocator>, _Allocator>::get_extents(size_type *extents) const
 	{
-		verify_size(count);
-		size_type each_block_size = dynarray<T, _Allocator>::expand_counts(std::forward<Args>(args)...);
-
-		verify_size(each_block_size);
-
-		size_type entire_array_size = each_block_size * count;
-		verify_size(entire_array_size);
-
-		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
-		if (nested_level > sizeof...(args) || entire_array_size == 0)
+		constexpr size_type rank = internal_impl::inner_type<Td, _Allocator>::nested_level + 1;
+		extents[0] = current_dimension_array_size;
+		if (current_dimension_array_size == 0)
 		{
-			reset();
-			return;
+			std::fill(extents + 1, extents + rank, 0);
+			return true;
 		}
 
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		if (!current_dimension_array_data->get_extents(extents + 1))
+			return false;
 
-		current_dimension_array_size = count;
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		size_type row_extents[rank - 1] = {};
+		for (size_type i = 1; i < current_dimension_array_size; ++i)
 		{
-			internal_pointer_type starting_address = entire_array_data + i * each_block_size;
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(starting_address, std::forward<Args>(args)...);
+			if (!(current_dimension_array_data + i)->get_extents(row_extents) ||
+				!std::equal(row_extents, row_extents + rank - 1, extents + 1))
+				return false;
 		}
-
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+		return true;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename ... Args>
+	template<typename TaskRunner, typename BinaryOperation>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count, Args&& ... args)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::scan_along(const TaskRunner &run_tasks, size_type axis, BinaryOperation op, const internal_value_type *init)
 	{
-		entire_array_data = nullptr;	// always nullptr in nested-dynarray
+		constexpr size_type rank = internal_impl::inner_type<Td, _Allocator>::nested_level + 1;
+		if (axis >= rank)
+			throw std::out_of_range("out of range, incorrect axis");
 
-		size_type each_block_size = dynarray<T, _Allocator>::expand_counts(std::forward<Args>(args)...);
-		current_dimension_array_size = count;
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
-		{
-			internal_pointer_type next_starting_address = starting_address + i * each_block_size;
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(next_starting_address, std::forward<Args>(args)...);
-		}
+		size_type extents[rank] = {};
+		if (!get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + each_block_size * count - 1;
+		internal_impl::scan_along_axis(this_level_array_head, extents, rank, axis, op, init, run_tasks);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename _Alloc_t, typename, typename ... Args>
+	template<typename TaskRunner>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(size_type count, _Alloc_t &&other_allocator, Args&& ... args)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::summed_area(const TaskRunner &run_tasks)
 	{
-		verify_size(count);
+		size_type extents[2] = {};
+		if (!get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
 
-		size_type each_block_size = internal_impl::expand_parameters(std::forward<Args>(args)...);
-		contiguous_allocator = expand_allocators(std::forward<Args>(args)...);
-		verify_size(each_block_size);
+		internal_impl::summed_area(this_level_array_head, extents[0], extents[1], run_tasks);
+	}
 
-		size_type entire_array_size = each_block_size * count;
-		verify_size(entire_array_size);
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename U>
+	inline CPP20_DYNARRAY_CONSTEXPR bool
+		dynarray<dynarray<T, _Allocator>, _Allocator>::same_shape(const dynarray<U, _Allocator> &other) const noexcept
+	{
+		if (current_dimension_array_size != other.current_dimension_array_size)
+			return false;
+		for (size_type i = 0; i < current_dimension_array_size; ++i)
+			if (!(current_dimension_array_data + i)->same_shape(other[i]))
+				return false;
+		return true;
+	}
 
-		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
-		if (nested_level * 2 > sizeof...(args) || entire_array_size == 0)
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR bool
+		dynarray<dynarray<T, _Allocator>, _Allocator>::equal_to(const dynarray &other) const
+	{
+		if constexpr (internal_impl::is_bitwise_comparable_v<internal_value_type>)
 		{
-			reset();
-			return;
+			if (!same_shape(other))
+				return false;
+			size_type count = get_element_count();
+			return internal_impl::equal_bitwise(this_level_array_head, other.this_level_array_head, count);
 		}
+		else
+			return std::equal(begin(), end(), other.begin(), other.end());
+	}
 
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-
-		current_dimension_array_size = count;
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR std::size_t
+		dynarray<dynarray<T, _Allocator>, _Allocator>::hash_shape(std::size_t seed) const noexcept
+	{
+		seed = internal_impl::hash_combine(seed, current_dimension_array_size);
 		for (size_type i = 0; i < current_dimension_array_size; ++i)
-		{
-			internal_pointer_type starting_address = entire_array_data + i * each_block_size;
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(starting_address, std::forward<Args>(args)...);
-		}
-
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+			seed = (current_dimension_array_data + i)->hash_shape(seed);
+		return seed;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename _Alloc_t, typename, typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, size_type count,
-			_Alloc_t &&other_allocator, Args&& ... args)
+	inline std::size_t
+		dynarray<dynarray<T, _Allocator>, _Allocator>::hash_code() const
 	{
-		entire_array_data = nullptr;	// always nullptr in nested-dynarray
-		array_allocator = other_allocator;
-
-		size_type each_block_size = internal_impl::expand_parameters(std::forward<Args>(args)...);
-		contiguous_allocator = expand_allocators(std::forward<Args>(args)...);
-
-		current_dimension_array_size = count;
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		std::size_t seed = hash_shape(0);
+		size_type count = get_element_count();
+		if constexpr (std::has_unique_object_representations_v<internal_value_type>)
+			return internal_impl::hash_combine(seed, static_cast<std::size_t>(internal_impl::hash_bytes(this_level_array_head, count * sizeof(internal_value_type), seed)));
+		else
 		{
-			internal_pointer_type next_starting_address = starting_address + i * each_block_size;
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(next_starting_address, other_allocator, std::forward<Args>(args)...);
+			std::hash<internal_value_type> element_hash;
+			for (size_type i = 0; i < count; ++i)
+				seed = internal_impl::hash_combine(seed, element_hash(this_level_array_head[i]));
+			return seed;
 		}
+	}
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + each_block_size * count - 1;
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename Index>
+	inline dynarray<typename dynarray<dynarray<T, _Allocator>, _Allocator>::internal_value_type, _Allocator>
+		dynarray<dynarray<T, _Allocator>, _Allocator>::gather_elements(const dynarray<Index, _Allocator> &indices) const
+	{
+		size_type count = indices.size();
+		internal_impl::verify_indices(indices.this_level_array_head, count, get_element_count());
+		const Index *positions = indices.this_level_array_head;
+		auto gathered = [this, positions](size_type i) -> const internal_value_type & { return this_level_array_head[positions[i]]; };
+
+		dynarray<internal_value_type, _Allocator> result;
+		const size_type extents[1] = { count };
+		result.construct_block(extents, [&](auto block, size_type constructing)
+		{
+			internal_impl::generate_elements<1>(result.contiguous_allocator, block, extents, 0, constructing, gathered);
+		});
+		return result;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty>
+	template<typename Index>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::scatter_elements(const dynarray<Index, _Allocator> &indices, const dynarray<internal_value_type, _Allocator> &values)
 	{
-		size_type count = input_list.size();
-		if (count == 0) return;
-		verify_size(count);
+		size_type count = indices.size();
+		if (values.size() != count)
+			throw std::invalid_argument("sizes of indices and values do not match");
 
-		size_type entire_array_size = expand_list(input_list);
-		if (entire_array_size == 0) return;
-		verify_size(entire_array_size);
-
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-
-		current_dimension_array_size = count;
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		auto list_iter = input_list.begin();
-		internal_pointer_type starting_address = entire_array_data;
-		for (size_type i = 0; i < current_dimension_array_size; ++i, ++list_iter)
-		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(starting_address, *list_iter);
-			starting_address += dynarray<T, _Allocator>::expand_list(*list_iter);
-		}
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+		internal_impl::verify_indices(indices.this_level_array_head, count, get_element_count());
+		for (size_type i = 0; i < count; ++i)
+			this_level_array_head[indices.this_level_array_head[i]] = values.this_level_array_head[i];
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty, typename ... Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list, Args&& ...args)
+	template<typename M>
+	inline dynarray<typename dynarray<dynarray<T, _Allocator>, _Allocator>::internal_value_type, _Allocator>
+		dynarray<dynarray<T, _Allocator>, _Allocator>::select_elements(const dynarray<M, _Allocator> &mask) const
 	{
-		size_type count = input_list.size();
-		if (count == 0) return;
-		verify_size(count);
+		if (!same_shape(mask))
+			throw std::invalid_argument("shapes of dynarray and mask do not match");
 
-		size_type entire_array_size = expand_list(input_list);
-		if (entire_array_size == 0) return;
-		verify_size(entire_array_size);
+		size_type count = get_element_count();
+		size_type selected_count = 0;
+		for (size_type i = 0; i < count; ++i)
+			selected_count += static_cast<bool>(mask.this_level_array_head[i]) ? 1 : 0;
 
-		contiguous_allocator = expand_allocator(std::forward<Args>(args)...);
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
+		// called in order, each call returns the next selected element
+		size_type next = 0;
+		auto selected = [this, &mask, &next](size_type) -> const internal_value_type &
+		{
+			while (!static_cast<bool>(mask.this_level_array_head[next]))
+				++next;
+			return this_level_array_head[next++];
+		};
 
-		current_dimension_array_size = count;
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		auto list_iter = input_list.begin();
-		internal_pointer_type starting_address = entire_array_data;
-		for (size_type i = 0; i < current_dimension_array_size; ++i, ++list_iter)
+		dynarray<internal_value_type, _Allocator> result;
+		const size_type extents[1] = { selected_count };
+		result.construct_block(extents, [&](auto block, size_type constructing)
 		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(starting_address, *list_iter, std::forward<Args>(args)...);
-			starting_address += dynarray<T, _Allocator>::expand_list(*list_iter);
-		}
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+			internal_impl::generate_elements<1>(result.contiguous_allocator, block, extents, 0, constructing, selected);
+		});
+		return result;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty, typename ... Args>
+	template<typename M>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::allocate_array(internal_pointer_type starting_address, std::initializer_list<Ty> input_list, const allocator_type &other_allocator, Args&& ...args)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::blend_elements(const dynarray<M, _Allocator> &mask, const dynarray &other)
 	{
-		array_allocator = other_allocator;
-		size_type count = input_list.size();
-		verify_size(count);
-		current_dimension_array_size = count;
-		entire_array_data = nullptr;
-
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		auto list_iter = input_list.begin();
-		internal_pointer_type next_starting_address = starting_address;
-		for (size_type i = 0; i < current_dimension_array_size; ++i, ++list_iter)
-		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->allocate_array(next_starting_address, *list_iter, std::forward<Args>(args)...);
-			next_starting_address += dynarray<T, _Allocator>::expand_list(*list_iter);
-		}
+		if (!same_shape(mask) || !same_shape(other))
+			throw std::invalid_argument("shapes of dynarray and mask do not match");
 
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + expand_list(input_list) - 1;
+		size_type count = get_element_count();
+		for (size_type i = 0; i < count; ++i)
+			this_level_array_head[i] = static_cast<bool>(mask.this_level_array_head[i]) ? this_level_array_head[i] : other.this_level_array_head[i];
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::deallocate_array()
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_region_from(const size_type (&dst_origin)[dimensions], const dynarray &src, const size_type (&src_origin)[dimensions], const size_type (&region)[dimensions])
 	{
-		if (current_dimension_array_data)
-		{
-			for (size_type i = current_dimension_array_size; i != 0; --i)
-				std::allocator_traits<allocator_type>::destroy(array_allocator, current_dimension_array_data + i - 1);
-			array_allocator.deallocate(current_dimension_array_data, current_dimension_array_size);
-			current_dimension_array_data = nullptr;
-		}
-
-		if (entire_array_data)
-		{
-			size_type entire_array_size = static_cast<size_type>(this_level_array_tail - this_level_array_head + 1);
-			for (size_type i = entire_array_size; i != 0; --i)
-				std::allocator_traits<contiguous_allocator_type>::destroy(contiguous_allocator, entire_array_data + i - 1);
-			contiguous_allocator.deallocate(entire_array_data, entire_array_size);
-			entire_array_data = nullptr;
-		}
+		size_type dst_extents[dimensions] = {};
+		size_type src_extents[dimensions] = {};
+		if (!get_extents(dst_extents) || !src.get_extents(src_extents))
+			throw std::invalid_argument("dynarray is not rectangular");
+
+		internal_impl::verify_region(dst_extents, dst_origin, region, dimensions);
+		internal_impl::verify_region(src_extents, src_origin, region, dimensions);
+		internal_impl::copy_box<dimensions>(this_level_array_head, dst_extents, dst_origin, src.this_level_array_head, src_extents, src_origin, region);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(const dynarray &other)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::fill_region_with(const size_type (&origin)[dimensions], const size_type (&region)[dimensions], const internal_value_type &value)
 	{
-		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-		if (entire_array_size == 0 || other.current_dimension_array_size == 0) return;
-		current_dimension_array_size = other.current_dimension_array_size;
+		size_type extents[dimensions] = {};
+		if (!get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
 
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
-		for (size_type i = 0; i < entire_array_size; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, *(other_array_data + i));
+		internal_impl::verify_region(extents, origin, region, dimensions);
+		internal_impl::fill_box<dimensions>(this_level_array_head, extents, origin, region, value);
+	}
 
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		internal_pointer_type starting_address = entire_array_data;
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::count_nodes(std::uint64_t *totals) const noexcept
+	{
+		totals[0] += current_dimension_array_size;
 		for (size_type i = 0; i < current_dimension_array_size; ++i)
-		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->copy_array(starting_address, *(other.current_dimension_array_data + i));
-			starting_address += other[i].get_block_size();
-		}
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+			(current_dimension_array_data + i)->count_nodes(totals + 1);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(const dynarray &other, const allocator_type &other_allocator, Args&&... args)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::write_offsets(std::uint64_t **cursors) const noexcept
 	{
-		size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-		if (entire_array_size == 0 || other.current_dimension_array_size == 0) return;
-		current_dimension_array_size = other.current_dimension_array_size;
-
-		contiguous_allocator = expand_allocator(std::forward<Args>(args)...);
-
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-		internal_pointer_type other_array_data = other.entire_array_data == nullptr ? other.this_level_array_head : other.entire_array_data;
-		for (size_type i = 0; i < entire_array_size; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, *(other_array_data + i));
-
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		internal_pointer_type starting_address = entire_array_data;
+		*cursors[0] = cursors[0][-1] + current_dimension_array_size;
+		++cursors[0];
 		for (size_type i = 0; i < current_dimension_array_size; ++i)
-		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->copy_array(starting_address, *(other.current_dimension_array_data + i), std::forward<Args>(args)...);
-			starting_address += other[i].get_block_size();
-		}
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+			(current_dimension_array_data + i)->write_offsets(cursors + 1);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other)
+		dynarray<dynarray<T, _Allocator>, _Allocator>::attach_nodes(internal_pointer_type block, const std::uint64_t *const *levels, std::uint64_t node)
 	{
-		current_dimension_array_size = other.current_dimension_array_size;
-		entire_array_data = nullptr;
-
+		std::uint64_t first_child = levels[0][node];
+		current_dimension_array_size = static_cast<size_type>(levels[0][node + 1] - first_child);
 		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		internal_pointer_type next_starting_address = starting_address;
 		for (size_type i = 0; i < current_dimension_array_size; ++i)
 		{
 			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->copy_array(next_starting_address, *(other.current_dimension_array_data + i));
-			next_starting_address += other[i].get_block_size();
+			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
+			(current_dimension_array_data + i)->attach_nodes(block, levels + 1, first_child + i);
 		}
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + other.get_block_size() - 1;
+
+		this_level_array_head = block + internal_impl::binary_leaf_offset(levels, dimensions, node);
+		this_level_array_tail = block + internal_impl::binary_leaf_offset(levels, dimensions, node + 1) - 1;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(internal_pointer_type starting_address, const dynarray & other,
-			const allocator_type &other_allocator, Args&& ... args)
+	inline internal_impl::binary_prefix
+		dynarray<dynarray<T, _Allocator>, _Allocator>::make_binary_prefix() const
 	{
-		array_allocator = other_allocator;
-		current_dimension_array_size = other.current_dimension_array_size;
-		entire_array_data = nullptr;
-
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		internal_pointer_type next_starting_address = starting_address;
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		std::uint64_t counts[dimensions] = {};
+		size_type extents[dimensions] = {};
+		if (get_extents(extents))
 		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->contiguous_allocator = contiguous_allocator;
-			(current_dimension_array_data + i)->copy_array(next_starting_address, *(other.current_dimension_array_data + i), std::forward<Args>(args)...);
-			next_starting_address += other[i].get_block_size();
+			std::copy(extents, extents + dimensions, counts);
+			return internal_impl::make_binary_prefix<internal_value_type>(dimensions, counts, nullptr, 0, get_element_count());
 		}
-		this_level_array_head = starting_address;
-		this_level_array_tail = this_level_array_head + other.get_block_size() - 1;
+
+		count_nodes(counts);
+		std::uint64_t table_entries = internal_impl::binary_table_entries(counts, dimensions);
+		std::unique_ptr<std::uint64_t[]> tables = std::make_unique<std::uint64_t[]>(static_cast<std::size_t>(table_entries));
+		std::uint64_t *cursors[dimensions] = {};
+		internal_impl::binary_table_cursors(tables.get(), counts, dimensions, cursors);
+		write_offsets(cursors);
+		return internal_impl::make_binary_prefix<internal_value_type>(dimensions, counts, tables.get(), table_entries, get_element_count());
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename InputIterator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_array(InputIterator other_begin, InputIterator other_end)
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::write_binary(std::ostream &output) const
 	{
-		static_assert(std::is_same_v<std::decay_t<decltype(*other_begin)>, T>,
-			"invalid iterator, cannot convert to a valid dynarray");
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
 
-		size_type count = static_cast<size_type>(std::abs(other_end - other_begin));
-		if (count == 0) return;
+		internal_impl::write_binary_data(output, make_binary_prefix(), this_level_array_head, get_element_count());
+	}
 
-		internal_pointer_type start_address = other_begin->this_level_array_head;
-		internal_pointer_type end_address = (other_end - 1)->this_level_array_tail;
-		size_type entire_array_size = static_cast<size_type>(end_address - start_address + 1);
-		entire_array_data = contiguous_allocator.allocate(entire_array_size);
-		current_dimension_array_size = count;
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename TaskRunner>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::write_compressed(const TaskRunner &run_tasks, std::ostream &output) const
+	{
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
 
-		for (size_type i = 0; i < entire_array_size; ++i)
-			std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, *(start_address + i));
+		internal_impl::write_compressed_data(run_tasks, output, make_binary_prefix(), this_level_array_head, get_element_count());
+	}
 
-		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-		InputIterator other = other_begin;
-		internal_pointer_type starting_address = entire_array_data;
-		for (size_type i = 0; i < current_dimension_array_size; ++i, ++other)
-		{
-			std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-			(current_dimension_array_data + i)->copy_array(starting_address, *other);
-			starting_address += other->get_block_size();
-		}
+	template<typename T, template<typename U> typename _Allocator>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::write_delta(std::ostream &output, dirty_regions<internal_value_type> &dirty) const
+	{
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
 
-		this_level_array_head = entire_array_data;
-		this_level_array_tail = this_level_array_head + entire_array_size - 1;
+		internal_impl::write_delta_data(output, make_binary_prefix(), this_level_array_head, get_element_count(), dirty);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::loop_copy(const dynarray &other) noexcept
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::read_delta(std::istream &input)
 	{
-		if (size() == 0 || other.size() == 0) return;
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
 
-		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
-			*(current_dimension_array_data + i) = *(other.current_dimension_array_data + i);
+		internal_impl::read_delta_data(input, make_binary_prefix(), this_level_array_head, get_element_count());
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::loop_copy(std::initializer_list<internal_value_type> input_list) noexcept
+	inline std::string
+		dynarray<dynarray<T, _Allocator>, _Allocator>::make_npy_header() const
 	{
-		size_type count = input_list.size();
-		if (size() == 0 || count == 0) return;
+		std::uint64_t counts[dimensions] = {};
+		size_type extents[dimensions] = {};
+		if (!get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
 
-		auto list_iter = input_list.begin();
-		for (size_type i = 0; i < count && i < current_dimension_array_size; ++i, ++list_iter)
-			*(this_level_array_head + i) = *list_iter;
+		std::copy(extents, extents + dimensions, counts);
+		return internal_impl::npy_header(internal_impl::npy_descr<internal_value_type>(), counts, dimensions);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	template<typename Ty>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::loop_copy(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::write_npy(std::ostream &output) const
 	{
-		size_type count = input_list.size();
-		if (size() == 0 || count == 0) return;
+		internal_impl::write_npy_data(output, make_npy_header(), this_level_array_head, get_element_count());
+	}
 
-		auto list_iter = input_list.begin();
-		for (size_type i = 0; i < count && i < current_dimension_array_size; ++i, ++list_iter)
-			(current_dimension_array_data + i)->loop_copy(*list_iter);
+	template<typename T, template<typename U> typename _Allocator>
+	template<bool Reading, typename Transfer, typename Step>
+	inline bool
+		dynarray<dynarray<T, _Allocator>, _Allocator>::transfer_rows(Transfer &&transfer, size_type rows_per_step, Step &step)
+	{
+		return internal_impl::stream_rows<Reading>(this_level_array_head, current_dimension_array_size, rows_per_step,
+			[this](size_type row) { return (current_dimension_array_data + row)->get_element_count(); }, std::forward<Transfer>(transfer), step);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::move_array(dynarray &other) noexcept
+	template<typename TaskRunner>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::parse_text(const TaskRunner &run_tasks, std::string_view text, char delimiter)
 	{
-		if (other.empty())
+		static_assert(dimensions == 2, "parse_delimited() requires a two-dimensional dynarray");
+		static_assert(std::is_arithmetic_v<internal_value_type> && !std::is_same_v<internal_value_type, bool>, "parse_delimited() requires numeric elements");
+
+		size_type piece_count = TaskRunner::concurrent ? std::max<size_type>(1, text.size() / internal_impl::delimited_piece_size) : 1;
+		std::unique_ptr<internal_impl::delimited_piece[]> pieces = std::make_unique<internal_impl::delimited_piece[]>(piece_count);
+		internal_impl::split_delimited(text, pieces.get(), piece_count);
+		run_tasks(piece_count, [&pieces, delimiter](std::size_t i) { internal_impl::count_piece(pieces[i], delimiter); });
+
+		size_type rows = 0;
+		size_type entire_array_size = 0;
+		for (size_type i = 0; i < piece_count; ++i)
 		{
-			initialise();
-			return;
+			pieces[i].first_row = rows;
+			pieces[i].first_element = entire_array_size;
+			rows += pieces[i].rows;
+			entire_array_size += pieces[i].elements;
 		}
 
-		if (other.entire_array_data == nullptr)
+		// offset tables of the rows, the same ones as read back from the binary format
+		internal_impl::binary_shape shape = {};
+		shape.tables = std::make_unique<std::uint64_t[]>(rows + 3);
+		shape.levels = std::make_unique<const std::uint64_t*[]>(2);
+		shape.tables[1] = rows;
+		shape.levels[0] = shape.tables.get();
+		shape.levels[1] = shape.tables.get() + 2;
+
+		dynarray loaded;
+		loaded.initialise(array_allocator);
+		loaded.contiguous_allocator = contiguous_allocator;
+		if (entire_array_size > 0)
 		{
-			initialise();
-
-			size_type entire_array_size = static_cast<size_type>(other.this_level_array_tail - other.this_level_array_head + 1);
-			if (entire_array_size == 0 || other.current_dimension_array_size == 0) return;
-			current_dimension_array_size = other.current_dimension_array_size;
+			verify_size(entire_array_size);
+			internal_pointer_type block = loaded.contiguous_allocator.allocate(entire_array_size);
+			loaded.entire_array_data = loaded.this_level_array_head = block;
+			loaded.this_level_array_tail = block + entire_array_size - 1;
 
-			entire_array_data = contiguous_allocator.allocate(entire_array_size);
-			internal_pointer_type other_array_data = other.this_level_array_head;
-			for (size_type i = 0; i < entire_array_size; ++i)
-				std::allocator_traits<contiguous_allocator_type>::construct(contiguous_allocator, entire_array_data + i, std::move(*(other_array_data + i)));
+			std::uint64_t *row_sizes = shape.tables.get() + 3;
+			run_tasks(piece_count, [&pieces, delimiter, block, row_sizes](std::size_t i)
+			{
+				internal_impl::delimited_piece &piece = pieces[i];
+				piece.valid = internal_impl::parse_piece(piece, delimiter, block + piece.first_element, row_sizes + piece.first_row);
+			});
 
-			current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
-			internal_pointer_type starting_address = entire_array_data;
-			for (size_type i = 0; i < current_dimension_array_size; ++i)
+			for (size_type i = 0; i < piece_count; ++i)
 			{
-				std::allocator_traits<allocator_type>::construct(array_allocator, current_dimension_array_data + i);
-				(current_dimension_array_data + i)->copy_array(starting_address, *(other.current_dimension_array_data + i));
-				starting_address += other[i].get_block_size();
+				if (!pieces[i].valid)
+				{
+					loaded.entire_array_data = loaded.this_level_array_head = loaded.this_level_array_tail = nullptr;
+					loaded.contiguous_allocator.deallocate(block, entire_array_size);
+					throw std::invalid_argument("delimited text contains a field which is not a number");
+				}
 			}
-			this_level_array_head = entire_array_data;
-			this_level_array_tail = this_level_array_head + entire_array_size - 1;
+
+			std::partial_sum(row_sizes, row_sizes + rows, row_sizes);
+			loaded.attach_nodes(block, shape.levels.get(), 0);
 		}
+
+		if (entire_array_data == nullptr && this_level_array_head != nullptr)
+			move_values(loaded);
 		else
 		{
-			array_allocator = other.array_allocator;
-			contiguous_allocator = other.contiguous_allocator;
-			entire_array_data = other.entire_array_data;
-			current_dimension_array_size = other.current_dimension_array_size;
-			current_dimension_array_data = other.current_dimension_array_data;
-			this_level_array_head = other.this_level_array_head;
-			this_level_array_tail = other.this_level_array_tail;
-			other.reset();
+			deallocate_array();
+			reset();
+			swap_all(loaded);
 		}
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::move_values(dynarray &other) noexcept
+	template<typename Format, typename ReadBlock>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::read_stream(std::istream &input, ReadBlock &&read_block)
 	{
-		if (size() == 0 || other.size() == 0) return;
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
 
-		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
-			*(current_dimension_array_data + i) = std::move(*(other.current_dimension_array_data + i));
+		internal_impl::binary_shape shape = {};
+		if (!Format::template read_shape<internal_value_type>(internal_impl::stream_reader{ input }, dimensions, shape) ||
+			!input.ignore(static_cast<std::streamsize>(shape.header.block_offset - shape.prefix_length)))
+			return;
+
+		dynarray loaded;
+		loaded.initialise(array_allocator);
+		loaded.contiguous_allocator = contiguous_allocator;
+
+		size_type entire_array_size = static_cast<size_type>(shape.header.element_count);
+		if (entire_array_size > 0)
+		{
+			verify_size(entire_array_size);
+			internal_pointer_type block = loaded.contiguous_allocator.allocate(entire_array_size);
+			loaded.entire_array_data = loaded.this_level_array_head = block;
+			loaded.this_level_array_tail = block + entire_array_size - 1;
+			if (!read_block(input, block, entire_array_size))
+				return;
+
+			loaded.attach_nodes(block, shape.levels.get(), 0);
+		}
+		else
+		{
+			// the block of save_compressed still has its compressed_header when it is empty
+			if (!read_block(input, internal_pointer_type(), entire_array_size))
+				return;
+		}
+
+		if (entire_array_data == nullptr && this_level_array_head != nullptr)
+			move_values(loaded);
+		else
+		{
+			deallocate_array();
+			reset();
+			swap_all(loaded);
+		}
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::swap_all(dynarray &other) noexcept
+	template<typename Format>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::attach_buffer(void *buffer, std::size_t length, const contiguous_allocator_type *owner)
 	{
-		std::swap(entire_array_data, other.entire_array_data);
-		std::swap(current_dimension_array_size, other.current_dimension_array_size);
-		std::swap(current_dimension_array_data, other.current_dimension_array_data);
-		std::swap(this_level_array_head, other.this_level_array_head);
-		std::swap(this_level_array_tail, other.this_level_array_tail);
-		std::swap(array_allocator, other.array_allocator);
-		std::swap(contiguous_allocator, other.contiguous_allocator);
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
+
+		internal_impl::binary_shape shape = {};
+		if (!Format::template read_shape<internal_value_type>(internal_impl::buffer_reader{ static_cast<const char *>(buffer), length, 0 }, dimensions, shape))
+			throw std::invalid_argument("binary data is too short");
+
+		internal_pointer_type block = internal_impl::block_in_buffer<internal_value_type>(buffer, length, shape.header.block_offset, shape.header.element_count);
+		attach_block(block, shape, owner);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::swap_outside(dynarray &other) noexcept
+	template<typename Segment>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::attach_segments(const Segment *segments, std::size_t count)
 	{
-		if ((entire_array_data == nullptr && current_dimension_array_size > 0) ||
-			(other.entire_array_data == nullptr && other.current_dimension_array_size > 0))
-			swap(other);
-		else
-			swap_all(other);
+		static_assert(std::is_trivially_copyable_v<internal_value_type>, "binary format requires trivially copyable elements");
+
+		internal_impl::binary_shape shape = {};
+		if (count == 0 || !internal_impl::binary_format::read_shape<internal_value_type>(internal_impl::buffer_reader{ static_cast<const char *>(segments[0].iov_base), segments[0].iov_len, 0 }, dimensions, shape))
+			throw std::invalid_argument("binary data is too short");
+
+		// the block either follows the offset tables in the first segment, or fills the second one
+		internal_pointer_type block = count == 1 || segments[0].iov_len > shape.header.block_offset ?
+			internal_impl::block_in_buffer<internal_value_type>(segments[0].iov_base, segments[0].iov_len, shape.header.block_offset, shape.header.element_count) :
+			internal_impl::block_in_buffer<internal_value_type>(segments[1].iov_base, segments[1].iov_len, 0, shape.header.element_count);
+		attach_block(block, shape, nullptr);
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::reference
-		dynarray<dynarray<T, _Allocator>, _Allocator>::at(size_type pos)
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::attach_block(internal_pointer_type block, const internal_impl::binary_shape &shape, const contiguous_allocator_type *owner)
 	{
-		if (pos >= size())
-			throw std::out_of_range("out of range, incorrect position");
-		return (*this)[pos];
+		deallocate_array();
+		reset();
+		if (shape.header.element_count == 0)
+			return;
+
+		if (owner != nullptr)
+			contiguous_allocator = *owner;
+		attach_nodes(block, shape.levels.get(), 0);
+		if (owner != nullptr)
+			entire_array_data = block;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::const_reference
-		dynarray<dynarray<T, _Allocator>, _Allocator>::at(size_type pos) const
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::attach_extents(internal_pointer_type block, const size_type *extents, const contiguous_allocator_type *owner)
 	{
-		if (pos >= size())
-			throw std::out_of_range("out of range, incorrect position");
-		return (*this)[pos];
+		std::uint64_t counts[dimensions] = {};
+		std::copy(extents, extents + dimensions, counts);
+		internal_impl::binary_shape shape = {};
+		internal_impl::rectangular_levels(counts, dimensions, shape);
+		attach_block(block, shape, owner);
+		if (shape.header.element_count == 0 && owner != nullptr && block != nullptr)
+		{
+			contiguous_allocator = *owner;
+			contiguous_allocator.deallocate(block, 0);
+		}
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::reference
-		dynarray<dynarray<T, _Allocator>, _Allocator>::operator[](size_type pos)
+	template<typename Generator, typename TaskRunner>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::generate_array(const size_type *extents, Generator &generator, const TaskRunner &run_tasks)
 	{
-		return *(current_dimension_array_data + pos);
+		construct_block(extents, [&](internal_pointer_type block, size_type count)
+		{
+			internal_impl::generate_block<dimensions>(contiguous_allocator, block, extents, count, generator, run_tasks);
+		});
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::const_reference
-		dynarray<dynarray<T, _Allocator>, _Allocator>::operator[](size_type pos) const
+	template<typename ForwardIterator>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::copy_flat(ForwardIterator flat_begin, ForwardIterator flat_end, const size_type *extents)
 	{
-		return *(current_dimension_array_data + pos);
+		construct_block(extents, [&](internal_pointer_type block, size_type count)
+		{
+			if (static_cast<size_type>(std::distance(flat_begin, flat_end)) != count)
+				throw std::invalid_argument("the number of elements does not match the extents");
+			internal_impl::copy_construct_range(contiguous_allocator, block, flat_begin, count);
+		});
 	}
 
+
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::reference
-		dynarray<dynarray<T, _Allocator>, _Allocator>::back()
+	inline typename dynarray<dynarray<T, _Allocator>, _Allocator>::internal_pointer_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::release() noexcept
 	{
-		return (*this)[current_dimension_array_size - 1];
+		internal_pointer_type block = entire_array_data;
+		if (block == nullptr)
+			return nullptr;
+
+		entire_array_data = nullptr;
+		deallocate_array();
+		reset();
+		return block;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<dynarray<T, _Allocator>, _Allocator>::const_reference
-		dynarray<dynarray<T, _Allocator>, _Allocator>::back() const
+	inline typename dynarray<dynarray<T, _Allocator>, _Allocator>::internal_pointer_type
+		dynarray<dynarray<T, _Allocator>, _Allocator>::reshape_block(const size_type *extents, std::size_t rank) const
 	{
-		return (*this)[current_dimension_array_size - 1];
+		size_type count = 1;
+		for (std::size_t k = 0; k < rank; ++k)
+		{
+			if (extents[k] != 0 && count > std::numeric_limits<size_type>::max() / extents[k])
+				throw std::length_error("array too long");
+			count *= extents[k];
+		}
+		if (count != get_element_count())
+			throw std::invalid_argument("the extents do not match the number of elements");
+		return this_level_array_head;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::swap(dynarray &other) noexcept
+	template<typename Construct>
+	inline void
+		dynarray<dynarray<T, _Allocator>, _Allocator>::construct_block(const size_type *extents, Construct construct_elements)
 	{
-		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
-			(current_dimension_array_data + i)->swap(other[i]);
+		std::uint64_t counts[dimensions] = {};
+		std::copy(extents, extents + dimensions, counts);
+		internal_impl::binary_shape shape = {};
+		internal_impl::rectangular_levels(counts, dimensions, shape);
+		if (shape.header.element_count > std::allocator_traits<contiguous_allocator_type>::max_size(contiguous_allocator))
+			throw std::length_error("array too long");
+
+		size_type count = static_cast<size_type>(shape.header.element_count);
+		if (count == 0)
+		{
+			construct_elements(internal_pointer_type(), count);
+			return;
+		}
+
+		internal_pointer_type block = contiguous_allocator.allocate(count);
+		try
+		{
+			construct_elements(block, count);
+		}
+		catch (...)
+		{
+			// construct_elements destroys the elements it has built before it throws
+			contiguous_allocator.deallocate(block, count);
+			throw;
+		}
+
+		try
+		{
+			attach_block(block, shape, &contiguous_allocator);
+		}
+		catch (...)
+		{
+			for (size_type i = count; i > 0; --i)
+				std::allocator_traits<contiguous_allocator_type>::destroy(contiguous_allocator, block + i - 1);
+			contiguous_allocator.deallocate(block, count);
+			throw;
+		}
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
-	inline CPP20_DYNARRAY_CONSTEXPR void
-		dynarray<dynarray<T, _Allocator>, _Allocator>::fill(const internal_value_type &value)
+	template<typename Result>
+	inline Result
+		dynarray<dynarray<T, _Allocator>, _Allocator>::join_arrays(const dynarray *const *arrays, size_type count, size_type axis, bool stacking)
 	{
-		for (auto current_address = this_level_array_head;
-			current_address != this_level_array_tail + 1;
-			++current_address)
-			*current_address = value;
+		if (count == 0)
+			throw std::invalid_argument("no array to join");
+		if (axis > dimensions || (axis == dimensions && !stacking))
+			throw std::out_of_range("out of range, incorrect axis");
+
+		std::unique_ptr<size_type[]> extents = std::make_unique<size_type[]>(count * (dimensions + 1));
+		std::unique_ptr<const internal_value_type *[]> sources = std::make_unique<const internal_value_type *[]>(count);
+		size_type *slabs = extents.get() + count * dimensions;
+		for (size_type i = 0; i < count; ++i)
+		{
+			if (!arrays[i]->get_extents(extents.get() + i * dimensions))
+				throw std::invalid_argument("dynarray is not rectangular");
+			sources[i] = arrays[i]->this_level_array_head;
+		}
+
+		size_type result_extents[dimensions + 1] = {};
+		size_type outer = internal_impl::join_shape(extents.get(), count, dimensions, axis, stacking, result_extents, slabs);
+
+		Result joined;
+		joined.contiguous_allocator = arrays[0]->contiguous_allocator;
+		joined.construct_block(result_extents, [&](auto block, size_type)
+		{
+			internal_impl::interleave_blocks(joined.contiguous_allocator, block, sources.get(), slabs, slabs, count, outer);
+		});
+		return joined;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::vector<dynarray<dynarray<T, _Allocator>, _Allocator>>
+		dynarray<dynarray<T, _Allocator>, _Allocator>::split_array(size_type axis, size_type parts)
+	{
+		if (axis >= dimensions)
+			throw std::out_of_range("out of range, incorrect axis");
+
+		size_type extents[dimensions] = {};
+		if (!get_extents(extents))
+			throw std::invalid_argument("dynarray is not rectangular");
+		if (parts == 0 || extents[axis] % parts != 0)
+			throw std::invalid_argument("the array cannot be split into equal parts");
+
+		size_type outer = 1;
+		for (size_type k = 0; k < axis; ++k)
+			outer *= extents[k];
+		extents[axis] /= parts;
+		size_type slab = 1;
+		for (size_type k = axis; k < dimensions; ++k)
+			slab *= extents[k];
+		size_type stride = slab * parts;
+
+		std::vector<dynarray> pieces(parts);
+		for (size_type p = 0; p < parts; ++p)
+		{
+			if (outer == 1)
+			{
+				pieces[p].attach_extents(this_level_array_head + p * slab, extents, nullptr);
+				continue;
+			}
+
+			const internal_value_type *source = this_level_array_head + p * slab;
+			dynarray &piece = pieces[p];
+			piece.contiguous_allocator = contiguous_allocator;
+			piece.construct_block(extents, [&](internal_pointer_type block, size_type)
+			{
+				internal_impl::interleave_blocks(piece.contiguous_allocator, block, &source, &slab, &stride, 1, outer);
+			});
+		}
+		return pieces;
 	}
 
+	/*!
+	 * @brief Writes dynarrays into a NumPy .npz archive, which numpy.load reads as a dictionary of arrays.
+	 *
+	 * Members are stored without compression and streamed in the format of save_npy, no temporary copy of an array is made.
+	 * ZIP64 is not used, so the archive is limited to 4 GiB. finish() must be called after the last add().
+	 */
+	class npz_writer
+	{
+	public:
+		explicit npz_writer(std::ostream &output) : output(output) {}
+
+		/*!
+		 * @brief Appends array to the archive as name.npy.
+		 *
+		 * @param name Key of the array in numpy.load
+		 * @param array A rectangular dynarray of an arithmetic type
+		 * @return *this
+		 * @exception std::invalid_argument if array is jagged, std::length_error if the archive would exceed 4 GiB
+		*/
+		template<typename Array>
+		npz_writer& add(const std::string &name, const Array &array)
+		{
+			std::string file_name = name + ".npy";
+			if (file_name.size() > 0xffff || entry_count == 0xffff || position >= internal_impl::zip_limit)
+				throw std::length_error("npz archive too long");
+
+			// throws for a jagged array before anything is written, the element type is checked when it is instantiated
+			std::string npy_header = array.make_npy_header();
+
+			// general purpose flag 0x08: CRC-32 and sizes follow the data, in a data descriptor
+			std::string local_header;
+			internal_impl::append_little_endian(local_header, 0x04034b50, 4);
+			internal_impl::append_little_endian(local_header, 20, 2);
+			internal_impl::append_little_endian(local_header, 0x08, 2);
+			internal_impl::append_little_endian(local_header, 0, 2);
+			internal_impl::append_little_endian(local_header, 0, 2);
+			internal_impl::append_little_endian(local_header, 0x21, 2);
+			local_header.append(12, '\0');
+			internal_impl::append_little_endian(local_header, file_name.size(), 2);
+			internal_impl::append_little_endian(local_header, 0, 2);
+			local_header += file_name;
+			if (!output.write(local_header.data(), static_cast<std::streamsize>(local_header.size())))
+				return *this;
+
+			internal_impl::crc32_streambuf counter(output.rdbuf());
+			std::ostream member(&counter);
+			internal_impl::write_npy_data(member, npy_header, array.data(), array.get_element_count());
+			if (!member.flush())
+			{
+				output.setstate(std::ios_base::badbit);
+				return *this;
+			}
+			if (counter.length() >= internal_impl::zip_limit || position + local_header.size() + counter.length() + 16 >= internal_impl::zip_limit)
+				throw std::length_error("npz archive too long");
+
+			std::string descriptor;
+			internal_impl::append_little_endian(descriptor, 0x08074b50, 4);
+			internal_impl::append_little_endian(descriptor, counter.checksum(), 4);
+			internal_impl::append_little_endian(descriptor, counter.length(), 4);
+			internal_impl::append_little_endian(descriptor, counter.length(), 4);
+			if (!output.write(descriptor.data(), static_cast<std::streamsize>(descriptor.size())))
+				return *this;
+
+			internal_impl::append_little_endian(central_directory, 0x02014b50, 4);
+			internal_impl::append_little_endian(central_directory, 20, 2);
+			central_directory.append(local_header, 4, 10);
+			central_directory.append(descriptor, 4, 12);
+			internal_impl::append_little_endian(central_directory, file_name.size(), 2);
+			central_directory.append(12, '\0');
+			internal_impl::append_little_endian(central_directory, position, 4);
+			central_directory += file_name;
+
+			position += local_header.size() + counter.length() + descriptor.size();
+			++entry_count;
+			return *this;
+		}
+
+		/*!
+		 * @brief Writes the central directory, no array can be added afterwards.
+		*/
+		void finish()
+		{
+			if (position + central_directory.size() >= internal_impl::zip_limit)
+				throw std::length_error("npz archive too long");
+
+			std::string end_record;
+			internal_impl::append_little_endian(end_record, 0x06054b50, 4);
+			internal_impl::append_little_endian(end_record, 0, 4);
+			internal_impl::append_little_endian(end_record, entry_count, 2);
+			internal_impl::append_little_endian(end_record, entry_count, 2);
+			internal_impl::append_little_endian(end_record, central_directory.size(), 4);
+			internal_impl::append_little_endian(end_record, position, 4);
+			internal_impl::append_little_endian(end_record, 0, 2);
+			central_directory += end_record;
+			output.write(central_directory.data(), static_cast<std::streamsize>(central_directory.size()));
+			position = internal_impl::zip_limit;
+		}
+
+	private:
+		std::ostream &output;
+		std::string central_directory;
+		std::uint64_t position = 0;
+		std::uint16_t entry_count = 0;
+	};
+
+	/*!
+	 * @brief Reads dynarrays from a NumPy .npz archive written by numpy.savez or npz_writer.
+	 *
+	 * Only members stored without compression can be read (not numpy.savez_compressed), and ZIP64 archives are not supported.
+	 * The central directory is read once, each load() then seeks to its member.
+	 */
+	class npz_reader
+	{
+	public:
+		/*!
+		 * @brief Reads the central directory of the archive.
+		 *
+		 * @param input A seekable input stream, opened in binary mode
+		 * @exception std::invalid_argument if input is not a ZIP archive, std::length_error if it needs ZIP64
+		*/
+		explicit npz_reader(std::istream &input) : input(input)
+		{
+			constexpr std::streamoff end_record_length = 22;
+			input.seekg(0, std::ios_base::end);
+			std::streamoff archive_length = input.tellg();
+			if (archive_length < end_record_length)
+				throw std::invalid_argument("invalid npz archive");
+
+			// the end record is followed by a comment of up to 65535 bytes
+			std::streamoff tail_length = std::min<std::streamoff>(archive_length, end_record_length + 0xffff);
+			std::string tail(static_cast<std::size_t>(tail_length), '\0');
+			input.seekg(archive_length - tail_length);
+			if (!input.read(&tail[0], tail_length))
+				throw std::invalid_argument("invalid npz archive");
+
+			std::size_t end_record = tail.rfind("PK\x05\x06", static_cast<std::size_t>(tail_length - end_record_length));
+			if (end_record == std::string::npos)
+				throw std::invalid_argument("invalid npz archive");
+
+			std::uint64_t directory_length = internal_impl::read_little_endian(tail.data() + end_record + 12, 4);
+			std::uint64_t directory_offset = internal_impl::read_little_endian(tail.data() + end_record + 16, 4);
+			if (internal_impl::read_little_endian(tail.data() + end_record + 10, 2) == 0xffff || directory_offset == internal_impl::zip_limit)
+				throw std::length_error("npz archive too long");
+			if (directory_offset + directory_length > static_cast<std::uint64_t>(archive_length))
+				throw std::invalid_argument("invalid npz archive");
+
+			central_directory.resize(static_cast<std::size_t>(directory_length));
+			input.seekg(static_cast<std::streamoff>(directory_offset));
+			if (directory_length > 0 && !input.read(&central_directory[0], static_cast<std::streamsize>(directory_length)))
+				throw std::invalid_argument("invalid npz archive");
+		}
+
+		/*!
+		 * @brief Checks if the archive has an array called name.
+		*/
+		bool contains(const std::string &name) const { return find_entry(name) != std::string::npos; }
+
+		/*!
+		 * @brief Reads the array called name with load_npy, its contiguous block is read with a single read.
+		 *
+		 * @param name Key of the array, as in numpy.load
+		 * @param output The array to be replaced
+		 * @exception std::invalid_argument if the archive has no such array, the member is compressed, or it does not match output
+		*/
+		template<typename Array>
+		void load(const std::string &name, Array &output)
+		{
+			std::size_t entry = find_entry(name);
+			if (entry == std::string::npos)
+				throw std::invalid_argument("no such array in npz archive");
+			if (internal_impl::read_little_endian(central_directory.data() + entry + 10, 2) != 0)
+				throw std::invalid_argument("compressed npz archives are not supported");
+
+			std::uint64_t local_offset = internal_impl::read_little_endian(central_directory.data() + entry + 42, 4);
+			if (local_offset == internal_impl::zip_limit)
+				throw std::length_error("npz archive too long");
+
+			char local_header[30] = {};
+			input.clear();
+			input.seekg(static_cast<std::streamoff>(local_offset));
+			if (!input.read(local_header, sizeof local_header) || internal_impl::read_little_endian(local_header, 4) != 0x04034b50)
+				throw std::invalid_argument("invalid npz archive");
+
+			std::uint64_t skipped = internal_impl::read_little_endian(local_header + 26, 2) + internal_impl::read_little_endian(local_header + 28, 2);
+			if (input.ignore(static_cast<std::streamsize>(skipped)))
+				load_npy(input, output);
+		}
+
+	private:
+		std::size_t find_entry(const std::string &name) const
+		{
+			for (std::size_t entry = 0; entry + 46 <= central_directory.size();)
+			{
+				const char *record = central_directory.data() + entry;
+				if (internal_impl::read_little_endian(record, 4) != 0x02014b50)
+					break;
+
+				std::size_t name_length = static_cast<std::size_t>(internal_impl::read_little_endian(record + 28, 2));
+				std::size_t record_length = 46 + name_length + static_cast<std::size_t>(internal_impl::read_little_endian(record + 30, 2) +
+				                                                                        internal_impl::read_little_endian(record + 32, 2));
+				if (entry + record_length > central_directory.size())
+					break;
+
+				std::string file_name(record + 46, name_length);
+				if (file_name == name + ".npy" || file_name == name)
+					return entry;
+				entry += record_length;
+			}
+			return std::string::npos;
+		}
+
+		std::istream &input;
+		std::string central_directory;
+	};
+
 }	// namespace vla
 
+namespace std
+{
+	template<typename T, template<typename U> typename _Allocator>
+	struct hash<vla::dynarray<T, _Allocator>>
+	{
+		std::size_t operator()(const vla::dynarray<T, _Allocator> &arr) const { return arr.hash_code(); }
+	};
+}	// namespace std
+
 
 #endif //_VLA_HEADER_DYNARRAY_HPP_
\ No newline at end of file
@@ -56,7 +56,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DYNARRAY_LITE_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
@@ -101,6 +104,81 @@ namespace vla
 		template<typename Skip, typename ... Args> CPP20_DYNARRAY_CONSTEXPR
 		std::size_t expand_parameters(std::size_t count, const Skip &skip, Args&& ... args) { return count * expand_parameters(std::forward<Args>(args)...); }
 
+		inline constexpr std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept
+		{
+			return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+		}
+
+		/*!
+		 * @brief 64-bit hash of a byte block.
+		 *
+		 * Four independent multiply-rotate lanes consume 32 bytes per iteration, so the main loop is not serialised on a single accumulator.
+		 *
+		 * @param data First byte of the block
+		 * @param length Length of the block in bytes
+		 * @param seed Initial value
+		 * @return Hash value
+		 */
+		inline std::uint64_t hash_bytes(const void *data, std::size_t length, std::uint64_t seed) noexcept
+		{
+			constexpr std::uint64_t prime_1 = 0x9e3779b185ebca87ull;
+			constexpr std::uint64_t prime_2 = 0xc2b2ae3d27d4eb4full;
+			constexpr std::uint64_t prime_3 = 0x165667b19e3779f9ull;
+			constexpr std::uint64_t prime_4 = 0x85ebca77c2b2ae63ull;
+			constexpr std::uint64_t prime_5 = 0x27d4eb2f165667c5ull;
+
+			auto rotate_left = [](std::uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+			auto mix = [&](std::uint64_t accumulator, std::uint64_t input) { return rotate_left(accumulator + input * prime_2, 31) * prime_1; };
+			auto read_64 = [](const unsigned char *ptr) { std::uint64_t value; std::memcpy(&value, ptr, sizeof value); return value; };
+
+			const unsigned char *current = static_cast<const unsigned char *>(data);
+			const unsigned char *end = current + length;
+			std::uint64_t hash_value;
+
+			if (length >= 32)
+			{
+				std::uint64_t lane_1 = seed + prime_1 + prime_2;
+				std::uint64_t lane_2 = seed + prime_2;
+				std::uint64_t lane_3 = seed;
+				std::uint64_t lane_4 = seed - prime_1;
+				for (; end - current >= 32; current += 32)
+				{
+					lane_1 = mix(lane_1, read_64(current));
+					lane_2 = mix(lane_2, read_64(current + 8));
+					lane_3 = mix(lane_3, read_64(current + 16));
+					lane_4 = mix(lane_4, read_64(current + 24));
+				}
+				hash_value = rotate_left(lane_1, 1) + rotate_left(lane_2, 7) + rotate_left(lane_3, 12) + rotate_left(lane_4, 18);
+				for (std::uint64_t lane : { lane_1, lane_2, lane_3, lane_4 })
+					hash_value = (hash_value ^ mix(0, lane)) * prime_1 + prime_4;
+			}
+			else
+				hash_value = seed + prime_5;
+
+			hash_value += length;
+			for (; end - current >= 8; current += 8)
+				hash_value = rotate_left(hash_value ^ mix(0, read_64(current)), 27) * prime_1 + prime_4;
+			for (; current != end; ++current)
+				hash_value = rotate_left(hash_value ^ (*current * prime_5), 11) * prime_1;
+
+			hash_value ^= hash_value >> 33;
+			hash_value *= prime_2;
+			hash_value ^= hash_value >> 29;
+			hash_value *= prime_3;
+			hash_value ^= hash_value >> 32;
+			return hash_value;
+		}
+
+		/*!
+		 * @brief Who releases the storage a dynarray points to.
+		 */
+		enum class storage_kind : unsigned char
+		{
+			owned,		// allocated for this node alone
+			borrowed,	// part of a block owned by the outermost array of contiguous mode
+			contiguous	// outermost array of contiguous mode, owns one block for each dimension
+		};
+
 	}	// internal namespace
 
 	template<typename T>
@@ -171,6 +249,12 @@ namespace vla
 	};
 
 
+	/*!
+	 * @brief Tag of the constructor which puts every dimension of a nested array in one block, see dynarray(contiguous_t, ...)
+	 */
+	struct contiguous_t { explicit contiguous_t() = default; };
+	inline constexpr contiguous_t contiguous{};
+
 	template<typename T, template<typename U> typename _Allocator = std::allocator>
 	class dynarray
 	{
@@ -269,6 +353,27 @@ namespace vla
 			allocate_array(count, other_allocator, std::forward<Args>(args)...);
 		}
 
+		/*!
+		 * @brief Construct by 'count' of each dimension in contiguous mode.\n
+		 * The nodes of each dimension share one block and the elements share another one, so data() covers the whole array
+		 * and the array takes one allocation per dimension instead of one per row. Nodes stay 24 bytes.\n
+		 * Example: dynarray<dynarray<int>> my_array(vla::contiguous, 1000, 1000);
+		 *
+		 * Copying keeps the mode, moving the outermost array takes over its blocks.
+		 * Rows keep their place in the blocks: assigning to a row replaces its values only.
+		 *
+		 * @param count The first dimention
+		 * @param ...counts The other dimensions, one for each level of nested array
+		 */
+		template<typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(contiguous_t, size_type count, Args ... counts) : array_allocator(allocator_type())
+		{
+			static_assert(sizeof...(counts) == internal_impl::inner_type<T, _Allocator>::nested_level, "one count is needed for each dimension");
+			initialise();
+			const size_type extents[] = { count, static_cast<size_type>(counts)... };
+			allocate_contiguous(extents);
+		}
+
 		/*!
 		 * @brief Duplicate an existing dynarray.
 		 * 
@@ -287,6 +392,7 @@ namespace vla
 		 */
 		CPP20_DYNARRAY_CONSTEXPR dynarray(dynarray &&other) noexcept : array_allocator(allocator_type())
 		{
+			initialise();
 			move_array(other);
 		}
 
@@ -358,7 +464,8 @@ namespace vla
 		 */
 		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(dynarray &&other) noexcept
 		{
-			if (current_dimension_array_size > 0 && current_dimension_array_size != other.current_dimension_array_size)
+			if ((current_dimension_array_size > 0 && current_dimension_array_size != other.current_dimension_array_size) ||
+			    array_storage == internal_impl::storage_kind::borrowed)
 				move_values(other);
 			else
 			{
@@ -687,6 +794,9 @@ namespace vla
 
 		allocator_type array_allocator;
 
+		// fits in the padding after an empty allocator
+		internal_impl::storage_kind array_storage;
+
 
 		CPP20_DYNARRAY_CONSTEXPR void initialise();
 
@@ -709,6 +819,14 @@ namespace vla
 		template<typename ... Args>
 		CPP20_DYNARRAY_CONSTEXPR void allocate_array(std::initializer_list<T> input_list, Args&& ...args);
 
+		CPP20_DYNARRAY_CONSTEXPR void allocate_contiguous(const size_type *extents);
+
+		static CPP20_DYNARRAY_CONSTEXPR pointer allocate_block(allocator_type &block_allocator, size_type total, const size_type *extents);
+
+		static CPP20_DYNARRAY_CONSTEXPR void deallocate_block(allocator_type &block_allocator, pointer block, size_type total);
+
+		CPP20_DYNARRAY_CONSTEXPR void copy_extents(size_type *extents) const noexcept;
+
 		CPP20_DYNARRAY_CONSTEXPR void deallocate_array();
 
 		CPP20_DYNARRAY_CONSTEXPR void copy_array(const dynarray &other);
@@ -730,6 +848,10 @@ namespace vla
 
 		CPP20_DYNARRAY_CONSTEXPR void move_values(dynarray &other) noexcept;
 
+		std::size_t hash_code() const;
+
+		friend struct std::hash<dynarray>;
+
 		/**** Non-member functions  ***/
 
 		friend CPP20_DYNARRAY_CONSTEXPR bool operator==(const dynarray &lhs, const dynarray &rhs)
@@ -805,6 +927,7 @@ namespace vla
 	{
 		current_dimension_array_size = 0;
 		current_dimension_array_data = nullptr;
+		array_storage = internal_impl::storage_kind::owned;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
@@ -905,17 +1028,124 @@ namespace vla
 	}
 
 
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+	dynarray<T, _Allocator>::allocate_contiguous(const size_type *extents)
+	{
+		const size_type nested_level = internal_impl::inner_type<T, _Allocator>::nested_level;
+		size_type entire_array_size = 1;
+		for (size_type k = 0; k <= nested_level; ++k)
+		{
+			verify_size(extents[k]);
+			if (extents[k] != 0 && entire_array_size > static_cast<size_type>(std::numeric_limits<difference_type>::max()) / extents[k])
+				throw std::length_error("array too long");
+			entire_array_size *= extents[k];
+		}
+
+		if (entire_array_size == 0)
+		{
+			initialise();
+			return;
+		}
+
+		current_dimension_array_size = extents[0];
+		current_dimension_array_data = allocate_block(array_allocator, extents[0], extents + 1);
+		array_storage = internal_impl::storage_kind::contiguous;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::pointer
+	dynarray<T, _Allocator>::allocate_block(allocator_type &block_allocator, size_type total, const size_type *extents)
+	{
+		pointer block = block_allocator.allocate(total);
+		size_type constructed = 0;
+		if constexpr (std::is_same_v<T, internal_value_type>)
+		{
+			try
+			{
+				for (; constructed < total; ++constructed)
+					std::allocator_traits<allocator_type>::construct(block_allocator, block + constructed);
+			}
+			catch (...)
+			{
+				for (; constructed > 0; --constructed)
+					std::allocator_traits<allocator_type>::destroy(block_allocator, block + constructed - 1);
+				block_allocator.deallocate(block, total);
+				throw;
+			}
+		}
+		else
+		{
+			typename T::allocator_type inner_allocator = typename T::allocator_type();
+			typename T::pointer inner_block = nullptr;
+			try
+			{
+				inner_block = T::allocate_block(inner_allocator, total * extents[0], extents + 1);
+				for (; constructed < total; ++constructed)
+				{
+					std::allocator_traits<allocator_type>::construct(block_allocator, block + constructed);
+					block[constructed].current_dimension_array_size = extents[0];
+					block[constructed].current_dimension_array_data = inner_block + constructed * extents[0];
+					block[constructed].array_storage = internal_impl::storage_kind::borrowed;
+				}
+			}
+			catch (...)
+			{
+				// the nodes only borrow the inner block, it is released separately
+				for (; constructed > 0; --constructed)
+					std::allocator_traits<allocator_type>::destroy(block_allocator, block + constructed - 1);
+				if (inner_block != nullptr)
+					T::deallocate_block(inner_allocator, inner_block, total * extents[0]);
+				block_allocator.deallocate(block, total);
+				throw;
+			}
+		}
+		return block;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+	dynarray<T, _Allocator>::deallocate_block(allocator_type &block_allocator, pointer block, size_type total)
+	{
+		if constexpr (!std::is_same_v<T, internal_value_type>)
+		{
+			// the first node points to the beginning of the block of the next dimension
+			size_type inner_total = 0;
+			for (size_type i = 0; i < total; ++i)
+				inner_total += block[i].current_dimension_array_size;
+			T::deallocate_block(block[0].array_allocator, block[0].current_dimension_array_data, inner_total);
+		}
+
+		for (size_type i = total; i != 0; --i)
+			std::allocator_traits<allocator_type>::destroy(block_allocator, block + i - 1);
+		block_allocator.deallocate(block, total);
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+	dynarray<T, _Allocator>::copy_extents(size_type *extents) const noexcept
+	{
+		extents[0] = current_dimension_array_size;
+		if constexpr (!std::is_same_v<T, internal_value_type>)
+			current_dimension_array_data->copy_extents(extents + 1);
+	}
+
 	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
 	dynarray<T, _Allocator>::deallocate_array()
 	{
-		if (current_dimension_array_data)
+		if (current_dimension_array_data == nullptr || array_storage == internal_impl::storage_kind::borrowed)
+			return;
+
+		if (array_storage == internal_impl::storage_kind::contiguous)
+			deallocate_block(array_allocator, current_dimension_array_data, current_dimension_array_size);
+		else
 		{
 			for (size_type i = current_dimension_array_size; i != 0; --i)
 				std::allocator_traits<allocator_type>::destroy(array_allocator, current_dimension_array_data + i - 1);
 			array_allocator.deallocate(current_dimension_array_data, current_dimension_array_size);
-			current_dimension_array_data = nullptr;
 		}
+		current_dimension_array_data = nullptr;
 	}
 
 	template<typename T, template<typename U> typename _Allocator>
@@ -923,6 +1153,15 @@ namespace vla
 	dynarray<T, _Allocator>::copy_array(const dynarray &other)
 	{
 		if (other.current_dimension_array_size == 0) return;
+		if (other.array_storage == internal_impl::storage_kind::contiguous)
+		{
+			size_type extents[internal_impl::inner_type<T, _Allocator>::nested_level + 1] = {};
+			other.copy_extents(extents);
+			allocate_contiguous(extents);
+			size_type entire_array_size = std::accumulate(std::begin(extents), std::end(extents), size_type(1), std::multiplies<size_type>());
+			std::copy(other.data(), other.data() + entire_array_size, data());
+			return;
+		}
 		current_dimension_array_size = other.current_dimension_array_size;
 
 		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
@@ -1003,6 +1242,15 @@ namespace vla
 	dynarray<T, _Allocator>::move_array(dynarray &other) noexcept
 	{
 		if (other.current_dimension_array_size == 0) return;
+		if (other.array_storage == internal_impl::storage_kind::contiguous)
+		{
+			array_allocator = other.array_allocator;
+			current_dimension_array_size = other.current_dimension_array_size;
+			current_dimension_array_data = other.current_dimension_array_data;
+			array_storage = other.array_storage;
+			other.initialise();
+			return;
+		}
 		current_dimension_array_size = other.current_dimension_array_size;
 		array_allocator = other.array_allocator;
 		current_dimension_array_data = array_allocator.allocate(current_dimension_array_size);
@@ -1098,7 +1346,41 @@ namespace vla
 				(current_dimension_array_data + i)->fill(value);
 	}
 
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::size_t
+	dynarray<T, _Allocator>::hash_code() const
+	{
+		std::size_t seed = internal_impl::hash_combine(0, current_dimension_array_size);
+		if constexpr (std::is_same_v<T, internal_value_type>)
+		{
+			if constexpr (std::has_unique_object_representations_v<T>)
+				return internal_impl::hash_combine(seed, static_cast<std::size_t>(internal_impl::hash_bytes(current_dimension_array_data, current_dimension_array_size * sizeof(T), seed)));
+			else
+			{
+				std::hash<T> element_hash;
+				for (size_type i = 0; i < current_dimension_array_size; ++i)
+					seed = internal_impl::hash_combine(seed, element_hash(current_dimension_array_data[i]));
+				return seed;
+			}
+		}
+		else
+		{
+			for (size_type i = 0; i < current_dimension_array_size; ++i)
+				seed = internal_impl::hash_combine(seed, current_dimension_array_data[i].hash_code());
+			return seed;
+		}
+	}
+
 }	// namespace vla
 
+namespace std
+{
+	template<typename T, template<typename U> typename _Allocator>
+	struct hash<vla::dynarray<T, _Allocator>>
+	{
+		std::size_t operator()(const vla::dynarray<T, _Allocator> &arr) const { return arr.hash_code(); }
+	};
+}	// namespace std
+
 
 #endif //_VLA_HEADER_DYNARRAY_LITE_HPP_
\ No newline at end of file
@@ -56,11 +56,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DYNARRAY_MINI_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <new>
 #include <numeric>
 #include <stdexcept>
 #include <type_traits>
@@ -76,7 +80,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace vla
 {
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator = std::allocator>
 	class dynarray;
 
 	namespace internal_impl
@@ -88,8 +92,8 @@ namespace vla
 			enum { nested_level = 0 };
 		};
 
-		template <typename T>
-		struct inner_type<dynarray<T>>
+		template <typename T, template<typename U> typename _Allocator>
+		struct inner_type<dynarray<T, _Allocator>>
 		{
 			using value_type = typename inner_type<T>::value_type;
 			enum { nested_level = inner_type<T>::nested_level + 1 };
@@ -101,8 +105,237 @@ namespace vla
 		template<typename Skip, typename ... Args> CPP20_DYNARRAY_CONSTEXPR
 		std::size_t expand_parameters(std::size_t count, const Skip &skip, Args&& ... args) { return count * expand_parameters(std::forward<Args>(args)...); }
 
+		inline constexpr std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept
+		{
+			return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+		}
+
+		/*!
+		 * @brief 64-bit hash of a byte block.
+		 *
+		 * Four independent multiply-rotate lanes consume 32 bytes per iteration, so the main loop is not serialised on a single accumulator.
+		 *
+		 * @param data First byte of the block
+		 * @param length Length of the block in bytes
+		 * @param seed Initial value
+		 * @return Hash value
+		 */
+		inline std::uint64_t hash_bytes(const void *data, std::size_t length, std::uint64_t seed) noexcept
+		{
+			constexpr std::uint64_t prime_1 = 0x9e3779b185ebca87ull;
+			constexpr std::uint64_t prime_2 = 0xc2b2ae3d27d4eb4full;
+			constexpr std::uint64_t prime_3 = 0x165667b19e3779f9ull;
+			constexpr std::uint64_t prime_4 = 0x85ebca77c2b2ae63ull;
+			constexpr std::uint64_t prime_5 = 0x27d4eb2f165667c5ull;
+
+			auto rotate_left = [](std::uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+			auto mix = [&](std::uint64_t accumulator, std::uint64_t input) { return rotate_left(accumulator + input * prime_2, 31) * prime_1; };
+			auto read_64 = [](const unsigned char *ptr) { std::uint64_t value; std::memcpy(&value, ptr, sizeof value); return value; };
+
+			const unsigned char *current = static_cast<const unsigned char *>(data);
+			const unsigned char *end = current + length;
+			std::uint64_t hash_value;
+
+			if (length >= 32)
+			{
+				std::uint64_t lane_1 = seed + prime_1 + prime_2;
+				std::uint64_t lane_2 = seed + prime_2;
+				std::uint64_t lane_3 = seed;
+				std::uint64_t lane_4 = seed - prime_1;
+				for (; end - current >= 32; current += 32)
+				{
+					lane_1 = mix(lane_1, read_64(current));
+					lane_2 = mix(lane_2, read_64(current + 8));
+					lane_3 = mix(lane_3, read_64(current + 16));
+					lane_4 = mix(lane_4, read_64(current + 24));
+				}
+				hash_value = rotate_left(lane_1, 1) + rotate_left(lane_2, 7) + rotate_left(lane_3, 12) + rotate_left(lane_4, 18);
+				for (std::uint64_t lane : { lane_1, lane_2, lane_3, lane_4 })
+					hash_value = (hash_value ^ mix(0, lane)) * prime_1 + prime_4;
+			}
+			else
+				hash_value = seed + prime_5;
+
+			hash_value += length;
+			for (; end - current >= 8; current += 8)
+				hash_value = rotate_left(hash_value ^ mix(0, read_64(current)), 27) * prime_1 + prime_4;
+			for (; current != end; ++current)
+				hash_value = rotate_left(hash_value ^ (*current * prime_5), 11) * prime_1;
+
+			hash_value ^= hash_value >> 33;
+			hash_value *= prime_2;
+			hash_value ^= hash_value >> 29;
+			hash_value *= prime_3;
+			hash_value ^= hash_value >> 32;
+			return hash_value;
+		}
+
+		/*!
+		 * @brief Deleter of the element array, destroys and deallocates the elements with the allocator it derives from.
+		 *
+		 * The element count lives here rather than in dynarray. An empty allocator takes no space as a base,
+		 * so std::unique_ptr<T[], allocator_deleter> stays as large as one pointer and one size.
+		 */
+		template<typename Allocator>
+		struct allocator_deleter : Allocator
+		{
+			using pointer = typename std::allocator_traits<Allocator>::pointer;
+
+			std::size_t count = 0;
+
+			CPP20_DYNARRAY_CONSTEXPR void operator()(pointer ptr) noexcept
+			{
+				for (std::size_t i = count; i > 0; --i)
+					std::allocator_traits<Allocator>::destroy(*this, ptr + i - 1);
+				std::allocator_traits<Allocator>::deallocate(*this, ptr, count);
+			}
+		};
+
 	}	// internal namespace
 
+	/*!
+	 * @brief Tag of the constructors which leave the elements default-initialised instead of value-initialised,
+	 * see dynarray(for_overwrite_t, ...)
+	 */
+	struct for_overwrite_t { explicit for_overwrite_t() = default; };
+	inline constexpr for_overwrite_t for_overwrite{};
+
+	/*!
+	 * @brief Bump-pointer arena for dynarray<T, arena_allocator>.
+	 *
+	 * Arrays are carved out of chunks of chunk_size bytes and deallocating them does nothing,
+	 * all chunks are released together by reset() or the destructor. Arrays must not outlive their arena.
+	 * An arena is used by the allocations of the thread which holds a mini_arena::scope of it.
+	 */
+	class mini_arena
+	{
+	public:
+		class scope;
+
+		explicit mini_arena(std::size_t chunk_size = 65536) noexcept : chunk_size(chunk_size) {}
+
+		mini_arena(const mini_arena &) = delete;
+
+		mini_arena& operator=(const mini_arena &) = delete;
+
+		~mini_arena() { reset(); }
+
+		/*!
+		 * @brief Returns bytes aligned to alignment from the current chunk, or from a new chunk if it does not fit.
+		 *
+		 * @exception std::bad_alloc if a new chunk cannot be allocated
+		 */
+		void* allocate(std::size_t bytes, std::size_t alignment)
+		{
+			std::size_t space = static_cast<std::size_t>(chunk_end - chunk_cursor);
+			void *position = chunk_cursor;
+			if (chunk_cursor == nullptr || std::align(alignment, bytes, position, space) == nullptr)
+			{
+				std::size_t chunk_alignment = std::max(alignment, alignof(chunk));
+				std::size_t header = (sizeof(chunk) + chunk_alignment - 1) / chunk_alignment * chunk_alignment;
+				if (bytes > std::numeric_limits<std::size_t>::max() - header)
+					throw std::bad_alloc();
+				std::size_t length = std::max(chunk_size, header + bytes);
+				chunk *new_chunk = static_cast<chunk *>(::operator new(length, std::align_val_t{ chunk_alignment }));
+				new_chunk->previous = chunks;
+				new_chunk->alignment = chunk_alignment;
+				chunks = new_chunk;
+				position = reinterpret_cast<char *>(new_chunk) + header;
+				chunk_end = reinterpret_cast<char *>(new_chunk) + length;
+			}
+			chunk_cursor = static_cast<char *>(position) + bytes;
+			return position;
+		}
+
+		/*!
+		 * @brief Releases every chunk, arrays allocated from this arena must have been destroyed.
+		 */
+		void reset() noexcept
+		{
+			while (chunks != nullptr)
+			{
+				chunk *previous = chunks->previous;
+				::operator delete(chunks, std::align_val_t{ chunks->alignment });
+				chunks = previous;
+			}
+			chunk_cursor = nullptr;
+			chunk_end = nullptr;
+		}
+
+		/*!
+		 * @brief Arena of the innermost scope on this thread, nullptr if there is none.
+		 */
+		static mini_arena* current() noexcept { return current_arena(); }
+
+	private:
+		struct chunk
+		{
+			chunk *previous;
+			std::size_t alignment;
+		};
+
+		std::size_t chunk_size;
+		chunk *chunks = nullptr;
+		char *chunk_cursor = nullptr;
+		char *chunk_end = nullptr;
+
+		static mini_arena*& current_arena() noexcept
+		{
+			thread_local mini_arena *arena = nullptr;
+			return arena;
+		}
+	};
+
+	/*!
+	 * @brief Makes an arena current on this thread until the end of the scope, scopes can be nested.
+	 */
+	class mini_arena::scope
+	{
+	public:
+		explicit scope(mini_arena &arena) noexcept : previous_arena(std::exchange(current_arena(), &arena)) {}
+
+		scope(const scope &) = delete;
+
+		scope& operator=(const scope &) = delete;
+
+		~scope() { current_arena() = previous_arena; }
+
+	private:
+		mini_arena *previous_arena;
+	};
+
+	/*!
+	 * @brief Stateless allocator drawing from mini_arena::current(), so dynarray<T, arena_allocator> is still 16 bytes.
+	 *
+	 * Allocating needs a mini_arena::scope on the calling thread, deallocating does nothing.
+	 */
+	template<typename T>
+	struct arena_allocator
+	{
+		using value_type = T;
+
+		arena_allocator() noexcept = default;
+
+		template<typename U>
+		arena_allocator(const arena_allocator<U> &) noexcept {}
+
+		T* allocate(std::size_t count)
+		{
+			if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+				throw std::bad_array_new_length();
+			mini_arena *arena = mini_arena::current();
+			if (arena == nullptr)
+				throw std::bad_alloc();
+			return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T *, std::size_t) noexcept {}
+
+		friend bool operator==(const arena_allocator &, const arena_allocator &) noexcept { return true; }
+
+		friend bool operator!=(const arena_allocator &, const arena_allocator &) noexcept { return false; }
+	};
+
 	template<typename T>
 	class vla_iterator
 	{
@@ -171,10 +404,10 @@ namespace vla
 	};
 
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	class dynarray
 	{
-		friend class dynarray<dynarray<T>>;
+		friend class dynarray<dynarray<T, _Allocator>, _Allocator>;
 		using internal_value_type = typename internal_impl::inner_type<T>::value_type;
 		using internal_pointer_type = internal_value_type *;
 	public:
@@ -188,6 +421,7 @@ namespace vla
 		using const_reference = const value_type &;
 		using pointer = value_type *;
 		using const_pointer = const value_type *;
+		using allocator_type = _Allocator<T>;
 
 		using iterator = vla_iterator<T>;
 		using const_iterator = vla_iterator<const T>;
@@ -238,6 +472,21 @@ namespace vla
 			allocate_array(count, std::forward<Args>(args)...);
 		}
 
+		/*!
+		 * @brief Construct by 'count' of each dimension without value-initialising the elements.\n
+		 * Elements of trivial types are left indeterminate and have to be written before being read.\n
+		 * Example: dynarray<dynarray<double>> my_array(vla::for_overwrite, 1000, 1000);
+		 *
+		 * @param count The first dimention
+		 * @param ...counts The other dimensions, one for each level of nested array
+		 */
+		template<typename ... Args>
+		CPP20_DYNARRAY_CONSTEXPR dynarray(for_overwrite_t, size_type count, Args ... counts)
+		{
+			initialise();
+			allocate_array(for_overwrite, count, counts...);
+		}
+
 
 		/*!
 		 * @brief Duplicate an existing dynarray.
@@ -322,7 +571,7 @@ namespace vla
 		 */
 		CPP20_DYNARRAY_CONSTEXPR dynarray& operator=(dynarray &&other) noexcept
 		{
-			if (current_dimension_array_size > 0 && current_dimension_array_size != other.current_dimension_array_size)
+			if (size() > 0 && size() != other.size())
 				move_values(other);
 			else
 			{
@@ -470,7 +719,7 @@ namespace vla
 		 * @return Pointer to the underlying element storage.
 		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR pointer get() noexcept { return current_dimension_array_data; }
+		CPP20_DYNARRAY_CONSTEXPR pointer get() noexcept { return current_dimension_array_data.get(); }
 
 		/*!
 		 * @brief Returns const pointer to the underlying array serving as element storage.
@@ -480,7 +729,7 @@ namespace vla
 		 * @return Const pointer to the underlying element storage.
 		 * For non-empty containers, the returned pointer compares equal to the address of the first element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR const pointer get() const noexcept { return current_dimension_array_data; }
+		CPP20_DYNARRAY_CONSTEXPR const pointer get() const noexcept { return current_dimension_array_data.get(); }
 
 		/*!
 		 * @brief Checks if the container has no elements.
@@ -492,7 +741,7 @@ namespace vla
 		 * @brief Returns the number of elements in the container.
 		 * @return The number of elements in the container.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR size_type size() const noexcept { return current_dimension_array_size; }
+		CPP20_DYNARRAY_CONSTEXPR size_type size() const noexcept { return current_dimension_array_data.get_deleter().count; }
 
 		/*!
 		 * @brief Returns the maximum number of elements the container is able to hold due to system or library implementation limitations.
@@ -558,7 +807,7 @@ namespace vla
 		 *
 		 * @return Iterator to the element following the last element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR iterator end() noexcept { return iterator(current_dimension_array_data.get() + current_dimension_array_size); }
+		CPP20_DYNARRAY_CONSTEXPR iterator end() noexcept { return iterator(current_dimension_array_data.get() + size()); }
 
 		/*!
 		 * @brief Returns an iterator to the element following the last element of the vector.
@@ -567,7 +816,7 @@ namespace vla
 		 *
 		 * @return Iterator to the element following the last element.
 		*/
-		CPP20_DYNARRAY_CONSTEXPR const_iterator end() const noexcept { return const_iterator(current_dimension_array_data.get() + current_dimension_array_size); }
+		CPP20_DYNARRAY_CONSTEXPR const_iterator end() const noexcept { return const_iterator(current_dimension_array_data.get() + size()); }
 
 		/*!
 		 * @brief Returns an iterator to the element following the last element of the vector.
@@ -637,8 +886,7 @@ namespace vla
 
 	private:
 
-		size_type current_dimension_array_size;
-		std::unique_ptr<T[]> current_dimension_array_data;
+		std::unique_ptr<T[], internal_impl::allocator_deleter<allocator_type>> current_dimension_array_data;
 
 
 		CPP20_DYNARRAY_CONSTEXPR void initialise();
@@ -651,8 +899,13 @@ namespace vla
 
 		CPP20_DYNARRAY_CONSTEXPR void verify_size(size_type count);
 
+		CPP20_DYNARRAY_CONSTEXPR void allocate_storage(size_type count, bool for_overwrite = false);
+
 		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count);
 
+		template<typename ...Args>
+		CPP20_DYNARRAY_CONSTEXPR void allocate_array(for_overwrite_t, size_type count, Args&& ... args);
+
 		template<typename ...Args>
 		CPP20_DYNARRAY_CONSTEXPR void allocate_array(size_type count, Args&& ... args);
 
@@ -677,6 +930,10 @@ namespace vla
 
 		CPP20_DYNARRAY_CONSTEXPR void move_values(dynarray &other) noexcept;
 
+		std::size_t hash_code() const;
+
+		friend struct std::hash<dynarray>;
+
 		/**** Non-member functions  ***/
 
 		friend CPP20_DYNARRAY_CONSTEXPR bool operator==(const dynarray &lhs, const dynarray &rhs)
@@ -717,10 +974,10 @@ namespace vla
 #endif
 	};
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	template<typename Ty>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::size_type
-	dynarray<T>::expand_list(std::initializer_list<Ty> init)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::size_type
+	dynarray<T, _Allocator>::expand_list(std::initializer_list<Ty> init)
 	{
 		if constexpr (std::is_same_v<T, internal_value_type>)
 		{
@@ -735,10 +992,10 @@ namespace vla
 		}
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	template<typename ...Args>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::size_type
-	dynarray<T>::expand_counts(size_type count, Args && ...args)
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::size_type
+	dynarray<T, _Allocator>::expand_counts(size_type count, Args && ...args)
 	{
 		if constexpr (std::is_same_v<T, internal_value_type> || sizeof...(args) == 0)
 			return count;
@@ -746,25 +1003,55 @@ namespace vla
 			return T::expand_counts(std::forward<Args>(args)...) * count;
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::initialise()
+	dynarray<T, _Allocator>::initialise()
 	{
-		current_dimension_array_size = 0;
-		current_dimension_array_data = nullptr;
+		current_dimension_array_data.reset();
+		current_dimension_array_data.get_deleter().count = 0;
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::verify_size(size_type count)
+	dynarray<T, _Allocator>::verify_size(size_type count)
 	{
 		if (count > static_cast<size_type>(std::numeric_limits<difference_type>::max()))
 			throw std::length_error("array too long");
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::allocate_array(size_type count)
+	dynarray<T, _Allocator>::allocate_storage(size_type count, bool for_overwrite)
+	{
+		allocator_type &array_allocator = current_dimension_array_data.get_deleter();
+		T *new_data = std::allocator_traits<allocator_type>::allocate(array_allocator, count);
+		size_type constructed = 0;
+		try
+		{
+			for (; constructed < count; ++constructed)
+			{
+				if (for_overwrite)
+					::new (static_cast<void *>(new_data + constructed)) T;
+				else
+					std::allocator_traits<allocator_type>::construct(array_allocator, new_data + constructed);
+			}
+		}
+		catch (...)
+		{
+			for (; constructed > 0; --constructed)
+				std::allocator_traits<allocator_type>::destroy(array_allocator, new_data + constructed - 1);
+			std::allocator_traits<allocator_type>::deallocate(array_allocator, new_data, count);
+			throw;
+		}
+
+		// reset() hands the old array to the deleter before the count is replaced
+		current_dimension_array_data.reset(new_data);
+		current_dimension_array_data.get_deleter().count = count;
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+	dynarray<T, _Allocator>::allocate_array(size_type count)
 	{
 		if (count == 0)
 		{
@@ -773,14 +1060,13 @@ namespace vla
 		}
 
 		verify_size(count);
-		current_dimension_array_size = count;
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
+		allocate_storage(count);
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	template<typename ... Args>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::allocate_array(size_type count, Args&& ...args)
+	dynarray<T, _Allocator>::allocate_array(size_type count, Args&& ...args)
 	{
 		verify_size(count);
 		size_type each_block_size = 1;
@@ -799,9 +1085,8 @@ namespace vla
 			return;
 		}
 
-		current_dimension_array_size = count;
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		allocate_storage(count);
+		for (size_type i = 0; i < size(); ++i)
 		{
 			if constexpr (!std::is_same_v<T, internal_value_type>)
 				current_dimension_array_data[i].allocate_array(std::forward<Args>(args)...);
@@ -811,44 +1096,66 @@ namespace vla
 	}
 
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
+	template<typename ... Args>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::allocate_array(std::initializer_list<T> input_list)
+	dynarray<T, _Allocator>::allocate_array(for_overwrite_t, size_type count, Args&& ...args)
+	{
+		static_assert(sizeof...(args) == internal_impl::inner_type<T>::nested_level, "one count is needed for each dimension");
+		verify_size(count);
+		if constexpr (!std::is_same_v<T, internal_value_type>)
+			verify_size(T::expand_counts(args...) * count);
+
+		if (count == 0)
+		{
+			initialise();
+			return;
+		}
+
+		if constexpr (std::is_same_v<T, internal_value_type>)
+			allocate_storage(count, true);
+		else
+		{
+			allocate_storage(count);
+			for (size_type i = 0; i < count; ++i)
+				current_dimension_array_data[i].allocate_array(for_overwrite, args...);
+		}
+	}
+
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR void
+	dynarray<T, _Allocator>::allocate_array(std::initializer_list<T> input_list)
 	{
 		size_type count = input_list.size();
 		if (count == 0) return;
 		verify_size(count);
-		current_dimension_array_size = count;
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
+		allocate_storage(count);
 		auto list_iter = input_list.begin();
 		for (size_type i = 0; i < count; ++i, ++list_iter)
 			current_dimension_array_data[i] = *list_iter;
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	template<typename Ty>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list)
+	dynarray<T, _Allocator>::allocate_array(std::initializer_list<std::initializer_list<Ty>> input_list)
 	{
 		size_type count = input_list.size();
 		if (count == 0) return;
 		verify_size(count);
-		current_dimension_array_size = count;
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
+		allocate_storage(count);
 		auto list_iter = input_list.begin();
 		for (size_type i = 0; i < count; ++i, ++list_iter)
 			current_dimension_array_data[i].allocate_array(*list_iter);
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::copy_array(const dynarray &other)
+	dynarray<T, _Allocator>::copy_array(const dynarray &other)
 	{
-		if (other.current_dimension_array_size == 0) return;
-		current_dimension_array_size = other.current_dimension_array_size;
-
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		if (other.size() == 0) return;
+		allocate_storage(other.size());
+		for (size_type i = 0; i < size(); ++i)
 		{
 			if constexpr (std::is_same_v<T, internal_value_type>)
 				current_dimension_array_data[i] = other.current_dimension_array_data[i];
@@ -857,10 +1164,10 @@ namespace vla
 		}
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	template<typename InputIterator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::copy_array(InputIterator other_begin, InputIterator other_end)
+	dynarray<T, _Allocator>::copy_array(InputIterator other_begin, InputIterator other_end)
 	{
 		static_assert(std::is_same_v<std::decay_t<decltype(*other_begin)>, T> ||
 			          std::is_convertible_v<std::decay_t<decltype(*other_begin)>, T>,
@@ -869,10 +1176,9 @@ namespace vla
 		size_type count = static_cast<size_type>(std::abs(other_end - other_begin));
 		if (count == 0) return;
 
-		current_dimension_array_size = count;
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
+		allocate_storage(count);
 		InputIterator other = other_begin;
-		for (size_type i = 0; i < current_dimension_array_size; ++i, ++other)
+		for (size_type i = 0; i < size(); ++i, ++other)
 		{
 			if constexpr (std::is_same_v<T, internal_value_type>)
 				current_dimension_array_data[i] = *other;
@@ -881,140 +1187,134 @@ namespace vla
 		}
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::loop_copy(const dynarray &other) noexcept
+	dynarray<T, _Allocator>::loop_copy(const dynarray &other) noexcept
 	{
 		if (size() == 0 || other.size() == 0) return;
 
-		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
+		for (size_type i = 0; i < size() && i < other.size(); ++i)
 			current_dimension_array_data[i] = other.current_dimension_array_data[i];
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::loop_copy(std::initializer_list<T> input_list) noexcept
+	dynarray<T, _Allocator>::loop_copy(std::initializer_list<T> input_list) noexcept
 	{
 		size_type count = input_list.size();
 		if (size() == 0 || count == 0) return;
 
 		auto list_iter = input_list.begin();
-		for (size_type i = 0; i < count && i < current_dimension_array_size; ++i, ++list_iter)
+		for (size_type i = 0; i < count && i < size(); ++i, ++list_iter)
 			current_dimension_array_data[i] = *list_iter;
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	template<typename Ty>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::loop_copy(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept
+	dynarray<T, _Allocator>::loop_copy(std::initializer_list<std::initializer_list<Ty>> input_list) noexcept
 	{
 		size_type count = input_list.size();
 		if (size() == 0 || count == 0) return;
 
 		auto list_iter = input_list.begin();
-		for (size_type i = 0; i < count && i < current_dimension_array_size; ++i, ++list_iter)
+		for (size_type i = 0; i < count && i < size(); ++i, ++list_iter)
 			current_dimension_array_data[i].loop_copy(*list_iter);
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::move_array(dynarray &other) noexcept
+	dynarray<T, _Allocator>::move_array(dynarray &other) noexcept
 	{
-		if (other.current_dimension_array_size == 0) return;
-		current_dimension_array_size = other.current_dimension_array_size;
-
-		current_dimension_array_data = std::make_unique<T[]>(current_dimension_array_size);
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		if (other.size() == 0) return;
+		allocate_storage(other.size());
+		for (size_type i = 0; i < size(); ++i)
 		{
 			if constexpr (std::is_same_v<T, internal_value_type>)
 				current_dimension_array_data[i] = std::move(other.current_dimension_array_data[i]);
 			else
 				current_dimension_array_data[i].move_array(other.current_dimension_array_data[i]);
 		}
-
-		//current_dimension_array_size = other.current_dimension_array_size;
-		//current_dimension_array_data = other.current_dimension_array_data;
-		//other.initialise();
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::move_values(dynarray &other) noexcept
+	dynarray<T, _Allocator>::move_values(dynarray &other) noexcept
 	{
 		if (size() == 0 || other.size() == 0) return;
 
-		for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
+		for (size_type i = 0; i < size() && i < other.size(); ++i)
 			current_dimension_array_data[i] = std::move(other.current_dimension_array_data[i]);
 	}
 
-	template<typename T>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::reference
-	dynarray<T>::at(size_type pos)
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
+	dynarray<T, _Allocator>::at(size_type pos)
 	{
 		if (pos >= size())
 			throw std::out_of_range("out of range, incorrect position");
 		return current_dimension_array_data[pos];
 	}
 
-	template<typename T>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::const_reference
-	dynarray<T>::at(size_type pos) const
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
+	dynarray<T, _Allocator>::at(size_type pos) const
 	{
 		if (pos >= size())
 			throw std::out_of_range("out of range, incorrect position");
 		return current_dimension_array_data[pos];
 	}
 
-	template<typename T>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::reference
-	dynarray<T>::operator[](size_type pos)
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
+	dynarray<T, _Allocator>::operator[](size_type pos)
 	{
 		return current_dimension_array_data[pos];
 	}
 
-	template<typename T>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::const_reference
-	dynarray<T>::operator[](size_type pos) const
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
+	dynarray<T, _Allocator>::operator[](size_type pos) const
 	{
 		return current_dimension_array_data[pos];
 	}
 
-	template<typename T>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::reference
-	dynarray<T>::back()
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::reference
+	dynarray<T, _Allocator>::back()
 	{
-		return current_dimension_array_data[current_dimension_array_size - 1];
+		return current_dimension_array_data[size() - 1];
 	}
 
-	template<typename T>
-	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T>::const_reference
-	dynarray<T>::back() const
+	template<typename T, template<typename U> typename _Allocator>
+	inline CPP20_DYNARRAY_CONSTEXPR typename dynarray<T, _Allocator>::const_reference
+	dynarray<T, _Allocator>::back() const
 	{
-		return current_dimension_array_data[current_dimension_array_size - 1];
+		return current_dimension_array_data[size() - 1];
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::swap(dynarray &other) noexcept
+	dynarray<T, _Allocator>::swap(dynarray &other) noexcept
 	{
 		if constexpr (std::is_same_v<T, internal_value_type>)
 		{
-			difference_type length = std::min<difference_type>(current_dimension_array_size, other.current_dimension_array_size);
+			difference_type length = std::min<difference_type>(size(), other.size());
 			for (difference_type i = 0; i < length; ++i)
-				std::swap(*(current_dimension_array_data + i), *(other.current_dimension_array_data + i));
+				std::swap(current_dimension_array_data[i], other.current_dimension_array_data[i]);
 		}
 		else
 		{
-			for (size_type i = 0; i < current_dimension_array_size && i < other.current_dimension_array_size; ++i)
-				(current_dimension_array_data + i)->swap(other[i]);
+			for (size_type i = 0; i < size() && i < other.size(); ++i)
+				current_dimension_array_data[i].swap(other[i]);
 		}
 	}
 
-	template<typename T>
+	template<typename T, template<typename U> typename _Allocator>
 	inline CPP20_DYNARRAY_CONSTEXPR void
-	dynarray<T>::fill(const internal_value_type & value)
+	dynarray<T, _Allocator>::fill(const internal_value_type & value)
 	{
-		for (size_type i = 0; i < current_dimension_array_size; ++i)
+		for (size_type i = 0; i < size(); ++i)
 		{
 			if constexpr (std::is_same_v<T, internal_value_type>)
 				current_dimension_array_data[i] = value;
@@ -1023,7 +1323,41 @@ namespace vla
 		}
 	}
 
+	template<typename T, template<typename U> typename _Allocator>
+	inline std::size_t
+	dynarray<T, _Allocator>::hash_code() const
+	{
+		std::size_t seed = internal_impl::hash_combine(0, size());
+		if constexpr (std::is_same_v<T, internal_value_type>)
+		{
+			if constexpr (std::has_unique_object_representations_v<T>)
+				return internal_impl::hash_combine(seed, static_cast<std::size_t>(internal_impl::hash_bytes(current_dimension_array_data.get(), size() * sizeof(T), seed)));
+			else
+			{
+				std::hash<T> element_hash;
+				for (size_type i = 0; i < size(); ++i)
+					seed = internal_impl::hash_combine(seed, element_hash(current_dimension_array_data[i]));
+				return seed;
+			}
+		}
+		else
+		{
+			for (size_type i = 0; i < size(); ++i)
+				seed = internal_impl::hash_combine(seed, current_dimension_array_data[i].hash_code());
+			return seed;
+		}
+	}
+
 }	// namespace vla
 
+namespace std
+{
+	template<typename T, template<typename U> typename _Allocator>
+	struct hash<vla::dynarray<T, _Allocator>>
+	{
+		std::size_t operator()(const vla::dynarray<T, _Allocator> &arr) const { return arr.hash_code(); }
+	};
+}	// namespace std
+
 
 #endif //_VLA_HEADER_DYNARRAY_MINI_HPP_
\ No newline at end of file
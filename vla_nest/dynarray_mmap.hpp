@@ -0,0 +1,236 @@
+/** @copyright
+BSD 3-Clause License
+
+Copyright (c) 2020, cnbatch
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*!***************************************************************//*!
+ * @file   dynarray_mmap.hpp
+ * @brief  Memory-mapped files as storage of dynarray, POSIX only
+ *
+ * @author cnbatch
+ * @date   October 2026
+ *********************************************************************/
+
+#pragma once
+#ifndef DYNARRAY_NEST_MMAP_HPP
+#define DYNARRAY_NEST_MMAP_HPP
+
+#include "dynarray.hpp"
+
+#include <cerrno>
+#include <memory>
+#include <system_error>
+
+#if !__has_include(<sys/mman.h>)
+#error "dynarray_mmap.hpp requires POSIX mmap"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vla
+{
+	/*!
+	 * @brief How mapped_allocator maps a file.
+	 */
+	enum class map_mode
+	{
+		read_only,	// pages are shared with other processes, writing to an element crashes
+		copy_on_write,	// pages are copied when written, the file is never modified
+		read_write	// pages are shared, changes are written back to the file
+	};
+
+	namespace internal_impl
+	{
+		/*!
+		 * @brief Mapping of a whole file, unmapped when destroyed.
+		 */
+		class file_mapping
+		{
+		public:
+			file_mapping(const char *path, map_mode mode);
+
+			file_mapping(const file_mapping &other) = delete;
+
+			file_mapping& operator=(const file_mapping &other) = delete;
+
+			~file_mapping()
+			{
+				if (address != MAP_FAILED)
+					::munmap(address, length);
+			}
+
+			void* data() const noexcept { return address == MAP_FAILED ? nullptr : address; }
+
+			std::size_t size() const noexcept { return length; }
+
+			bool contains(const void *ptr) const noexcept
+			{
+				std::uintptr_t position = reinterpret_cast<std::uintptr_t>(ptr);
+				std::uintptr_t first = reinterpret_cast<std::uintptr_t>(address);
+				return address != MAP_FAILED && position >= first && position - first < length;
+			}
+
+		private:
+			void *address = MAP_FAILED;
+			std::size_t length = 0;
+		};
+
+		inline file_mapping::file_mapping(const char *path, map_mode mode)
+		{
+			int descriptor = ::open(path, mode == map_mode::read_write ? O_RDWR : O_RDONLY);
+			if (descriptor == -1)
+				throw std::system_error(errno, std::generic_category(), "cannot open file");
+
+			struct stat file_status = {};
+			if (::fstat(descriptor, &file_status) == -1)
+			{
+				int error_code = errno;
+				::close(descriptor);
+				throw std::system_error(error_code, std::generic_category(), "cannot open file");
+			}
+
+			length = static_cast<std::size_t>(file_status.st_size);
+			if (length > 0)
+			{
+				int protection = mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+				int flags = mode == map_mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+				address = ::mmap(nullptr, length, protection, flags, descriptor, 0);
+			}
+
+			int error_code = errno;
+			::close(descriptor);
+			if (length > 0 && address == MAP_FAILED)
+				throw std::system_error(error_code, std::generic_category(), "cannot map file");
+		}
+	}	// internal namespace
+
+	/*!
+	 * @brief Allocator which may own a memory-mapped file, use it as the allocator template of dynarray.
+	 *
+	 * Allocations are forwarded to std::allocator. Deallocating the mapped block drops the reference to the mapping,
+	 * the file is unmapped when no copy of the allocator refers to it.
+	 */
+	template<typename T>
+	class mapped_allocator
+	{
+		template<typename U>
+		friend class mapped_allocator;
+	public:
+		using value_type = T;
+
+		/*!
+		 * @brief An allocator without mapping.
+		 */
+		mapped_allocator() noexcept = default;
+
+		/*!
+		 * @brief Maps the whole file.
+		 *
+		 * @param path Path of the file
+		 * @param mode map_mode::read_only, map_mode::copy_on_write or map_mode::read_write
+		 * @exception std::system_error if the file cannot be opened or mapped
+		 */
+		mapped_allocator(const char *path, map_mode mode) : mapping(std::make_shared<internal_impl::file_mapping>(path, mode)) {}
+
+		template<typename U>
+		mapped_allocator(const mapped_allocator<U> &other) noexcept : mapping(other.mapping) {}
+
+		T* allocate(std::size_t count) { return std::allocator<T>().allocate(count); }
+
+		void deallocate(T *ptr, std::size_t count) noexcept
+		{
+			if (mapping != nullptr && mapping->contains(ptr))
+				mapping.reset();
+			else
+				std::allocator<T>().deallocate(ptr, count);
+		}
+
+		/*!
+		 * @brief Beginning of the mapped file, nullptr if there is no mapping.
+		 */
+		void* mapped_data() const noexcept { return mapping == nullptr ? nullptr : mapping->data(); }
+
+		/*!
+		 * @brief Size of the mapped file in bytes.
+		 */
+		std::size_t mapped_size() const noexcept { return mapping == nullptr ? 0 : mapping->size(); }
+
+		friend bool operator==(const mapped_allocator &lhs, const mapped_allocator &rhs) noexcept { return lhs.mapping == rhs.mapping; }
+
+		friend bool operator!=(const mapped_allocator &lhs, const mapped_allocator &rhs) noexcept { return lhs.mapping != rhs.mapping; }
+
+	private:
+		std::shared_ptr<internal_impl::file_mapping> mapping;
+	};
+
+	/*!
+	 * @brief Maps a file written by save_binary, output takes over the mapping.
+	 *
+	 * Only the management nodes are rebuilt from the header, no element is read until it is accessed.
+	 * The file is unmapped when output is destroyed, or when its contents are released.
+	 *
+	 * @param path File written by save_binary
+	 * @param mode map_mode::read_only, map_mode::copy_on_write or map_mode::read_write
+	 * @param output The array to hold the mapped file, its previous contents are released
+	 * @exception std::system_error if the file cannot be opened or mapped
+	 * @exception std::invalid_argument if the file is broken, or does not match the rank or the element type of output
+	 */
+	template<typename T>
+	inline void map_binary(const char *path, map_mode mode, dynarray<T, mapped_allocator> &output)
+	{
+		typename dynarray<T, mapped_allocator>::contiguous_allocator_type owner(path, mode);
+		adopt_binary(owner.mapped_data(), owner.mapped_size(), owner, output);
+	}
+
+	/*!
+	 * @brief Maps a NumPy .npy file in C order, output takes over the mapping, like numpy.load with mmap_mode.
+	 *
+	 * Works the same way as map_binary, save_npy writes the elements at a 64-byte aligned offset.
+	 *
+	 * @param path File written by save_npy or numpy.save
+	 * @param mode map_mode::read_only, map_mode::copy_on_write or map_mode::read_write
+	 * @param output The array to hold the mapped file, its previous contents are released
+	 * @exception std::system_error if the file cannot be opened or mapped
+	 * @exception std::invalid_argument if the file is broken, in Fortran order, or does not match the rank or the element type of output
+	 */
+	template<typename T>
+	inline void map_npy(const char *path, map_mode mode, dynarray<T, mapped_allocator> &output)
+	{
+		typename dynarray<T, mapped_allocator>::contiguous_allocator_type owner(path, mode);
+		adopt_npy(owner.mapped_data(), owner.mapped_size(), owner, output);
+	}
+
+}	// namespace vla
+
+
+#endif //DYNARRAY_NEST_MMAP_HPP